@@ -88,6 +88,14 @@ static mp_obj_t fat_vfs_make_new(const mp_obj_type_t *type, size_t n_args, size_
     vfs->blockdev.block_size = FF_MIN_SS; // default, will be populated by call to MP_BLOCKDEV_IOCTL_BLOCK_SIZE
     mp_vfs_blockdev_init(&vfs->blockdev, args[0]);
 
+    // CIRCUITPY-CHANGE: Cache blocks if there is room for it.
+    #if MICROPY_FATFS_BLOCK_CACHE
+    vfs->block_cache = m_new_obj_maybe(fat_block_cache_t);
+    if (vfs->block_cache != NULL) {
+        fat_block_cache_init(vfs->block_cache);
+    }
+    #endif
+
     // mount the block device so the VFS methods can be used
     FRESULT res = f_mount(&vfs->fatfs);
     if (res == FR_NO_FILESYSTEM) {
@@ -30,6 +30,40 @@
 #include "lib/oofatfs/ff.h"
 #include "extmod/vfs.h"
 
+// CIRCUITPY-CHANGE: Optional write-through cache of recently read blocks, so
+// that FAT chain walks and directory scans don't read the same blocks from an
+// SD card again and again. Sequential single block reads are turned into
+// multi-block reads of MICROPY_FATFS_BLOCK_CACHE_READAHEAD blocks.
+#ifndef MICROPY_FATFS_BLOCK_CACHE
+#define MICROPY_FATFS_BLOCK_CACHE (0)
+#endif
+
+#if MICROPY_FATFS_BLOCK_CACHE
+#ifndef MICROPY_FATFS_BLOCK_CACHE_BLOCKS
+#define MICROPY_FATFS_BLOCK_CACHE_BLOCKS (8)
+#endif
+#ifndef MICROPY_FATFS_BLOCK_CACHE_READAHEAD
+#define MICROPY_FATFS_BLOCK_CACHE_READAHEAD (4)
+#endif
+#if MICROPY_FATFS_BLOCK_CACHE_BLOCKS % MICROPY_FATFS_BLOCK_CACHE_READAHEAD != 0
+#error "MICROPY_FATFS_BLOCK_CACHE_BLOCKS must be a multiple of MICROPY_FATFS_BLOCK_CACHE_READAHEAD"
+#endif
+
+typedef struct _fat_block_cache_t {
+    // Blocks are stored block_size apart so that a run of entries can be read
+    // in one go.
+    uint8_t data[MICROPY_FATFS_BLOCK_CACHE_BLOCKS * FF_MAX_SS];
+    DWORD block[MICROPY_FATFS_BLOCK_CACHE_BLOCKS];
+    uint32_t last_use[MICROPY_FATFS_BLOCK_CACHE_BLOCKS];
+    uint32_t use_count;
+    // The block after the last single block read, to detect sequential reads.
+    DWORD next_sequential;
+} fat_block_cache_t;
+
+// Empty the cache. Must be called before a cache is first used.
+void fat_block_cache_init(fat_block_cache_t *cache);
+#endif
+
 typedef struct _fs_user_mount_t {
     mp_obj_base_t base;
     mp_vfs_blockdev_t blockdev;
@@ -38,6 +72,11 @@ typedef struct _fs_user_mount_t {
     // CIRCUITPY-CHANGE: Count the users that are manipulating the blockdev via
     // native fatfs so we can lock and unlock the blockdev.
     int8_t lock_count;
+
+    #if MICROPY_FATFS_BLOCK_CACHE
+    // CIRCUITPY-CHANGE: NULL when the mount isn't cached.
+    fat_block_cache_t *block_cache;
+    #endif
 } fs_user_mount_t;
 
 extern const byte fresult_to_errno_table[20];
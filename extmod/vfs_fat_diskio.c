@@ -32,6 +32,7 @@
 
 #include <stdint.h>
 #include <stdio.h>
+#include <string.h>
 
 #include "py/mphal.h"
 
@@ -48,6 +49,122 @@ static fs_user_mount_t *disk_get_device(void *bdev) {
     return (fs_user_mount_t *)bdev;
 }
 
+// CIRCUITPY-CHANGE: Block cache, see vfs_fat.h.
+#if MICROPY_FATFS_BLOCK_CACHE
+
+#define NO_BLOCK ((DWORD)-1)
+
+void fat_block_cache_init(fat_block_cache_t *cache) {
+    for (size_t i = 0; i < MICROPY_FATFS_BLOCK_CACHE_BLOCKS; i++) {
+        cache->block[i] = NO_BLOCK;
+        cache->last_use[i] = 0;
+    }
+    cache->use_count = 0;
+    cache->next_sequential = NO_BLOCK;
+}
+
+static int block_cache_find(fat_block_cache_t *cache, DWORD block) {
+    for (size_t i = 0; i < MICROPY_FATFS_BLOCK_CACHE_BLOCKS; i++) {
+        if (cache->block[i] == block) {
+            return i;
+        }
+    }
+    return -1;
+}
+
+// Find the least recently used run of count entries, starting at a multiple of
+// count. Empty entries are never used so they are picked first.
+static size_t block_cache_victim(fat_block_cache_t *cache, size_t count) {
+    size_t victim = 0;
+    uint32_t oldest = UINT32_MAX;
+    for (size_t i = 0; i < MICROPY_FATFS_BLOCK_CACHE_BLOCKS; i += count) {
+        uint32_t newest_in_run = 0;
+        for (size_t j = i; j < i + count; j++) {
+            newest_in_run = MAX(newest_in_run, cache->last_use[j]);
+        }
+        if (newest_in_run < oldest) {
+            oldest = newest_in_run;
+            victim = i;
+        }
+    }
+    return victim;
+}
+
+// Read count blocks into the cache starting at entry i.
+static bool block_cache_fill(fs_user_mount_t *vfs, size_t i, DWORD block, size_t count) {
+    fat_block_cache_t *cache = vfs->block_cache;
+    // Mark the entries empty first in case the read fails.
+    for (size_t j = i; j < i + count; j++) {
+        cache->block[j] = NO_BLOCK;
+        cache->last_use[j] = 0;
+    }
+    if (mp_vfs_blockdev_read(&vfs->blockdev, block, count, cache->data + i * vfs->blockdev.block_size) != 0) {
+        return false;
+    }
+    // Blocks that are already cached elsewhere are the same, but drop the old
+    // copies so that each block is only cached once.
+    for (size_t j = 0; j < count; j++) {
+        int old = block_cache_find(cache, block + j);
+        if (old >= 0) {
+            cache->block[old] = NO_BLOCK;
+            cache->last_use[old] = 0;
+        }
+        cache->block[i + j] = block + j;
+    }
+    return true;
+}
+
+static DRESULT block_cache_read(fs_user_mount_t *vfs, BYTE *buff, DWORD sector) {
+    fat_block_cache_t *cache = vfs->block_cache;
+    size_t block_size = vfs->blockdev.block_size;
+    bool sequential = sector == cache->next_sequential;
+    cache->next_sequential = sector + 1;
+
+    // Only read ahead within a mounted volume, so as not to run off the end of
+    // the device.
+    FATFS *fs = &vfs->fatfs;
+    DWORD volume_end = fs->fs_type == 0 ? 0 : fs->database + (fs->n_fatent - 2) * fs->csize;
+
+    int i = block_cache_find(cache, sector);
+    if (i < 0) {
+        size_t readahead = MICROPY_FATFS_BLOCK_CACHE_READAHEAD;
+        bool filled = false;
+        if (sequential && sector + readahead <= volume_end) {
+            i = block_cache_victim(cache, readahead);
+            filled = block_cache_fill(vfs, i, sector, readahead);
+        }
+        if (!filled) {
+            i = block_cache_victim(cache, 1);
+            if (!block_cache_fill(vfs, i, sector, 1)) {
+                return RES_ERROR;
+            }
+        }
+    }
+    cache->last_use[i] = ++cache->use_count;
+    memcpy(buff, cache->data + i * block_size, block_size);
+    return RES_OK;
+}
+
+// Keep cached copies up to date with data being written. After a failed write
+// the device contents are unknown, so the copies are dropped instead.
+static void block_cache_write(fs_user_mount_t *vfs, const BYTE *buff, DWORD sector, UINT count, bool written) {
+    fat_block_cache_t *cache = vfs->block_cache;
+    size_t block_size = vfs->blockdev.block_size;
+    for (size_t i = 0; i < MICROPY_FATFS_BLOCK_CACHE_BLOCKS; i++) {
+        if (cache->block[i] == NO_BLOCK || cache->block[i] - sector >= count) {
+            continue;
+        }
+        if (written) {
+            memcpy(cache->data + i * block_size, buff + (cache->block[i] - sector) * block_size, block_size);
+        } else {
+            cache->block[i] = NO_BLOCK;
+            cache->last_use[i] = 0;
+        }
+    }
+}
+
+#endif
+
 /*-----------------------------------------------------------------------*/
 /* Read Sector(s)                                                        */
 /*-----------------------------------------------------------------------*/
@@ -63,6 +180,15 @@ DRESULT disk_read(
         return RES_PARERR;
     }
 
+    // CIRCUITPY-CHANGE: Single blocks go through the cache. Larger reads are
+    // file data that FatFs reads straight into the caller's buffer, and the
+    // cache is write-through so the device is always up to date.
+    #if MICROPY_FATFS_BLOCK_CACHE
+    if (vfs->block_cache != NULL && count == 1) {
+        return block_cache_read(vfs, buff, sector);
+    }
+    #endif
+
     int ret = mp_vfs_blockdev_read(&vfs->blockdev, sector, count, buff);
 
     return ret == 0 ? RES_OK : RES_ERROR;
@@ -85,6 +211,13 @@ DRESULT disk_write(
 
     int ret = mp_vfs_blockdev_write(&vfs->blockdev, sector, count, buff);
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_FATFS_BLOCK_CACHE
+    if (vfs->block_cache != NULL) {
+        block_cache_write(vfs, buff, sector, count, ret == 0);
+    }
+    #endif
+
     if (ret == -MP_EROFS) {
         // read-only block device
         return RES_WRPRT;
@@ -15,6 +15,7 @@
 #include "py/compile.h"
 #include "py/frozenmod.h"
 #include "py/mphal.h"
+#include "py/profile.h"
 #include "py/runtime.h"
 #include "py/repl.h"
 #include "py/gc.h"
@@ -227,6 +228,11 @@ static void stop_mp(void) {
     usb_background();
     #endif
 
+    #if MICROPY_PROF_SAMPLING
+    // Samples refer to qstrs that are about to be freed, and sampling holds the tick.
+    mp_prof_sample_deinit();
+    #endif
+
     // Set the qstr pool back to the const pools. The heap allocated ones will
     // be overwritten.
     qstr_reset();
@@ -72,6 +72,7 @@ void common_hal_mcu_on_next_reset(mcu_runmode_t runmode) {
 }
 
 void common_hal_mcu_reset(void) {
+    filesystem_flush();
     if (next_reset_to_bootloader) {
         reset_to_bootloader();
     } else {
@@ -119,7 +119,7 @@ void board_timerhook(void) {
         supervisor_tick();
     }
 
-    background_callback_add(&callback, usb_background_do, NULL);
+    background_callback_add_priority(&callback, usb_background_do, NULL, BACKGROUND_CALLBACK_PRIORITY_USB);
 }
 
 uint64_t port_get_raw_ticks(uint8_t *subticks) {
@@ -276,7 +276,7 @@ static void i2s_transfer_callback(I2S_Type *base, sai_handle_t *handle, status_t
     i2s_t *self = self_in;
     if (status == kStatus_SAI_TxIdle) {
         // a block has been finished
-        background_callback_add(&self->callback, i2s_callback_fun, self_in);
+        background_callback_add_priority(&self->callback, i2s_callback_fun, self_in, BACKGROUND_CALLBACK_PRIORITY_AUDIO);
     }
 }
 
@@ -413,7 +413,7 @@ void port_i2s_play(i2s_t *self, mp_obj_t sample, bool loop) {
         self->i2s_config.sample_rate = sample_rate;
     }
     #endif
-    background_callback_add(&self->callback, i2s_callback_fun, self);
+    background_callback_add_priority(&self->callback, i2s_callback_fun, self, BACKGROUND_CALLBACK_PRIORITY_AUDIO);
 }
 
 bool port_i2s_get_playing(i2s_t *self) {
@@ -16,6 +16,7 @@
 #include "shared-bindings/microcontroller/__init__.h"
 #include "shared-bindings/microcontroller/Pin.h"
 #include "shared-bindings/microcontroller/Processor.h"
+#include "supervisor/filesystem.h"
 #include "supervisor/shared/safe_mode.h"
 
 #include "pins.h"
@@ -62,6 +63,7 @@ void common_hal_mcu_on_next_reset(mcu_runmode_t runmode) {
 }
 
 void common_hal_mcu_reset(void) {
+    filesystem_flush();
     NVIC_SystemReset();
 }
 
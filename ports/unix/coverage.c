@@ -17,6 +17,18 @@
 #include "py/stream.h"
 #include "py/binary.h"
 #include "py/bc.h"
+// CIRCUITPY-CHANGE
+#include "py/profile.h"
+#if CIRCUITPY_DISPLAYIO_UNIX
+#include "shared-bindings/displayio/Bitmap.h"
+#include "shared-bindings/displayio/Group.h"
+#include "shared-bindings/displayio/Palette.h"
+#include "shared-bindings/displayio/TileGrid.h"
+#include "shared-bindings/vectorio/Circle.h"
+#include "shared-bindings/vectorio/Polygon.h"
+#include "shared-bindings/vectorio/Rectangle.h"
+#include "shared-bindings/vectorio/VectorShape.h"
+#endif
 
 // expected output of this file is found in extra_coverage.py.exp
 
@@ -50,6 +62,54 @@ static mp_obj_t stest_set_error(mp_obj_t o_in, mp_obj_t err_in) {
 }
 static MP_DEFINE_CONST_FUN_OBJ_2(stest_set_error_obj, stest_set_error);
 
+#if CIRCUITPY_DISPLAYIO_UNIX
+// sort key for the displayio render order test
+static mp_obj_t tilegrid_y(mp_obj_t tilegrid_in) {
+    return mp_obj_new_int(common_hal_displayio_tilegrid_get_y(MP_OBJ_TO_PTR(tilegrid_in)));
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(tilegrid_y_obj, tilegrid_y);
+#endif
+
+#if CIRCUITPY_VECTORIO
+// makes vectorio draw a shape by testing each pixel, as a reference for its spans
+static uint16_t vectorio_no_spans(mp_obj_t shape, int16_t line, bool along_y, int16_t *spans, uint16_t max_spans) {
+    (void)shape;
+    (void)line;
+    (void)along_y;
+    (void)spans;
+    (void)max_spans;
+    return VECTORIO_SPANS_UNKNOWN;
+}
+
+// Counts the pixels where a shape's spans disagree with get_pixel, over every
+// row or column of its area and a margin around it.
+static int vectorio_span_mismatches(vectorio_ishape_t *ishape, bool along_y, int *covered) {
+    displayio_area_t area;
+    ishape->get_area(ishape->shape, &area);
+    int16_t line_lo = (along_y ? area.x1 : area.y1) - 2, line_hi = (along_y ? area.x2 : area.y2) + 2;
+    int16_t lo = (along_y ? area.y1 : area.x1) - 2, hi = (along_y ? area.y2 : area.x2) + 2;
+    int mismatches = 0;
+    for (int16_t line = line_lo; line < line_hi; line++) {
+        int16_t spans[32];
+        uint16_t count = ishape->get_spans(ishape->shape, line, along_y, spans, 16);
+        if (count == VECTORIO_SPANS_UNKNOWN) {
+            mismatches++;
+            continue;
+        }
+        for (int16_t i = lo; i < hi; i++) {
+            bool in_span = false;
+            for (uint16_t k = 0; k < count; k++) {
+                in_span |= i >= spans[2 * k] && i < spans[2 * k + 1];
+            }
+            uint32_t pixel = along_y ? ishape->get_pixel(ishape->shape, line, i) : ishape->get_pixel(ishape->shape, i, line);
+            mismatches += in_span != (pixel != 0);
+            *covered += in_span;
+        }
+    }
+    return mismatches;
+}
+#endif
+
 static mp_uint_t stest_read(mp_obj_t o_in, void *buf, mp_uint_t size, int *errcode) {
     mp_obj_streamtest_t *o = MP_OBJ_TO_PTR(o_in);
     if (o->pos < o->len) {
@@ -729,6 +789,165 @@ static mp_obj_t extra_coverage(void) {
         mp_printf(&mp_plat_print, "%d %d\n", mp_obj_is_int(MP_OBJ_NEW_SMALL_INT(1)), mp_obj_is_int(mp_obj_new_int_from_ll(1)));
     }
 
+    // CIRCUITPY-CHANGE
+    // sampling profiler
+    #if MICROPY_PROF_SAMPLING
+    {
+        mp_printf(&mp_plat_print, "# sampling profiler\n");
+
+        // take samples by hand rather than from the timer, for stable output
+        mp_prof_sample_start();
+        MICROPY_PROF_SAMPLING_TIMER_STOP();
+        mp_printf(&mp_plat_print, "%d\n", mp_prof_sample_is_running());
+        mp_prof_sample();
+        mp_prof_sample();
+
+        // the stack is just the call to extra_coverage(); the source file name
+        // depends on how the test is run so only check the end of it
+        vstr_t vstr;
+        mp_print_t print;
+        vstr_init_print(&vstr, 16, &print);
+        size_t lost = mp_prof_sample_print(&print);
+        const char *stacks = vstr_null_terminated_str(&vstr);
+        mp_printf(&mp_plat_print, "%d %d\n", (int)lost, strncmp(stacks, "<module> (", 10) == 0 && strstr(stacks, "extra_coverage.py:10) 2\n") != NULL);
+
+        // overflow the ring buffer
+        for (int i = 0; i < MICROPY_PROF_SAMPLING_NUM_SAMPLES + 3; ++i) {
+            mp_prof_sample();
+        }
+        vstr_reset(&vstr);
+        lost = mp_prof_sample_print(&print);
+        mp_printf(&mp_plat_print, "%d %d\n", (int)lost, strstr(vstr_null_terminated_str(&vstr), ".py:10) 64\n") != NULL);
+        vstr_clear(&vstr);
+
+        mp_prof_sample_stop();
+        mp_prof_sample();
+        mp_printf(&mp_plat_print, "%d %d\n", mp_prof_sample_is_running(), (int)mp_prof_sample_print(&mp_plat_print));
+
+        // restarting keeps sampling running; deinit stops it and discards the samples
+        mp_prof_sample_start();
+        mp_prof_sample_start();
+        MICROPY_PROF_SAMPLING_TIMER_STOP();
+        mp_prof_sample();
+        mp_printf(&mp_plat_print, "%d\n", mp_prof_sample_is_running());
+        mp_prof_sample_deinit();
+        mp_prof_sample();
+        mp_printf(&mp_plat_print, "%d %d\n", mp_prof_sample_is_running(), (int)mp_prof_sample_print(&mp_plat_print));
+    }
+    #endif
+
+    // CIRCUITPY-CHANGE: displayio render order
+    #if CIRCUITPY_DISPLAYIO_UNIX
+    {
+        mp_printf(&mp_plat_print, "# displayio\n");
+
+        // a red TileGrid covering rows 0 and 1, then a blue one covering row 1
+        displayio_group_t *group = mp_obj_malloc(displayio_group_t, &displayio_group_type);
+        common_hal_displayio_group_construct(group, 1, 0, 0);
+        static const uint32_t colors[] = {0xff0000, 0x0000ff};
+        for (int i = 0; i < 2; i++) {
+            displayio_bitmap_t *bitmap = mp_obj_malloc(displayio_bitmap_t, &displayio_bitmap_type);
+            common_hal_displayio_bitmap_construct(bitmap, 1, 2 - i, 1);
+            common_hal_displayio_bitmap_fill(bitmap, 1);
+            displayio_palette_t *palette = mp_obj_malloc(displayio_palette_t, &displayio_palette_type);
+            common_hal_displayio_palette_construct(palette, 2, false);
+            common_hal_displayio_palette_set_color(palette, 1, colors[i]);
+            displayio_tilegrid_t *tilegrid = mp_obj_malloc(displayio_tilegrid_t, &displayio_tilegrid_type);
+            common_hal_displayio_tilegrid_construct(tilegrid, bitmap, 1, 1, palette, 1, 1, 1, 2 - i, 0, i, 0);
+            common_hal_displayio_group_insert(group, i, tilegrid);
+        }
+        displayio_group_update_transform(group, &null_transform);
+
+        // the member drawn last is on top where they overlap
+        _displayio_colorspace_t colorspace = {.depth = 16, .bytes_per_cell = 2, .pixels_in_byte_share_row = true};
+        displayio_area_t area = {.x1 = 0, .y1 = 1, .x2 = 1, .y2 = 2};
+        uint32_t mask = 0, buffer = 0;
+        displayio_group_fill_area(group, &colorspace, &area, &mask, &buffer);
+        mp_printf(&mp_plat_print, "%04x\n", (int)(buffer & 0xffff));
+
+        common_hal_displayio_group_sort(group, MP_OBJ_FROM_PTR(&tilegrid_y_obj), true);
+        mask = buffer = 0;
+        displayio_group_fill_area(group, &colorspace, &area, &mask, &buffer);
+        mp_printf(&mp_plat_print, "%04x\n", (int)(buffer & 0xffff));
+
+        common_hal_displayio_group_sort(group, MP_OBJ_FROM_PTR(&tilegrid_y_obj), false);
+        mask = buffer = 0;
+        displayio_group_fill_area(group, &colorspace, &area, &mask, &buffer);
+        mp_printf(&mp_plat_print, "%04x\n", (int)(buffer & 0xffff));
+    }
+    #endif
+
+    // CIRCUITPY-CHANGE: vectorio spans match get_pixel
+    #if CIRCUITPY_VECTORIO
+    {
+        mp_printf(&mp_plat_print, "# vectorio\n");
+
+        displayio_palette_t *palette = mp_obj_malloc(displayio_palette_t, &displayio_palette_type);
+        common_hal_displayio_palette_construct(palette, 2, false);
+        common_hal_displayio_palette_set_color(palette, 1, 0xffffff);
+
+        // self-intersecting polygons, with negative coordinates and horizontal and vertical edges
+        static const int16_t polygons[][12] = {
+            {0, 0, 20, 16, 20, 0, 0, 16},
+            {10, 0, 16, 20, 0, 7, 20, 7, 4, 20},
+            {-8, -5, 9, 3, -3, 11, 6, -9, 6, 4, -8, 4},
+        };
+        static const int polygon_points[] = {4, 5, 6};
+        mp_obj_t shapes[5];
+        for (int i = 0; i < 3; i++) {
+            mp_obj_t points = mp_obj_new_list(0, NULL);
+            for (int k = 0; k < polygon_points[i]; k++) {
+                mp_obj_t xy[] = {MP_OBJ_NEW_SMALL_INT(polygons[i][2 * k]), MP_OBJ_NEW_SMALL_INT(polygons[i][2 * k + 1])};
+                mp_obj_list_append(points, mp_obj_new_tuple(2, xy));
+            }
+            vectorio_polygon_t *polygon = mp_obj_malloc(vectorio_polygon_t, &vectorio_polygon_type);
+            common_hal_vectorio_polygon_construct(polygon, points, 1);
+            shapes[i] = vectorio_vector_shape_make_new(polygon, palette, 24, 20);
+        }
+        vectorio_circle_t *circle = mp_obj_malloc(vectorio_circle_t, &vectorio_circle_type);
+        common_hal_vectorio_circle_construct(circle, 9, 1);
+        shapes[3] = vectorio_vector_shape_make_new(circle, palette, 24, 20);
+        vectorio_rectangle_t *rectangle = mp_obj_malloc(vectorio_rectangle_t, &vectorio_rectangle_type);
+        common_hal_vectorio_rectangle_construct(rectangle, 13, 7, 1);
+        shapes[4] = vectorio_vector_shape_make_new(rectangle, palette, 24, 20);
+
+        // A 64x64 screen in each of the 8 orientations, drawn with spans and
+        // then pixel by pixel.
+        _displayio_colorspace_t colorspace = {.depth = 16, .bytes_per_cell = 2, .pixels_in_byte_share_row = true};
+        displayio_area_t area = {.x1 = 0, .y1 = 0, .x2 = 64, .y2 = 64};
+        uint32_t *mask = m_new(uint32_t, 2 * 64 * 64 / 32);
+        uint16_t *buffer = m_new(uint16_t, 2 * 64 * 64);
+        for (int i = 0; i < 5; i++) {
+            vectorio_vector_shape_t *shape = MP_OBJ_TO_PTR(shapes[i]);
+            int covered = 0;
+            int span_mismatches = vectorio_span_mismatches(&shape->ishape, false, &covered);
+            span_mismatches += vectorio_span_mismatches(&shape->ishape, true, &covered);
+            int draw_mismatches = 0;
+            for (int t = 0; t < 8; t++) {
+                displayio_buffer_transform_t transform = {
+                    .x = t & 1 ? 63 : 0, .y = t & 2 ? 63 : 0, .dx = t & 1 ? -1 : 1, .dy = t & 2 ? -1 : 1,
+                    .scale = 1, .width = 64, .height = 64, .transpose_xy = t & 4,
+                };
+                vectorio_vector_shape_update_transform(shape, &transform);
+                memset(mask, 0, 2 * 64 * 64 / 8);
+                memset(buffer, 0, 2 * 64 * 64 * 2);
+                vectorio_vector_shape_fill_area(shape, &colorspace, &area, mask, (uint32_t *)buffer);
+                get_spans_function *get_spans = shape->ishape.get_spans;
+                shape->ishape.get_spans = vectorio_no_spans;
+                vectorio_vector_shape_fill_area(shape, &colorspace, &area, mask + 64 * 64 / 32, (uint32_t *)(buffer + 64 * 64));
+                shape->ishape.get_spans = get_spans;
+                for (int k = 0; k < 64 * 64; k++) {
+                    bool a = mask[k / 32] & (1u << (k % 32)), b = mask[(64 * 64 + k) / 32] & (1u << (k % 32));
+                    draw_mismatches += a != b || buffer[k] != buffer[64 * 64 + k];
+                }
+            }
+            mp_printf(&mp_plat_print, "%s %d %d %d\n", mp_obj_get_type_str(shape->ishape.shape), covered, span_mismatches, draw_mismatches);
+        }
+        m_del(uint32_t, mask, 2 * 64 * 64 / 32);
+        m_del(uint16_t, buffer, 2 * 64 * 64);
+    }
+    #endif
+
     mp_printf(&mp_plat_print, "# end coverage.c\n");
 
     mp_obj_streamtest_t *s = mp_obj_malloc(mp_obj_streamtest_t, &mp_type_stest_fileio);
@@ -155,6 +155,8 @@ typedef long mp_off_t;
 #define MICROPY_FATFS_LFN_CODE_PAGE    437 /* 1=SFN/ANSI 437=LFN/U.S.(OEM) */
 // CIRCUITPY-CHANGE: enable FAT32 support
 #define MICROPY_FATFS_MKFS_FAT32       (1)
+// CIRCUITPY-CHANGE
+#define MICROPY_FATFS_BLOCK_CACHE      (1)
 // CIRCUITPY-CHANGE: allow FAT label access
 #define MICROPY_FATFS_USE_LABEL (1)
 
@@ -189,6 +191,12 @@ void mp_unix_mark_exec(void);
 #define MICROPY_FORCE_PLAT_ALLOC_EXEC (1)
 #endif
 
+// CIRCUITPY-CHANGE
+// For the sampling profiler, take samples from a SIGPROF interval timer.
+void mp_unix_prof_sampling_timer(int enable);
+#define MICROPY_PROF_SAMPLING_TIMER_START() mp_unix_prof_sampling_timer(1)
+#define MICROPY_PROF_SAMPLING_TIMER_STOP() mp_unix_prof_sampling_timer(0)
+
 // If enabled, configure how to seed random on init.
 #ifdef MICROPY_PY_RANDOM_SEED_INIT_FUNC
 #include <stddef.h>
@@ -34,6 +34,8 @@
 #include "py/mphal.h"
 #include "py/mpthread.h"
 #include "py/runtime.h"
+// CIRCUITPY-CHANGE
+#include "py/profile.h"
 #include "extmod/misc.h"
 
 #if defined(__GLIBC__) && defined(__GLIBC_PREREQ)
@@ -72,6 +74,39 @@ static void sighandler(int signum) {
 }
 #endif
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PROF_SAMPLING && !defined(_WIN32)
+static void prof_sighandler(int signum) {
+    (void)signum;
+    #if MICROPY_PY_THREAD
+    if (mp_thread_get_state() == NULL) {
+        // Not a MicroPython thread.
+        return;
+    }
+    #endif
+    mp_prof_sample();
+}
+
+void mp_unix_prof_sampling_timer(int enable) {
+    struct sigaction sa;
+    sa.sa_flags = SA_RESTART;
+    sigemptyset(&sa.sa_mask);
+    struct itimerval timer = { { 0, 0 }, { 0, 0 } };
+    if (enable) {
+        sa.sa_handler = prof_sighandler;
+        sigaction(SIGPROF, &sa, NULL);
+        // Sample every 1ms of CPU time.
+        timer.it_interval.tv_usec = 1000;
+        timer.it_value.tv_usec = 1000;
+        setitimer(ITIMER_PROF, &timer, NULL);
+    } else {
+        setitimer(ITIMER_PROF, &timer, NULL);
+        sa.sa_handler = SIG_IGN;
+        sigaction(SIGPROF, &sa, NULL);
+    }
+}
+#endif
+
 // CIRCUITPY-CHANGE: mp_hal_set_interrupt_char(int) instead of char
 void mp_hal_set_interrupt_char(int c) {
     // configure terminal settings to (not) let ctrl-C through
@@ -41,6 +41,9 @@
 #define MICROPY_DEBUG_PARSE_RULE_NAME  (1)
 #define MICROPY_TRACKED_ALLOC          (1)
 #define MICROPY_WARNINGS_CATEGORY      (1)
+// CIRCUITPY-CHANGE
+#define MICROPY_PROF_SAMPLING          (1)
+#define MICROPY_EMIT_NATIVE_JIT        (1)
 
 // CIRCUITPY-CHANGE: Disable things never used in circuitpython
 #define MICROPY_PY_CRYPTOLIB          (0)
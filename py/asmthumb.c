@@ -507,6 +507,23 @@ void asm_thumb_ldrh_reg_reg_i12_optimised(asm_thumb_t *as, uint reg_dest, uint r
     }
 }
 
+// CIRCUITPY-CHANGE
+void asm_thumb_load_store_reg_reg_reg(asm_thumb_t *as, uint op_narrow, uint op_wide, uint reg_src_dest, uint reg_base, uint reg_index, uint shift) {
+    bool all_rlo = reg_src_dest < ASM_THUMB_REG_R8 && reg_base < ASM_THUMB_REG_R8 && reg_index < ASM_THUMB_REG_R8;
+    if (shift == 0 && all_rlo) {
+        asm_thumb_op16(as, ASM_THUMB_FORMAT_7_8_ENCODE(op_narrow, reg_src_dest, reg_base, reg_index));
+    } else if (asm_thumb_allow_armv7m(as)) {
+        asm_thumb_op32(as, op_wide | reg_base, reg_src_dest << 12 | shift << 4 | reg_index);
+    } else {
+        // base + (index << shift) == (base + ((1 << shift) - 1) * index) + index
+        assert(all_rlo);
+        for (uint i = (1 << shift) - 1; i > 0; --i) {
+            asm_thumb_add_rlo_rlo_rlo(as, reg_base, reg_base, reg_index);
+        }
+        asm_thumb_op16(as, ASM_THUMB_FORMAT_7_8_ENCODE(op_narrow, reg_src_dest, reg_base, reg_index));
+    }
+}
+
 // this could be wrong, because it should have a range of +/- 16MiB...
 #define OP_BW_HI(byte_offset) (0xf000 | (((byte_offset) >> 12) & 0x07ff))
 #define OP_BW_LO(byte_offset) (0xb800 | (((byte_offset) >> 1) & 0x07ff))
@@ -291,6 +291,53 @@ static inline void asm_thumb_ldrb_rlo_rlo_i5(asm_thumb_t *as, uint rlo_dest, uin
 static inline void asm_thumb_ldrh_rlo_rlo_i5(asm_thumb_t *as, uint rlo_dest, uint rlo_base, uint uint16_offset) {
     asm_thumb_format_9_10(as, ASM_THUMB_FORMAT_10_LDRH, rlo_dest, rlo_base, uint16_offset);
 }
+// CIRCUITPY-CHANGE: register offset loads and stores
+// FORMAT 7: load/store with register offset
+// FORMAT 8: load/store sign-extended byte/halfword (only the halfword ops are used)
+// The index register is not scaled
+
+#define ASM_THUMB_FORMAT_7_STR (0x5000)
+#define ASM_THUMB_FORMAT_7_STRB (0x5400)
+#define ASM_THUMB_FORMAT_7_LDR (0x5800)
+#define ASM_THUMB_FORMAT_7_LDRB (0x5c00)
+#define ASM_THUMB_FORMAT_8_STRH (0x5200)
+#define ASM_THUMB_FORMAT_8_LDRH (0x5a00)
+
+#define ASM_THUMB_FORMAT_7_8_ENCODE(op, rlo_dest, rlo_base, rlo_index) \
+    ((op) | ((rlo_index) << 6) | ((rlo_base) << 3) | (rlo_dest))
+
+// ARMv7-M equivalents, which can scale the index by a left shift of up to 3
+#define ASM_THUMB_OP_STR_W_REG (0xf840)
+#define ASM_THUMB_OP_STRB_W_REG (0xf800)
+#define ASM_THUMB_OP_STRH_W_REG (0xf820)
+#define ASM_THUMB_OP_LDR_W_REG (0xf850)
+#define ASM_THUMB_OP_LDRB_W_REG (0xf810)
+#define ASM_THUMB_OP_LDRH_W_REG (0xf830)
+
+// Access (base + (index << shift)) with a single instruction where possible.
+// On ARMv6-M a non-zero shift is done by adding the index to reg_base, so
+// reg_base is clobbered in that case.
+void asm_thumb_load_store_reg_reg_reg(asm_thumb_t *as, uint op_narrow, uint op_wide, uint reg_src_dest, uint reg_base, uint reg_index, uint shift);
+
+static inline void asm_thumb_str_reg_reg_reg(asm_thumb_t *as, uint reg_src, uint reg_base, uint reg_index) {
+    asm_thumb_load_store_reg_reg_reg(as, ASM_THUMB_FORMAT_7_STR, ASM_THUMB_OP_STR_W_REG, reg_src, reg_base, reg_index, 2);
+}
+static inline void asm_thumb_strb_reg_reg_reg(asm_thumb_t *as, uint reg_src, uint reg_base, uint reg_index) {
+    asm_thumb_load_store_reg_reg_reg(as, ASM_THUMB_FORMAT_7_STRB, ASM_THUMB_OP_STRB_W_REG, reg_src, reg_base, reg_index, 0);
+}
+static inline void asm_thumb_strh_reg_reg_reg(asm_thumb_t *as, uint reg_src, uint reg_base, uint reg_index) {
+    asm_thumb_load_store_reg_reg_reg(as, ASM_THUMB_FORMAT_8_STRH, ASM_THUMB_OP_STRH_W_REG, reg_src, reg_base, reg_index, 1);
+}
+static inline void asm_thumb_ldr_reg_reg_reg(asm_thumb_t *as, uint reg_dest, uint reg_base, uint reg_index) {
+    asm_thumb_load_store_reg_reg_reg(as, ASM_THUMB_FORMAT_7_LDR, ASM_THUMB_OP_LDR_W_REG, reg_dest, reg_base, reg_index, 2);
+}
+static inline void asm_thumb_ldrb_reg_reg_reg(asm_thumb_t *as, uint reg_dest, uint reg_base, uint reg_index) {
+    asm_thumb_load_store_reg_reg_reg(as, ASM_THUMB_FORMAT_7_LDRB, ASM_THUMB_OP_LDRB_W_REG, reg_dest, reg_base, reg_index, 0);
+}
+static inline void asm_thumb_ldrh_reg_reg_reg(asm_thumb_t *as, uint reg_dest, uint reg_base, uint reg_index) {
+    asm_thumb_load_store_reg_reg_reg(as, ASM_THUMB_FORMAT_8_LDRH, ASM_THUMB_OP_LDRH_W_REG, reg_dest, reg_base, reg_index, 1);
+}
+
 static inline void asm_thumb_lsl_rlo_rlo_i5(asm_thumb_t *as, uint rlo_dest, uint rlo_src, uint shift) {
     asm_thumb_format_1(as, ASM_THUMB_FORMAT_1_LSL, rlo_dest, rlo_src, shift);
 }
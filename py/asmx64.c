@@ -95,6 +95,12 @@
 #define MODRM_RM_DISP32 (0x80)
 #define MODRM_RM_REG    (0xc0)
 #define MODRM_RM_R64(x) ((x) & 0x7)
+// CIRCUITPY-CHANGE
+#define MODRM_RM_SIB    (0x04)
+
+#define SIB_SCALE(x)    (((x) & 0x3) << 6)
+#define SIB_INDEX(x)    (((x) & 0x7) << 3)
+#define SIB_BASE(x)     ((x) & 0x7)
 
 #define OP_SIZE_PREFIX (0x66)
 
@@ -206,6 +212,26 @@ static void asm_x64_write_r64_disp(asm_x64_t *as, int r64, int disp_r64, int dis
     }
 }
 
+// CIRCUITPY-CHANGE
+// Emit a REX prefix for an access to (base + index << scale), if one is needed.
+// Byte stores always need one so that the low byte of rsi/rdi can be used.
+static void asm_x64_write_rex_index(asm_x64_t *as, int r64, int base_r64, int index_r64, bool force) {
+    if (force || r64 >= 8 || base_r64 >= 8 || index_r64 >= 8) {
+        asm_x64_write_byte_1(as, REX_PREFIX | REX_R_FROM_R64(r64) | REX_X_FROM_R64(index_r64) | REX_B_FROM_R64(base_r64));
+    }
+}
+
+static void asm_x64_write_r64_index(asm_x64_t *as, int r64, int base_r64, int index_r64, int scale_log2) {
+    // rsp can't be used as an index
+    assert(index_r64 != ASM_X64_REG_RSP);
+    if ((base_r64 & 7) == ASM_X64_REG_RBP) {
+        // Special case for rbp and r13, they need a displacement
+        asm_x64_write_byte_3(as, MODRM_R64(r64) | MODRM_RM_DISP8 | MODRM_RM_SIB, SIB_SCALE(scale_log2) | SIB_INDEX(index_r64) | SIB_BASE(base_r64), 0);
+    } else {
+        asm_x64_write_byte_2(as, MODRM_R64(r64) | MODRM_RM_DISP0 | MODRM_RM_SIB, SIB_SCALE(scale_log2) | SIB_INDEX(index_r64) | SIB_BASE(base_r64));
+    }
+}
+
 static void asm_x64_generic_r64_r64(asm_x64_t *as, int dest_r64, int src_r64, int op) {
     asm_x64_write_byte_3(as, REX_PREFIX | REX_W | REX_R_FROM_R64(src_r64) | REX_B_FROM_R64(dest_r64), op, MODRM_R64(src_r64) | MODRM_RM_REG | MODRM_RM_R64(dest_r64));
 }
@@ -319,6 +345,44 @@ void asm_x64_mov_mem64_to_r64(asm_x64_t *as, int src_r64, int src_disp, int dest
     asm_x64_write_r64_disp(as, dest_r64, src_r64, src_disp);
 }
 
+// CIRCUITPY-CHANGE
+void asm_x64_mov_r8_to_mem8_index(asm_x64_t *as, int src_r64, int base_r64, int index_r64) {
+    asm_x64_write_rex_index(as, src_r64, base_r64, index_r64, true);
+    asm_x64_write_byte_1(as, OPCODE_MOV_R8_TO_RM8);
+    asm_x64_write_r64_index(as, src_r64, base_r64, index_r64, 0);
+}
+
+void asm_x64_mov_r16_to_mem16_index(asm_x64_t *as, int src_r64, int base_r64, int index_r64) {
+    asm_x64_write_byte_1(as, OP_SIZE_PREFIX);
+    asm_x64_write_rex_index(as, src_r64, base_r64, index_r64, false);
+    asm_x64_write_byte_1(as, OPCODE_MOV_R64_TO_RM64);
+    asm_x64_write_r64_index(as, src_r64, base_r64, index_r64, 1);
+}
+
+void asm_x64_mov_r32_to_mem32_index(asm_x64_t *as, int src_r64, int base_r64, int index_r64) {
+    asm_x64_write_rex_index(as, src_r64, base_r64, index_r64, false);
+    asm_x64_write_byte_1(as, OPCODE_MOV_R64_TO_RM64);
+    asm_x64_write_r64_index(as, src_r64, base_r64, index_r64, 2);
+}
+
+void asm_x64_mov_mem8_to_r64zx_index(asm_x64_t *as, int base_r64, int index_r64, int dest_r64) {
+    asm_x64_write_rex_index(as, dest_r64, base_r64, index_r64, false);
+    asm_x64_write_byte_2(as, 0x0f, OPCODE_MOVZX_RM8_TO_R64);
+    asm_x64_write_r64_index(as, dest_r64, base_r64, index_r64, 0);
+}
+
+void asm_x64_mov_mem16_to_r64zx_index(asm_x64_t *as, int base_r64, int index_r64, int dest_r64) {
+    asm_x64_write_rex_index(as, dest_r64, base_r64, index_r64, false);
+    asm_x64_write_byte_2(as, 0x0f, OPCODE_MOVZX_RM16_TO_R64);
+    asm_x64_write_r64_index(as, dest_r64, base_r64, index_r64, 1);
+}
+
+void asm_x64_mov_mem32_to_r64zx_index(asm_x64_t *as, int base_r64, int index_r64, int dest_r64) {
+    asm_x64_write_rex_index(as, dest_r64, base_r64, index_r64, false);
+    asm_x64_write_byte_1(as, OPCODE_MOV_RM64_TO_R64);
+    asm_x64_write_r64_index(as, dest_r64, base_r64, index_r64, 2);
+}
+
 static void asm_x64_lea_disp_to_r64(asm_x64_t *as, int src_r64, int src_disp, int dest_r64) {
     // use REX prefix for 64 bit operation
     asm_x64_write_byte_2(as, REX_PREFIX | REX_W | REX_R_FROM_R64(dest_r64) | REX_B_FROM_R64(src_r64), OPCODE_LEA_MEM_TO_R64);
@@ -97,6 +97,13 @@ void asm_x64_mov_mem8_to_r64zx(asm_x64_t *as, int src_r64, int src_disp, int des
 void asm_x64_mov_mem16_to_r64zx(asm_x64_t *as, int src_r64, int src_disp, int dest_r64);
 void asm_x64_mov_mem32_to_r64zx(asm_x64_t *as, int src_r64, int src_disp, int dest_r64);
 void asm_x64_mov_mem64_to_r64(asm_x64_t *as, int src_r64, int src_disp, int dest_r64);
+// CIRCUITPY-CHANGE: these access (base + index * size)
+void asm_x64_mov_r8_to_mem8_index(asm_x64_t *as, int src_r64, int base_r64, int index_r64);
+void asm_x64_mov_r16_to_mem16_index(asm_x64_t *as, int src_r64, int base_r64, int index_r64);
+void asm_x64_mov_r32_to_mem32_index(asm_x64_t *as, int src_r64, int base_r64, int index_r64);
+void asm_x64_mov_mem8_to_r64zx_index(asm_x64_t *as, int base_r64, int index_r64, int dest_r64);
+void asm_x64_mov_mem16_to_r64zx_index(asm_x64_t *as, int base_r64, int index_r64, int dest_r64);
+void asm_x64_mov_mem32_to_r64zx_index(asm_x64_t *as, int base_r64, int index_r64, int dest_r64);
 void asm_x64_not_r64(asm_x64_t *as, int dest_r64);
 void asm_x64_neg_r64(asm_x64_t *as, int dest_r64);
 void asm_x64_and_r64_r64(asm_x64_t *as, int dest_r64, int src_r64);
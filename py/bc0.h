@@ -51,12 +51,12 @@
 // Nibbles in magic number are: BB BB BB BB BB BO VV QU
 #define MP_BC_FORMAT(op) ((0x000003a4 >> (2 * ((op) >> 4))) & 3)
 
-// Load, Store, Delete, Import, Make, Build, Unpack, Call, Jump, Exception, For, sTack, Return, Yield, Op
+// Load, Store, Delete, Import, Make, Build, Unpack, Call, Jump, Exception, For, sTack, Return, Yield, Op, Peephole
 #define MP_BC_BASE_RESERVED                 (0x00) // ----------------
-#define MP_BC_BASE_QSTR_O                   (0x10) // LLLLLLSSSDDII---
+#define MP_BC_BASE_QSTR_O                   (0x10) // LLLLLLSSSDDIIPPP
 #define MP_BC_BASE_VINT_E                   (0x20) // MMLLLLSSDDBBBBBB
-#define MP_BC_BASE_VINT_O                   (0x30) // UUMMCCCC--------
-#define MP_BC_BASE_JUMP_E                   (0x40) // J-JJJJJEEEEF----
+#define MP_BC_BASE_VINT_O                   (0x30) // UUMMCCCCPP------
+#define MP_BC_BASE_JUMP_E                   (0x40) // JPJJJJJEEEEF----
 #define MP_BC_BASE_BYTE_O                   (0x50) // LLLLSSDTTTTTEEFF
 #define MP_BC_BASE_BYTE_E                   (0x60) // --BREEEYYI------
 #define MP_BC_LOAD_CONST_SMALL_INT_MULTI    (0x70) // LLLLLLLLLLLLLLLL
@@ -159,4 +159,24 @@
 #define MP_BC_IMPORT_FROM                   (MP_BC_BASE_QSTR_O + 0x0c) // qstr
 #define MP_BC_IMPORT_STAR                   (MP_BC_BASE_BYTE_E + 0x09)
 
+// CIRCUITPY-CHANGE: fused opcodes
+// Fused opcodes (superinstructions), generated by the bytecode emitter's
+// peephole stage from common sequences of the opcodes above.
+#define MP_BC_LOAD_FAST0_ATTR               (MP_BC_BASE_QSTR_O + 0x0d) // qstr; LOAD_FAST 0 + LOAD_ATTR
+#define MP_BC_LOAD_FAST0_METHOD             (MP_BC_BASE_QSTR_O + 0x0e) // qstr; LOAD_FAST 0 + LOAD_METHOD
+#define MP_BC_STORE_FAST0_ATTR              (MP_BC_BASE_QSTR_O + 0x0f) // qstr; LOAD_FAST 0 + STORE_ATTR
+#define MP_BC_BINARY_OP_SMALL_INT           (MP_BC_BASE_VINT_O + 0x08) // uint; LOAD_CONST_SMALL_INT + BINARY_OP
+#define MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT (MP_BC_BASE_VINT_O + 0x09) // uint; LOAD_FAST + LOAD_CONST_SMALL_INT + BINARY_OP
+#define MP_BC_BINARY_OP_POP_JUMP_IF         (MP_BC_BASE_JUMP_E + 0x01) // signed relative bytecode offset; then a byte
+
+// The uint argument of the fused small-int binary ops packs the binary op in
+// the low bits, then the LOAD_CONST_SMALL_INT_MULTI index of the constant, then
+// (for the LOAD_FAST variant) the LOAD_FAST_MULTI local number.
+#define MP_BC_FUSED_ARG_BITS                (6)
+#define MP_BC_FUSED_ARG_MASK                ((1 << MP_BC_FUSED_ARG_BITS) - 1)
+
+// The extra byte of MP_BC_BINARY_OP_POP_JUMP_IF holds the comparison op, with
+// this bit set if the jump is taken when the result is true.
+#define MP_BC_BINARY_OP_POP_JUMP_IF_TRUE    (0x80)
+
 #endif // MICROPY_INCLUDED_PY_BC0_H
@@ -339,6 +339,9 @@ endif
 ifeq ($(CIRCUITPY_RANDOM),1)
 SRC_PATTERNS += random/%
 endif
+ifeq ($(CIRCUITPY_RECORDLOG),1)
+SRC_PATTERNS += recordlog/%
+endif
 ifeq ($(CIRCUITPY_RGBMATRIX),1)
 SRC_PATTERNS += rgbmatrix/%
 endif
@@ -749,6 +752,7 @@ SRC_SHARED_MODULE_ALL = \
 	qrio/QRDecoder.c \
 	rainbowio/__init__.c \
 	random/__init__.c \
+	recordlog/RecordLog.c \
 	rgbmatrix/RGBMatrix.c \
 	rgbmatrix/__init__.c \
 	rotaryio/IncrementalEncoder.c \
@@ -31,6 +31,8 @@
 // we need to provide actual implementations.
 extern void common_hal_mcu_disable_interrupts(void);
 extern void common_hal_mcu_enable_interrupts(void);
+extern void supervisor_enable_tick(void);
+extern void supervisor_disable_tick(void);
 #define MICROPY_BEGIN_ATOMIC_SECTION() (common_hal_mcu_disable_interrupts(), 0)
 #define MICROPY_END_ATOMIC_SECTION(state) ((void)state, common_hal_mcu_enable_interrupts())
 
@@ -59,6 +61,8 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_DEBUG_PRINTERS           (0)
 #define MICROPY_EMIT_INLINE_THUMB        (CIRCUITPY_ENABLE_MPY_NATIVE)
 #define MICROPY_EMIT_THUMB               (CIRCUITPY_ENABLE_MPY_NATIVE)
+#define MICROPY_EMIT_NATIVE_JIT          (CIRCUITPY_EMIT_NATIVE_JIT)
+#define MICROPY_EMIT_NATIVE_JIT_THRESHOLD (100)
 #define MICROPY_EMIT_X64                 (0)
 #define MICROPY_ENABLE_DOC_STRING        (0)
 #define MICROPY_ENABLE_FINALISER         (1)
@@ -89,7 +93,12 @@ extern void common_hal_mcu_enable_interrupts(void);
 #define MICROPY_OPT_MAP_LOOKUP_CACHE  (CIRCUITPY_OPT_MAP_LOOKUP_CACHE)
 #define MICROPY_OPT_MPZ_BITWISE          (0)
 #define MICROPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE (CIRCUITPY_OPT_CACHE_MAP_LOOKUP_IN_BYTECODE)
+#define MICROPY_OPT_VM_SMALL_INT_FAST_PATH (CIRCUITPY_OPT_VM_SMALL_INT_FAST_PATH)
 #define MICROPY_PERSISTENT_CODE_LOAD     (1)
+// Sample the Python call stack on every supervisor tick while profiling.
+#define MICROPY_PROF_SAMPLING            (CIRCUITPY_PROF_SAMPLING)
+#define MICROPY_PROF_SAMPLING_TIMER_START() supervisor_enable_tick()
+#define MICROPY_PROF_SAMPLING_TIMER_STOP() supervisor_disable_tick()
 
 #define MICROPY_PY_ARRAY                 (CIRCUITPY_ARRAY)
 #define MICROPY_PY_ARRAY_SLICE_ASSIGN    (1)
@@ -279,6 +288,10 @@ typedef long mp_off_t;
 #define MICROPY_FATFS_MKFS_FAT32           (CIRCUITPY_FULL_BUILD)
 #endif
 
+#ifndef MICROPY_FATFS_BLOCK_CACHE
+#define MICROPY_FATFS_BLOCK_CACHE           (CIRCUITPY_FULL_BUILD)
+#endif
+
 // LONGINT_IMPL_xxx are defined in the Makefile.
 //
 #ifdef LONGINT_IMPL_NONE
@@ -373,6 +386,17 @@ typedef long mp_off_t;
 #define CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE (128)
 #endif
 
+// Maximum number of rectangles a partial refresh is planned into.
+#ifndef CIRCUITPY_DISPLAY_REFRESH_AREA_LIMIT
+#define CIRCUITPY_DISPLAY_REFRESH_AREA_LIMIT (8)
+#endif
+
+// Fixed cost of refreshing one more rectangle, in pixels. Two dirty areas are
+// merged when rendering the pixels between them is cheaper than this.
+#ifndef CIRCUITPY_DISPLAY_REFRESH_AREA_COST
+#define CIRCUITPY_DISPLAY_REFRESH_AREA_COST (256)
+#endif
+
 #else
 #define CIRCUITPY_DISPLAY_LIMIT (0)
 #define CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE (0)
@@ -451,6 +475,13 @@ void background_callback_run_all(void);
 #define CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS 1000
 #endif
 
+// How long after the last file sync to wait before flushing the CIRCUITPY
+// flash cache. 0 flushes on every sync. A sync also flushes straight away
+// when every sector the cache can hold is dirty.
+#ifndef CIRCUITPY_FILESYSTEM_FLUSH_QUIET_MS
+#define CIRCUITPY_FILESYSTEM_FLUSH_QUIET_MS 100
+#endif
+
 #ifndef CIRCUITPY_PYSTACK_SIZE
 #define CIRCUITPY_PYSTACK_SIZE 1536
 #endif
@@ -156,6 +156,10 @@ CFLAGS += -DCIRCUITPY_BINASCII=$(CIRCUITPY_BINASCII)
 CIRCUITPY_BITBANG_APA102 ?= 0
 CFLAGS += -DCIRCUITPY_BITBANG_APA102=$(CIRCUITPY_BITBANG_APA102)
 
+# Keep per-callback and per-priority run times of background callbacks.
+CIRCUITPY_BACKGROUND_CALLBACK_STATS ?= 0
+CFLAGS += -DCIRCUITPY_BACKGROUND_CALLBACK_STATS=$(CIRCUITPY_BACKGROUND_CALLBACK_STATS)
+
 CIRCUITPY_BITBANGIO ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_BITBANGIO=$(CIRCUITPY_BITBANGIO)
 
@@ -273,6 +277,11 @@ CFLAGS += -DCIRCUITPY_DUALBANK=$(CIRCUITPY_DUALBANK)
 CIRCUITPY_ENABLE_MPY_NATIVE ?= 0
 CFLAGS += -DCIRCUITPY_ENABLE_MPY_NATIVE=$(CIRCUITPY_ENABLE_MPY_NATIVE)
 
+# Recompile hot bytecode functions with the native emitter (experimental).
+# Needs the native emitter, so CIRCUITPY_ENABLE_MPY_NATIVE too.
+CIRCUITPY_EMIT_NATIVE_JIT ?= 0
+CFLAGS += -DCIRCUITPY_EMIT_NATIVE_JIT=$(CIRCUITPY_EMIT_NATIVE_JIT)
+
 CIRCUITPY_OS_GETENV ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_OS_GETENV=$(CIRCUITPY_OS_GETENV)
 
@@ -407,6 +416,9 @@ CFLAGS += -DCIRCUITPY_OPT_LOAD_ATTR_FAST_PATH=$(CIRCUITPY_OPT_LOAD_ATTR_FAST_PAT
 CIRCUITPY_OPT_MAP_LOOKUP_CACHE ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_OPT_MAP_LOOKUP_CACHE=$(CIRCUITPY_OPT_MAP_LOOKUP_CACHE)
 
+CIRCUITPY_OPT_VM_SMALL_INT_FAST_PATH ?= $(CIRCUITPY_FULL_BUILD)
+CFLAGS += -DCIRCUITPY_OPT_VM_SMALL_INT_FAST_PATH=$(CIRCUITPY_OPT_VM_SMALL_INT_FAST_PATH)
+
 CIRCUITPY_OS ?= 1
 CFLAGS += -DCIRCUITPY_OS=$(CIRCUITPY_OS)
 
@@ -427,6 +439,11 @@ CFLAGS += -DCIRCUITPY_PIXELMAP=$(CIRCUITPY_PIXELMAP)
 CIRCUITPY_PORT_SERIAL ?= 0
 CFLAGS += -DCIRCUITPY_PORT_SERIAL=$(CIRCUITPY_PORT_SERIAL)
 
+# Sampling profiler (micropython.prof_start() etc.), off by default because
+# every bytecode call pays to maintain the chain of executing frames.
+CIRCUITPY_PROF_SAMPLING ?= 0
+CFLAGS += -DCIRCUITPY_PROF_SAMPLING=$(CIRCUITPY_PROF_SAMPLING)
+
 # Only for SAMD boards for the moment
 CIRCUITPY_PS2IO ?= 0
 CFLAGS += -DCIRCUITPY_PS2IO=$(CIRCUITPY_PS2IO)
@@ -455,6 +472,9 @@ CFLAGS += -DCIRCUITPY_RANDOM=$(CIRCUITPY_RANDOM)
 CIRCUITPY_RE ?= $(CIRCUITPY_FULL_BUILD)
 CFLAGS += -DCIRCUITPY_RE=$(CIRCUITPY_RE)
 
+CIRCUITPY_RECORDLOG ?= $(CIRCUITPY_FULL_BUILD)
+CFLAGS += -DCIRCUITPY_RECORDLOG=$(CIRCUITPY_RECORDLOG)
+
 # Should busio.I2C() check for pullups?
 # Some boards in combination with certain peripherals may not want this.
 CIRCUITPY_REQUIRE_I2C_PULLUPS ?= 1
@@ -642,6 +662,10 @@ CIRCUITPY_USB_MSC ?= $(CIRCUITPY_USB_DEVICE)
 CFLAGS += -DCIRCUITPY_USB_MSC=$(CIRCUITPY_USB_MSC)
 CIRCUITPY_USB_MSC_ENABLED_DEFAULT ?= $(CIRCUITPY_USB_MSC)
 CFLAGS += -DCIRCUITPY_USB_MSC_ENABLED_DEFAULT=$(CIRCUITPY_USB_MSC_ENABLED_DEFAULT)
+# Overlap USB transfers with disk access by writing and reading ahead from
+# background callbacks. Costs a CFG_TUD_MSC_BUFSIZE buffer of RAM.
+CIRCUITPY_USB_MSC_PIPELINE ?= $(call enable-if-all,$(CIRCUITPY_USB_MSC) $(CIRCUITPY_FULL_BUILD))
+CFLAGS += -DCIRCUITPY_USB_MSC_PIPELINE=$(CIRCUITPY_USB_MSC_PIPELINE)
 
 # Defaulting this to OFF initially because it has only been tested on a
 # limited number of platforms, and the other platforms do not have this
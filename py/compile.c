@@ -2851,14 +2851,16 @@ static void compile_node(compiler_t *comp, mp_parse_node_t pn) {
 }
 
 #if MICROPY_EMIT_NATIVE
-static int compile_viper_type_annotation(compiler_t *comp, mp_parse_node_t pn_annotation) {
+// CIRCUITPY-CHANGE: buf8/buf16/buf32 are only allowed for arguments, which is
+// where their bounds come from.
+static int compile_viper_type_annotation(compiler_t *comp, mp_parse_node_t pn_annotation, bool is_param) {
     int native_type = MP_NATIVE_TYPE_OBJ;
     if (MP_PARSE_NODE_IS_NULL(pn_annotation)) {
         // No annotation, type defaults to object
     } else if (MP_PARSE_NODE_IS_ID(pn_annotation)) {
         qstr type_name = MP_PARSE_NODE_LEAF_ARG(pn_annotation);
         native_type = mp_native_type_from_qstr(type_name);
-        if (native_type < 0) {
+        if (native_type < 0 || (!is_param && native_type >= MP_NATIVE_TYPE_BUF8)) {
             comp->compile_error = mp_obj_new_exception_msg_varg(&mp_type_ViperTypeError, MP_ERROR_TEXT("unknown type '%q'"), type_name);
             native_type = 0;
         }
@@ -2948,7 +2950,7 @@ static void compile_scope_func_lambda_param(compiler_t *comp, mp_parse_node_t pn
 
         #if MICROPY_EMIT_NATIVE
         if (comp->scope_cur->emit_options == MP_EMIT_OPT_VIPER && pn_name == PN_typedargslist_name && pns != NULL) {
-            id_info->flags |= compile_viper_type_annotation(comp, pns->nodes[1]) << ID_FLAG_VIPER_TYPE_POS;
+            id_info->flags |= compile_viper_type_annotation(comp, pns->nodes[1], true) << ID_FLAG_VIPER_TYPE_POS;
         }
         #else
         (void)pns;
@@ -3054,7 +3056,8 @@ static bool compile_scope(compiler_t *comp, scope_t *scope, pass_kind_t pass) {
     comp->next_label = 0;
     mp_emit_common_start_pass(&comp->emit_common, pass);
     EMIT_ARG(start_pass, pass, scope);
-    reserve_labels_for_native(comp, 6); // used by native's start_pass
+    // CIRCUITPY-CHANGE: one more for viper's buf bounds checks
+    reserve_labels_for_native(comp, 7); // used by native's start_pass
 
     if (comp->pass == MP_PASS_SCOPE) {
         // reset maximum stack sizes in scope
@@ -3090,7 +3093,7 @@ static bool compile_scope(compiler_t *comp, scope_t *scope, pass_kind_t pass) {
             #if MICROPY_EMIT_NATIVE
             if (scope->emit_options == MP_EMIT_OPT_VIPER) {
                 // Compile return type; pns->nodes[2] is return/whole function annotation
-                scope->scope_flags |= compile_viper_type_annotation(comp, pns->nodes[2]) << MP_SCOPE_FLAG_VIPERRET_POS;
+                scope->scope_flags |= compile_viper_type_annotation(comp, pns->nodes[2], false) << MP_SCOPE_FLAG_VIPERRET_POS;
             }
             #endif // MICROPY_EMIT_NATIVE
         }
@@ -3424,7 +3427,9 @@ static void scope_compute_things(scope_t *scope) {
         if (id->kind == ID_INFO_KIND_GLOBAL_EXPLICIT) {
             // This function makes a reference to a global variable
             if (scope->emit_options == MP_EMIT_OPT_VIPER
-                && mp_native_type_from_qstr(id->qst) >= MP_NATIVE_TYPE_INT) {
+                // CIRCUITPY-CHANGE: or one of the ptr_sum/ptr_min/ptr_max/ptr_clamp builtins
+                && (mp_native_type_from_qstr(id->qst) >= MP_NATIVE_TYPE_INT
+                    || mp_native_ptr_op_from_qstr(id->qst) >= 0)) {
                 // A casting operator in viper mode, not a real global reference
             } else {
                 scope->scope_flags |= MP_SCOPE_FLAG_REFGLOBALS;
@@ -73,6 +73,15 @@ struct _emit_t {
 
     size_t n_info;
     size_t n_cell;
+
+    // CIRCUITPY-CHANGE: opcode fusion
+    // Peephole state used to fuse common opcode sequences into a single
+    // opcode.  fuse_op holds the most recently emitted single-byte opcodes
+    // (index 0 is the latest) and fuse_op_offset the offset of each.  No
+    // fused opcode may start before fuse_barrier (the last label).
+    byte fuse_op[2];
+    size_t fuse_op_offset[2];
+    size_t fuse_barrier;
 };
 
 emit_t *emit_bc_new(mp_emit_common_t *emit_common) {
@@ -168,6 +177,38 @@ static void emit_write_bytecode_byte(emit_t *emit, int stack_adj, byte b1) {
     mp_emit_bc_adjust_stack_size(emit, stack_adj);
     byte *c = emit_get_cur_to_write_bytecode(emit, 1);
     c[0] = b1;
+    // CIRCUITPY-CHANGE
+    if (!emit->suppress) {
+        emit->fuse_op[1] = emit->fuse_op[0];
+        emit->fuse_op_offset[1] = emit->fuse_op_offset[0];
+        emit->fuse_op[0] = b1;
+        emit->fuse_op_offset[0] = emit->bytecode_offset - 1;
+    }
+}
+
+// CIRCUITPY-CHANGE: opcode fusion
+// Check if the last num_ops single-byte opcodes were emitted back-to-back right
+// up to the current position, with no label or source line boundary between
+// them, and so can be replaced by a fused opcode.  If so, the caller rewinds
+// the bytecode offset by num_ops and emits the fused opcode in their place.
+static bool emit_bc_can_fuse(emit_t *emit, size_t num_ops) {
+    if (emit->suppress) {
+        return false;
+    }
+    size_t offset = emit->bytecode_offset;
+    for (size_t i = 0; i < num_ops; ++i) {
+        if (emit->fuse_op[i] == MP_BC_BASE_RESERVED || emit->fuse_op_offset[i] + 1 != offset) {
+            return false;
+        }
+        offset -= 1;
+    }
+    return offset >= emit->fuse_barrier && offset >= emit->last_source_line_offset;
+}
+
+static void emit_bc_fuse_rewind(emit_t *emit, size_t num_ops) {
+    emit->bytecode_offset -= num_ops;
+    emit->fuse_op[0] = MP_BC_BASE_RESERVED;
+    emit->fuse_op[1] = MP_BC_BASE_RESERVED;
 }
 
 // Similar to mp_encode_uint(), just some extra handling to encode sign
@@ -290,6 +331,10 @@ void mp_emit_bc_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scope) {
     emit->bytecode_offset = 0;
     emit->code_info_offset = 0;
     emit->overflow = false;
+    // CIRCUITPY-CHANGE
+    emit->fuse_op[0] = MP_BC_BASE_RESERVED;
+    emit->fuse_op[1] = MP_BC_BASE_RESERVED;
+    emit->fuse_barrier = 0;
 
     // Write local state size, exception stack size, scope flags and number of arguments
     {
@@ -461,6 +506,10 @@ void mp_emit_bc_label_assign(emit_t *emit, mp_uint_t l) {
 
     // Assign label offset.
     emit->label_offsets[l] = emit->bytecode_offset;
+
+    // CIRCUITPY-CHANGE
+    // Opcodes before a label can't be fused with those after it.
+    emit->fuse_barrier = emit->bytecode_offset;
 }
 
 void mp_emit_bc_import(emit_t *emit, qstr qst, int kind) {
@@ -526,6 +575,12 @@ void mp_emit_bc_load_global(emit_t *emit, qstr qst, int kind) {
 }
 
 void mp_emit_bc_load_method(emit_t *emit, qstr qst, bool is_super) {
+    // CIRCUITPY-CHANGE
+    if (!is_super && emit_bc_can_fuse(emit, 1) && emit->fuse_op[0] == MP_BC_LOAD_FAST_MULTI) {
+        emit_bc_fuse_rewind(emit, 1);
+        emit_write_bytecode_byte_qstr(emit, 1, MP_BC_LOAD_FAST0_METHOD, qst);
+        return;
+    }
     int stack_adj = 1 - 2 * is_super;
     emit_write_bytecode_byte_qstr(emit, stack_adj, is_super ? MP_BC_LOAD_SUPER_METHOD : MP_BC_LOAD_METHOD, qst);
 }
@@ -548,13 +603,25 @@ void mp_emit_bc_subscr(emit_t *emit, int kind) {
 
 void mp_emit_bc_attr(emit_t *emit, qstr qst, int kind) {
     if (kind == MP_EMIT_ATTR_LOAD) {
-        emit_write_bytecode_byte_qstr(emit, 0, MP_BC_LOAD_ATTR, qst);
+        // CIRCUITPY-CHANGE
+        if (emit_bc_can_fuse(emit, 1) && emit->fuse_op[0] == MP_BC_LOAD_FAST_MULTI) {
+            emit_bc_fuse_rewind(emit, 1);
+            emit_write_bytecode_byte_qstr(emit, 0, MP_BC_LOAD_FAST0_ATTR, qst);
+        } else {
+            emit_write_bytecode_byte_qstr(emit, 0, MP_BC_LOAD_ATTR, qst);
+        }
     } else {
         if (kind == MP_EMIT_ATTR_DELETE) {
             mp_emit_bc_load_null(emit);
             mp_emit_bc_rot_two(emit);
         }
-        emit_write_bytecode_byte_qstr(emit, -2, MP_BC_STORE_ATTR, qst);
+        // CIRCUITPY-CHANGE
+        if (emit_bc_can_fuse(emit, 1) && emit->fuse_op[0] == MP_BC_LOAD_FAST_MULTI) {
+            emit_bc_fuse_rewind(emit, 1);
+            emit_write_bytecode_byte_qstr(emit, -2, MP_BC_STORE_FAST0_ATTR, qst);
+        } else {
+            emit_write_bytecode_byte_qstr(emit, -2, MP_BC_STORE_ATTR, qst);
+        }
     }
 }
 
@@ -614,6 +681,17 @@ void mp_emit_bc_jump(emit_t *emit, mp_uint_t label) {
 }
 
 void mp_emit_bc_pop_jump_if(emit_t *emit, bool cond, mp_uint_t label) {
+    // CIRCUITPY-CHANGE
+    if (emit_bc_can_fuse(emit, 1)
+        && emit->fuse_op[0] >= MP_BC_BINARY_OP_MULTI + MP_BINARY_OP_LESS
+        && emit->fuse_op[0] <= MP_BC_BINARY_OP_MULTI + MP_BINARY_OP_IS) {
+        // Fuse a comparison with the conditional jump that consumes its result.
+        byte op = emit->fuse_op[0] - MP_BC_BINARY_OP_MULTI;
+        emit_bc_fuse_rewind(emit, 1);
+        emit_write_bytecode_byte_label(emit, -1, MP_BC_BINARY_OP_POP_JUMP_IF, label);
+        emit_write_bytecode_raw_byte(emit, (cond ? MP_BC_BINARY_OP_POP_JUMP_IF_TRUE : 0) | op);
+        return;
+    }
     if (cond) {
         emit_write_bytecode_byte_label(emit, -1, MP_BC_POP_JUMP_IF_TRUE, label);
     } else {
@@ -702,6 +780,26 @@ void mp_emit_bc_binary_op(emit_t *emit, mp_binary_op_t op) {
         invert = true;
         op = MP_BINARY_OP_IS;
     }
+    // CIRCUITPY-CHANGE
+    MP_STATIC_ASSERT(MP_BINARY_OP_NUM_BYTECODE <= MP_BC_FUSED_ARG_MASK + 1);
+    MP_STATIC_ASSERT(MP_BC_LOAD_CONST_SMALL_INT_MULTI_NUM <= MP_BC_FUSED_ARG_MASK + 1);
+    if (!invert && emit_bc_can_fuse(emit, 1)
+        && emit->fuse_op[0] >= MP_BC_LOAD_CONST_SMALL_INT_MULTI
+        && emit->fuse_op[0] < MP_BC_LOAD_CONST_SMALL_INT_MULTI + MP_BC_LOAD_CONST_SMALL_INT_MULTI_NUM) {
+        // Fuse a small-int constant (and possibly the local before it) into the binary op.
+        mp_uint_t arg = (emit->fuse_op[0] - MP_BC_LOAD_CONST_SMALL_INT_MULTI) << MP_BC_FUSED_ARG_BITS | op;
+        if (emit_bc_can_fuse(emit, 2)
+            && emit->fuse_op[1] >= MP_BC_LOAD_FAST_MULTI
+            && emit->fuse_op[1] < MP_BC_LOAD_FAST_MULTI + MP_BC_LOAD_FAST_MULTI_NUM) {
+            arg |= (mp_uint_t)(emit->fuse_op[1] - MP_BC_LOAD_FAST_MULTI) << (2 * MP_BC_FUSED_ARG_BITS);
+            emit_bc_fuse_rewind(emit, 2);
+            emit_write_bytecode_byte_uint(emit, -1, MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT, arg);
+        } else {
+            emit_bc_fuse_rewind(emit, 1);
+            emit_write_bytecode_byte_uint(emit, -1, MP_BC_BINARY_OP_SMALL_INT, arg);
+        }
+        return;
+    }
     emit_write_bytecode_byte(emit, -1, MP_BC_BINARY_OP_MULTI + op);
     if (invert) {
         emit_write_bytecode_byte(emit, 0, MP_BC_UNARY_OP_MULTI + MP_UNARY_OP_NOT);
@@ -78,6 +78,11 @@ void mp_emit_glue_assign_bytecode(mp_raw_code_t *rc, const byte *code,
     rc->fun_data = code;
     rc->children = children;
 
+    // CIRCUITPY-CHANGE: JIT tier
+    #if MICROPY_EMIT_NATIVE_JIT
+    rc->jit_calls = 1;
+    #endif
+
     #if MICROPY_PERSISTENT_CODE_SAVE
     rc->fun_data_len = len;
     rc->n_children = n_children;
@@ -257,7 +262,8 @@ mp_obj_t mp_make_function_from_proto_fun(mp_proto_fun_t proto_fun, const mp_modu
                 ((mp_obj_base_t *)MP_OBJ_TO_PTR(fun))->type = &mp_type_gen_wrap;
             }
 
-            #if MICROPY_PY_SYS_SETTRACE
+            // CIRCUITPY-CHANGE: the JIT tier also needs the raw code
+            #if MICROPY_PY_SYS_SETTRACE || MICROPY_EMIT_NATIVE_JIT
             mp_obj_fun_bc_t *self_fun = (mp_obj_fun_bc_t *)MP_OBJ_TO_PTR(fun);
             self_fun->rc = rc;
             #endif
@@ -80,6 +80,13 @@ typedef struct _mp_raw_code_t {
     bool is_async : 1;
     const void *fun_data;
     struct _mp_raw_code_t **children;
+    // CIRCUITPY-CHANGE: JIT tier
+    #if MICROPY_EMIT_NATIVE_JIT
+    // Call counter for the JIT tier.  It starts at 1 for bytecode created in RAM
+    // and stays 0 (meaning never compile) for frozen bytecode or once compiled.
+    uint16_t jit_calls;
+    struct _mp_raw_code_jit_t *jit;
+    #endif
     #if MICROPY_PERSISTENT_CODE_SAVE
     uint32_t fun_data_len; // for mp_raw_code_save
     uint16_t n_children;
@@ -113,6 +120,11 @@ typedef struct _mp_raw_code_truncated_t {
     bool is_async : 1;
     const void *fun_data;
     struct _mp_raw_code_t **children;
+    // CIRCUITPY-CHANGE: JIT tier
+    #if MICROPY_EMIT_NATIVE_JIT
+    uint16_t jit_calls;
+    struct _mp_raw_code_jit_t *jit;
+    #endif
     #if MICROPY_PERSISTENT_CODE_SAVE
     uint32_t fun_data_len;
     uint16_t n_children;
@@ -144,6 +156,22 @@ void mp_emit_glue_assign_native(mp_raw_code_t *rc, mp_raw_code_kind_t kind, cons
     #endif
     uint16_t scope_flags, uint32_t asm_n_pos_args, uint32_t asm_type_sig);
 
+// CIRCUITPY-CHANGE: JIT tier
+#if MICROPY_EMIT_NATIVE_JIT
+// Native code generated by the JIT tier from a bytecode raw code.
+typedef struct _mp_raw_code_jit_t {
+    const void *fun_data;
+    struct _mp_raw_code_t *const *children;
+    // The module context the bytecode was translated against, and the context
+    // to run the native code with.  The latter has the same globals and its
+    // tables extend those of the former, so bytecode still running can use it.
+    const mp_module_context_t *context_in;
+    mp_module_context_t *context;
+} mp_raw_code_jit_t;
+
+bool mp_emit_jit_call(struct _mp_obj_fun_bc_t *fun);
+#endif
+
 mp_obj_t mp_make_function_from_proto_fun(mp_proto_fun_t proto_fun, const mp_module_context_t *context, const mp_obj_t *def_args);
 mp_obj_t mp_make_closure_from_proto_fun(mp_proto_fun_t proto_fun, const mp_module_context_t *context, mp_uint_t n_closed_over, const mp_obj_t *args);
 
@@ -0,0 +1,850 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+// JIT tier: recompile hot bytecode functions with the native emitter.
+//
+// A bytecode function counts its calls in its raw code.  Once the count passes
+// MP_STATE_VM(jit_threshold) the bytecode is translated, opcode by opcode, into
+// calls on the native emitter, much as the compiler would have done for a
+// @micropython.native function, and the function object is switched over to
+// the resulting machine code.
+//
+// Only a subset of bytecode is supported: no exception handlers, generators,
+// closures, nested function definitions, imports or name lookups.  Locals must
+// provably be assigned before they are loaded, because native code does not
+// check for unbound locals.  Anything else is left running as bytecode.
+
+#include <string.h>
+
+#include "py/bc0.h"
+#include "py/emit.h"
+#include "py/emitglue.h"
+#include "py/gc.h"
+#include "py/mpthread.h"
+#include "py/nativeglue.h"
+#include "py/objfun.h"
+#include "py/objlist.h"
+#include "py/runtime.h"
+#include "py/scope.h"
+
+#if MICROPY_EMIT_NATIVE_JIT
+
+#if MICROPY_DYNAMIC_COMPILER || !MICROPY_EMIT_NATIVE || !MICROPY_ENABLE_COMPILER
+#error "MICROPY_EMIT_NATIVE_JIT requires the compiler and a native emitter for the target"
+#endif
+
+// define a macro to access the native emitter, as compile.c does
+#if MICROPY_EMIT_X64
+#define NATIVE_EMITTER(f) emit_native_x64_##f
+#elif MICROPY_EMIT_X86
+#define NATIVE_EMITTER(f) emit_native_x86_##f
+#elif MICROPY_EMIT_THUMB
+#define NATIVE_EMITTER(f) emit_native_thumb_##f
+#elif MICROPY_EMIT_ARM
+#define NATIVE_EMITTER(f) emit_native_arm_##f
+#elif MICROPY_EMIT_XTENSA
+#define NATIVE_EMITTER(f) emit_native_xtensa_##f
+#elif MICROPY_EMIT_XTENSAWIN
+#define NATIVE_EMITTER(f) emit_native_xtensawin_##f
+#else
+#error "unknown native emitter"
+#endif
+#define NATIVE_EMITTER_TABLE (&NATIVE_EMITTER(method_table))
+
+// Labels below this are used by the native emitter's start_pass.
+#define JIT_FIRST_LABEL (6)
+
+// Whether each local may be unbound is tracked in a bitmask.
+#define JIT_MAX_LOCALS (32)
+
+typedef enum {
+    JIT_SCAN,       // find the end of the code and the jump targets, and check all opcodes are supported
+    JIT_ANALYSE,    // work out the stack depth and bound locals at each jump target
+    JIT_EMIT,       // call the native emitter
+} jit_mode_t;
+
+// The state of the abstract stack and locals at a point in the code.
+typedef struct _jit_state_t {
+    bool reachable;
+    uint16_t depth;
+    uint32_t assigned;
+} jit_state_t;
+
+typedef struct _jit_target_t {
+    uint32_t offset;
+    uint16_t label;     // label for jumps to this offset, or 0 if there are none
+    uint16_t for_label; // label for FOR_ITER exits to this offset, or 0 if there are none
+    jit_state_t in;
+    jit_state_t for_in; // state before the exhausted iterator is popped
+} jit_target_t;
+
+typedef struct _jit_t {
+    jit_mode_t mode;
+    emit_t *emit;
+    const mp_module_constants_t *cm;
+    const byte *code;
+    const byte *code_end;
+    jit_target_t *targets;
+    size_t n_targets;
+    size_t alloc_targets;
+    size_t max_target;
+    uint16_t next_label;
+    uint16_t n_locals;
+    size_t n_qstr;
+    size_t n_obj;
+    bool ref_globals;
+    bool changed;
+    jit_state_t entry;
+} jit_t;
+
+// Called on each backward jump, to do what the VM does on a branch.
+static mp_obj_t jit_loop_hook(void) {
+    MICROPY_VM_HOOK_LOOP
+    mp_handle_pending(true);
+    #if MICROPY_PY_THREAD_GIL
+    #if MICROPY_ENABLE_SCHEDULER
+    // can only switch threads if the scheduler is unlocked
+    if (MP_STATE_VM(sched_state) == MP_SCHED_IDLE)
+    #endif
+    {
+        MP_THREAD_GIL_EXIT();
+        MP_THREAD_GIL_ENTER();
+    }
+    #endif
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(jit_loop_hook_obj, jit_loop_hook);
+
+#define EMIT(fun) do { if (jit->emit != NULL) { NATIVE_EMITTER_TABLE->fun(jit->emit); } } while (0)
+#define EMIT_ARG(fun, ...) do { if (jit->emit != NULL) { NATIVE_EMITTER_TABLE->fun(jit->emit, __VA_ARGS__); } } while (0)
+
+static qstr jit_decode_qstr(jit_t *jit, const byte **ip) {
+    mp_uint_t n = mp_decode_uint(ip);
+    #if MICROPY_EMIT_BYTECODE_USES_QSTR_TABLE
+    if (n >= jit->n_qstr) {
+        jit->n_qstr = n + 1;
+    }
+    return jit->cm->qstr_table[n];
+    #else
+    (void)jit;
+    return n;
+    #endif
+}
+
+static const byte *jit_decode_ulabel(const byte **ip) {
+    const byte *p = *ip;
+    size_t ulab;
+    if (p[0] & 0x80) {
+        ulab = (p[0] & 0x7f) | (p[1] << 7);
+        p += 2;
+    } else {
+        ulab = p[0];
+        p += 1;
+    }
+    *ip = p;
+    return p + ulab;
+}
+
+static const byte *jit_decode_slabel(const byte **ip) {
+    const byte *p = *ip;
+    mp_int_t slab;
+    if (p[0] & 0x80) {
+        slab = ((p[0] & 0x7f) | (p[1] << 7)) - 0x4000;
+        p += 2;
+    } else {
+        slab = p[0] - 0x40;
+        p += 1;
+    }
+    *ip = p;
+    return p + slab;
+}
+
+static jit_target_t *jit_find_target(jit_t *jit, size_t offset) {
+    size_t lo = 0;
+    size_t hi = jit->n_targets;
+    while (lo < hi) {
+        size_t mid = (lo + hi) / 2;
+        if (jit->targets[mid].offset < offset) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    if (lo < jit->n_targets && jit->targets[lo].offset == offset) {
+        return &jit->targets[lo];
+    }
+    return NULL;
+}
+
+static void jit_add_target(jit_t *jit, size_t offset, bool is_for) {
+    jit_target_t *t = jit_find_target(jit, offset);
+    if (t == NULL) {
+        // keep the targets sorted by offset
+        if (jit->n_targets == jit->alloc_targets) {
+            jit->targets = m_renew(jit_target_t, jit->targets, jit->alloc_targets, jit->alloc_targets + 8);
+            jit->alloc_targets += 8;
+        }
+        size_t i = jit->n_targets++;
+        for (; i > 0 && jit->targets[i - 1].offset > offset; --i) {
+            jit->targets[i] = jit->targets[i - 1];
+        }
+        t = &jit->targets[i];
+        memset(t, 0, sizeof(*t));
+        t->offset = offset;
+    }
+    if (is_for) {
+        t->for_label = 1;
+    } else {
+        t->label = 1;
+    }
+}
+
+// Merge the state along an edge into the state at its destination.
+static bool jit_merge(jit_t *jit, jit_state_t *into, const jit_state_t *from) {
+    if (!from->reachable) {
+        return true;
+    }
+    if (!into->reachable) {
+        *into = *from;
+        jit->changed = true;
+        return true;
+    }
+    if (into->depth != from->depth) {
+        return false;
+    }
+    uint32_t assigned = into->assigned & from->assigned;
+    if (assigned != into->assigned) {
+        into->assigned = assigned;
+        jit->changed = true;
+    }
+    return true;
+}
+
+// Handle a jump from the current state to the given destination.
+static bool jit_jump(jit_t *jit, const jit_state_t *st, const byte *ip, const byte *dest, bool is_for) {
+    if (dest < jit->code) {
+        return false;
+    }
+    size_t offset = dest - jit->code;
+    if (jit->mode == JIT_SCAN) {
+        if (dest > ip && offset > jit->max_target) {
+            jit->max_target = offset;
+        }
+        jit_add_target(jit, offset, is_for);
+        return true;
+    }
+    jit_target_t *t = jit_find_target(jit, offset);
+    if (jit->mode == JIT_EMIT) {
+        if (dest <= ip) {
+            // Native code does not run the VM's pending exception checks, so
+            // backward jumps call out to the loop hook.
+            EMIT_ARG(load_const_obj, MP_OBJ_FROM_PTR(&jit_loop_hook_obj));
+            EMIT_ARG(call_function, 0, 0, 0);
+            EMIT(pop_top);
+        }
+        return true;
+    }
+    return jit_merge(jit, is_for ? &t->for_in : &t->in, st);
+}
+
+// Move to a new opcode at ip, which may be a jump target.
+static bool jit_enter(jit_t *jit, jit_state_t *st, const byte *ip, bool fallthrough) {
+    if (jit->mode == JIT_SCAN) {
+        return true;
+    }
+    jit_target_t *t = jit_find_target(jit, ip - jit->code);
+    if (t == NULL) {
+        if (!fallthrough) {
+            // Code after a return, raise or jump, which nothing jumps to.
+            st->reachable = false;
+        }
+        return true;
+    }
+    if (t->for_label) {
+        // The end of a for loop; the loop body always ends with a jump.
+        if (fallthrough) {
+            return false;
+        }
+        if (t->for_in.reachable) {
+            if (st->depth != t->for_in.depth) {
+                EMIT_ARG(adjust_stack_size, t->for_in.depth - st->depth);
+            }
+            *st = t->for_in;
+        } else {
+            st->reachable = false;
+        }
+        if (st->depth < MP_OBJ_ITER_BUF_NSLOTS) {
+            return false;
+        }
+        EMIT_ARG(label_assign, t->for_label);
+        EMIT(for_iter_end);
+        st->depth -= MP_OBJ_ITER_BUF_NSLOTS;
+        fallthrough = true;
+    }
+    if (t->label) {
+        if (fallthrough && !jit_merge(jit, &t->in, st)) {
+            return false;
+        }
+        if (t->in.reachable) {
+            if (st->depth != t->in.depth) {
+                EMIT_ARG(adjust_stack_size, t->in.depth - st->depth);
+            }
+            *st = t->in;
+        } else {
+            st->reachable = false;
+        }
+        EMIT_ARG(label_assign, t->label);
+    }
+    return true;
+}
+
+static bool jit_adjust(jit_t *jit, jit_state_t *st, int delta) {
+    if (jit->mode == JIT_SCAN) {
+        // The depth is not known until the jump targets are.
+        return true;
+    }
+    int depth = st->depth + delta;
+    if (depth < 0 || depth > 0xffff) {
+        return false;
+    }
+    st->depth = depth;
+    return true;
+}
+
+static bool jit_load_fast(jit_t *jit, jit_state_t *st, mp_uint_t local_num) {
+    if (local_num >= JIT_MAX_LOCALS) {
+        return false;
+    }
+    if (local_num >= jit->n_locals) {
+        jit->n_locals = local_num + 1;
+    }
+    if (jit->mode == JIT_ANALYSE && st->reachable && !(st->assigned & (1u << local_num))) {
+        // The local may be unbound here, which native code does not check for.
+        return false;
+    }
+    EMIT_ARG(load_id.local, MP_QSTRnull, local_num, MP_EMIT_IDOP_LOCAL_FAST);
+    return jit_adjust(jit, st, 1);
+}
+
+static bool jit_store_fast(jit_t *jit, jit_state_t *st, mp_uint_t local_num) {
+    if (local_num >= JIT_MAX_LOCALS) {
+        return false;
+    }
+    if (local_num >= jit->n_locals) {
+        jit->n_locals = local_num + 1;
+    }
+    st->assigned |= 1u << local_num;
+    EMIT_ARG(store_id.local, MP_QSTRnull, local_num, MP_EMIT_IDOP_LOCAL_FAST);
+    return jit_adjust(jit, st, -1);
+}
+
+static mp_int_t jit_fused_small_int(mp_uint_t arg) {
+    return (mp_int_t)((arg >> MP_BC_FUSED_ARG_BITS) & MP_BC_FUSED_ARG_MASK) - MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS;
+}
+
+// Walk over the bytecode, once in the given mode.
+static bool jit_walk(jit_t *jit, jit_mode_t mode) {
+    jit->mode = mode;
+    jit->changed = false;
+    jit_state_t st = jit->entry;
+    bool fallthrough = true;
+    const byte *ip = jit->code;
+    while (jit->code_end == NULL || ip < jit->code_end) {
+        if (!jit_enter(jit, &st, ip, fallthrough)) {
+            return false;
+        }
+        fallthrough = true;
+        const byte *op_ip = ip;
+        byte op = *ip++;
+        qstr qst = MP_QSTRnull;
+        if (MP_BC_FORMAT(op) == MP_BC_FORMAT_QSTR) {
+            qst = jit_decode_qstr(jit, &ip);
+        }
+        bool ok = true;
+        bool terminator = false;
+        switch (op) {
+            case MP_BC_LOAD_CONST_FALSE:
+                EMIT_ARG(load_const_tok, MP_TOKEN_KW_FALSE);
+                ok = jit_adjust(jit, &st, 1);
+                break;
+            case MP_BC_LOAD_CONST_NONE:
+                EMIT_ARG(load_const_tok, MP_TOKEN_KW_NONE);
+                ok = jit_adjust(jit, &st, 1);
+                break;
+            case MP_BC_LOAD_CONST_TRUE:
+                EMIT_ARG(load_const_tok, MP_TOKEN_KW_TRUE);
+                ok = jit_adjust(jit, &st, 1);
+                break;
+            case MP_BC_LOAD_CONST_SMALL_INT: {
+                mp_uint_t num = 0;
+                if ((ip[0] & 0x40) != 0) {
+                    // Number is negative
+                    num--;
+                }
+                do {
+                    num = (num << 7) | (*ip & 0x7f);
+                } while ((*ip++ & 0x80) != 0);
+                EMIT_ARG(load_const_small_int, num);
+                ok = jit_adjust(jit, &st, 1);
+                break;
+            }
+            case MP_BC_LOAD_CONST_STRING:
+                EMIT_ARG(load_const_str, qst);
+                ok = jit_adjust(jit, &st, 1);
+                break;
+            case MP_BC_LOAD_CONST_OBJ: {
+                mp_uint_t n = mp_decode_uint(&ip);
+                if (n >= jit->n_obj) {
+                    jit->n_obj = n + 1;
+                }
+                EMIT_ARG(load_const_obj, jit->cm->obj_table[n]);
+                ok = jit_adjust(jit, &st, 1);
+                break;
+            }
+            case MP_BC_LOAD_NULL:
+                EMIT(load_null);
+                ok = jit_adjust(jit, &st, 1);
+                break;
+            case MP_BC_LOAD_FAST_N:
+                ok = jit_load_fast(jit, &st, mp_decode_uint(&ip));
+                break;
+            case MP_BC_STORE_FAST_N:
+                ok = jit_store_fast(jit, &st, mp_decode_uint(&ip));
+                break;
+            case MP_BC_LOAD_GLOBAL:
+                jit->ref_globals = true;
+                EMIT_ARG(load_id.global, qst, MP_EMIT_IDOP_GLOBAL_GLOBAL);
+                ok = jit_adjust(jit, &st, 1);
+                break;
+            case MP_BC_STORE_GLOBAL:
+                jit->ref_globals = true;
+                EMIT_ARG(store_id.global, qst, MP_EMIT_IDOP_GLOBAL_GLOBAL);
+                ok = jit_adjust(jit, &st, -1);
+                break;
+            case MP_BC_DELETE_GLOBAL:
+                jit->ref_globals = true;
+                EMIT_ARG(delete_id.global, qst, MP_EMIT_IDOP_GLOBAL_GLOBAL);
+                break;
+            case MP_BC_LOAD_ATTR:
+                EMIT_ARG(attr, qst, MP_EMIT_ATTR_LOAD);
+                break;
+            case MP_BC_LOAD_METHOD:
+                EMIT_ARG(load_method, qst, false);
+                ok = jit_adjust(jit, &st, 1);
+                break;
+            case MP_BC_STORE_ATTR:
+                EMIT_ARG(attr, qst, MP_EMIT_ATTR_STORE);
+                ok = jit_adjust(jit, &st, -2);
+                break;
+            case MP_BC_LOAD_SUBSCR:
+                EMIT_ARG(subscr, MP_EMIT_SUBSCR_LOAD);
+                ok = jit_adjust(jit, &st, -1);
+                break;
+            case MP_BC_STORE_SUBSCR:
+                EMIT_ARG(subscr, MP_EMIT_SUBSCR_STORE);
+                ok = jit_adjust(jit, &st, -3);
+                break;
+            case MP_BC_DUP_TOP:
+                EMIT(dup_top);
+                ok = jit_adjust(jit, &st, 1);
+                break;
+            case MP_BC_DUP_TOP_TWO:
+                EMIT(dup_top_two);
+                ok = jit_adjust(jit, &st, 2);
+                break;
+            case MP_BC_POP_TOP:
+                EMIT(pop_top);
+                ok = jit_adjust(jit, &st, -1);
+                break;
+            case MP_BC_ROT_TWO:
+                EMIT(rot_two);
+                break;
+            case MP_BC_ROT_THREE:
+                EMIT(rot_three);
+                break;
+            case MP_BC_JUMP: {
+                const byte *dest = jit_decode_slabel(&ip);
+                ok = jit_jump(jit, &st, op_ip, dest, false);
+                if (jit->mode == JIT_EMIT) {
+                    EMIT_ARG(jump, jit_find_target(jit, dest - jit->code)->label);
+                }
+                terminator = true;
+                break;
+            }
+            case MP_BC_POP_JUMP_IF_TRUE:
+            case MP_BC_POP_JUMP_IF_FALSE: {
+                const byte *dest = jit_decode_slabel(&ip);
+                ok = jit_adjust(jit, &st, -1) && jit_jump(jit, &st, op_ip, dest, false);
+                if (jit->mode == JIT_EMIT) {
+                    EMIT_ARG(pop_jump_if, op == MP_BC_POP_JUMP_IF_TRUE, jit_find_target(jit, dest - jit->code)->label);
+                }
+                break;
+            }
+            case MP_BC_JUMP_IF_TRUE_OR_POP:
+            case MP_BC_JUMP_IF_FALSE_OR_POP: {
+                const byte *dest = jit_decode_ulabel(&ip);
+                ok = jit_jump(jit, &st, op_ip, dest, false) && jit_adjust(jit, &st, -1);
+                if (jit->mode == JIT_EMIT) {
+                    EMIT_ARG(jump_if_or_pop, op == MP_BC_JUMP_IF_TRUE_OR_POP, jit_find_target(jit, dest - jit->code)->label);
+                }
+                break;
+            }
+            case MP_BC_GET_ITER:
+                EMIT_ARG(get_iter, false);
+                break;
+            case MP_BC_GET_ITER_STACK:
+                EMIT_ARG(get_iter, true);
+                ok = jit_adjust(jit, &st, MP_OBJ_ITER_BUF_NSLOTS - 1);
+                break;
+            case MP_BC_FOR_ITER: {
+                const byte *dest = jit_decode_ulabel(&ip);
+                ok = (jit->mode == JIT_SCAN || st.depth >= MP_OBJ_ITER_BUF_NSLOTS) && jit_jump(jit, &st, op_ip, dest, true) && jit_adjust(jit, &st, 1);
+                if (jit->mode == JIT_EMIT) {
+                    EMIT_ARG(for_iter, jit_find_target(jit, dest - jit->code)->for_label);
+                }
+                break;
+            }
+            case MP_BC_BUILD_TUPLE:
+            case MP_BC_BUILD_LIST:
+            case MP_BC_BUILD_MAP:
+            case MP_BC_BUILD_SET:
+            case MP_BC_BUILD_SLICE: {
+                mp_uint_t n = mp_decode_uint(&ip);
+                int kind = op - MP_BC_BUILD_TUPLE;
+                EMIT_ARG(build, n, kind);
+                ok = jit_adjust(jit, &st, kind == MP_EMIT_BUILD_MAP ? 1 : 1 - (int)n);
+                break;
+            }
+            case MP_BC_STORE_MAP:
+                EMIT(store_map);
+                ok = jit_adjust(jit, &st, -2);
+                break;
+            case MP_BC_STORE_COMP: {
+                // the lower 2 bits of the argument indicate the collection type
+                mp_uint_t arg = mp_decode_uint(&ip);
+                mp_uint_t index = arg >> 2;
+                if ((arg & 3) == 1) {
+                    EMIT_ARG(store_comp, SCOPE_DICT_COMP, index - 1);
+                    ok = jit_adjust(jit, &st, -2);
+                } else {
+                    EMIT_ARG(store_comp, (arg & 3) == 0 ? SCOPE_LIST_COMP : SCOPE_SET_COMP, index);
+                    ok = jit_adjust(jit, &st, -1);
+                }
+                break;
+            }
+            case MP_BC_UNPACK_SEQUENCE: {
+                mp_uint_t n = mp_decode_uint(&ip);
+                EMIT_ARG(unpack_sequence, n);
+                ok = jit_adjust(jit, &st, (int)n - 1);
+                break;
+            }
+            case MP_BC_UNPACK_EX: {
+                mp_uint_t n = mp_decode_uint(&ip);
+                EMIT_ARG(unpack_ex, n & 0xff, n >> 8);
+                ok = jit_adjust(jit, &st, (n & 0xff) + (n >> 8));
+                break;
+            }
+            case MP_BC_CALL_FUNCTION:
+            case MP_BC_CALL_FUNCTION_VAR_KW:
+            case MP_BC_CALL_METHOD:
+            case MP_BC_CALL_METHOD_VAR_KW: {
+                mp_uint_t n = mp_decode_uint(&ip);
+                mp_uint_t n_pos = n & 0xff;
+                mp_uint_t n_kw = (n >> 8) & 0xff;
+                bool star = op == MP_BC_CALL_FUNCTION_VAR_KW || op == MP_BC_CALL_METHOD_VAR_KW;
+                mp_uint_t star_flags = star ? MP_EMIT_STAR_FLAG_SINGLE | MP_EMIT_STAR_FLAG_DOUBLE : 0;
+                int delta = -(int)(n_pos + 2 * n_kw) - star;
+                if (op == MP_BC_CALL_FUNCTION || op == MP_BC_CALL_FUNCTION_VAR_KW) {
+                    EMIT_ARG(call_function, n_pos, n_kw, star_flags);
+                } else {
+                    EMIT_ARG(call_method, n_pos, n_kw, star_flags);
+                    delta -= 1;
+                }
+                ok = jit_adjust(jit, &st, delta);
+                break;
+            }
+            case MP_BC_RETURN_VALUE:
+                EMIT(return_value);
+                ok = jit_adjust(jit, &st, -1);
+                terminator = true;
+                break;
+            case MP_BC_RAISE_OBJ:
+                EMIT_ARG(raise_varargs, 1);
+                ok = jit_adjust(jit, &st, -1);
+                terminator = true;
+                break;
+
+            // CIRCUITPY-CHANGE: fused opcodes are split back into their parts
+            case MP_BC_LOAD_FAST0_ATTR:
+                ok = jit_load_fast(jit, &st, 0);
+                EMIT_ARG(attr, qst, MP_EMIT_ATTR_LOAD);
+                break;
+            case MP_BC_LOAD_FAST0_METHOD:
+                ok = jit_load_fast(jit, &st, 0) && jit_adjust(jit, &st, 1);
+                EMIT_ARG(load_method, qst, false);
+                break;
+            case MP_BC_STORE_FAST0_ATTR:
+                ok = jit_load_fast(jit, &st, 0) && jit_adjust(jit, &st, -2);
+                EMIT_ARG(attr, qst, MP_EMIT_ATTR_STORE);
+                break;
+            case MP_BC_BINARY_OP_SMALL_INT: {
+                mp_uint_t arg = mp_decode_uint(&ip);
+                EMIT_ARG(load_const_small_int, jit_fused_small_int(arg));
+                EMIT_ARG(binary_op, arg & MP_BC_FUSED_ARG_MASK);
+                break;
+            }
+            case MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT: {
+                mp_uint_t arg = mp_decode_uint(&ip);
+                ok = jit_load_fast(jit, &st, arg >> (2 * MP_BC_FUSED_ARG_BITS));
+                EMIT_ARG(load_const_small_int, jit_fused_small_int(arg));
+                EMIT_ARG(binary_op, arg & MP_BC_FUSED_ARG_MASK);
+                break;
+            }
+            case MP_BC_BINARY_OP_POP_JUMP_IF: {
+                const byte *dest = jit_decode_slabel(&ip);
+                mp_uint_t arg = *ip++;
+                EMIT_ARG(binary_op, arg & ~MP_BC_BINARY_OP_POP_JUMP_IF_TRUE);
+                ok = jit_adjust(jit, &st, -2) && jit_jump(jit, &st, op_ip, dest, false);
+                if (jit->mode == JIT_EMIT) {
+                    EMIT_ARG(pop_jump_if, (arg & MP_BC_BINARY_OP_POP_JUMP_IF_TRUE) != 0, jit_find_target(jit, dest - jit->code)->label);
+                }
+                break;
+            }
+
+            default:
+                if (op >= MP_BC_LOAD_CONST_SMALL_INT_MULTI && op < MP_BC_LOAD_CONST_SMALL_INT_MULTI + MP_BC_LOAD_CONST_SMALL_INT_MULTI_NUM) {
+                    EMIT_ARG(load_const_small_int, (mp_int_t)op - MP_BC_LOAD_CONST_SMALL_INT_MULTI - MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS);
+                    ok = jit_adjust(jit, &st, 1);
+                } else if (op >= MP_BC_LOAD_FAST_MULTI && op < MP_BC_LOAD_FAST_MULTI + MP_BC_LOAD_FAST_MULTI_NUM) {
+                    ok = jit_load_fast(jit, &st, op - MP_BC_LOAD_FAST_MULTI);
+                } else if (op >= MP_BC_STORE_FAST_MULTI && op < MP_BC_STORE_FAST_MULTI + MP_BC_STORE_FAST_MULTI_NUM) {
+                    ok = jit_store_fast(jit, &st, op - MP_BC_STORE_FAST_MULTI);
+                } else if (op >= MP_BC_UNARY_OP_MULTI && op < MP_BC_UNARY_OP_MULTI + MP_BC_UNARY_OP_MULTI_NUM) {
+                    EMIT_ARG(unary_op, op - MP_BC_UNARY_OP_MULTI);
+                } else if (op >= MP_BC_BINARY_OP_MULTI && op < MP_BC_BINARY_OP_MULTI + MP_BC_BINARY_OP_MULTI_NUM) {
+                    EMIT_ARG(binary_op, op - MP_BC_BINARY_OP_MULTI);
+                    ok = jit_adjust(jit, &st, -1);
+                } else {
+                    // Not supported by the JIT tier.
+                    ok = false;
+                }
+                break;
+        }
+        if (!ok) {
+            return false;
+        }
+        if (terminator) {
+            fallthrough = false;
+            if (jit->mode == JIT_SCAN && ip > jit->code + jit->max_target) {
+                // Nothing jumps past here, so this is the end of the function.
+                jit->code_end = ip;
+            }
+        }
+    }
+    // Code that returns never falls off the end with values left on the stack.
+    return jit->mode == JIT_SCAN || st.depth == 0 || !st.reachable;
+}
+
+static mp_raw_code_jit_t *jit_translate(jit_t *jit, const mp_module_context_t *context, scope_t *scope) {
+    // Find the code and its jump targets, then allocate labels to them.
+    if (!jit_walk(jit, JIT_SCAN) || jit->n_locals > JIT_MAX_LOCALS) {
+        return NULL;
+    }
+    jit->next_label = JIT_FIRST_LABEL;
+    for (size_t i = 0; i < jit->n_targets; ++i) {
+        jit_target_t *t = &jit->targets[i];
+        if (t->label) {
+            t->label = jit->next_label++;
+        }
+        if (t->for_label) {
+            t->for_label = jit->next_label++;
+        }
+    }
+
+    // Iterate the analysis until the state at each jump target settles.
+    do {
+        if (!jit_walk(jit, JIT_ANALYSE)) {
+            return NULL;
+        }
+    } while (jit->changed);
+
+    scope->num_locals = MAX(scope->num_locals, jit->n_locals);
+    if (jit->ref_globals) {
+        scope->scope_flags |= MP_SCOPE_FLAG_REFGLOBALS;
+    }
+
+    // Set up the constant tables so that the ones used by the bytecode come
+    // first at the same indices, and can still be used by running bytecode.
+    mp_emit_common_t emit_common;
+    memset(&emit_common, 0, sizeof(emit_common));
+    #if MICROPY_EMIT_BYTECODE_USES_QSTR_TABLE
+    mp_map_init(&emit_common.qstr_map, jit->n_qstr);
+    for (size_t i = 0; i < jit->n_qstr; ++i) {
+        mp_map_elem_t *elem = mp_map_lookup(&emit_common.qstr_map, MP_OBJ_NEW_QSTR(context->constants.qstr_table[i]), MP_MAP_LOOKUP_ADD_IF_NOT_FOUND);
+        if (elem->value != MP_OBJ_NULL) {
+            return NULL;
+        }
+        elem->value = MP_OBJ_NEW_SMALL_INT(i);
+    }
+    #endif
+    mp_obj_list_init(&emit_common.const_obj_list, 0);
+    for (size_t i = 0; i < jit->n_obj; ++i) {
+        mp_obj_list_append(MP_OBJ_FROM_PTR(&emit_common.const_obj_list), context->constants.obj_table[i]);
+    }
+
+    mp_obj_t error = MP_OBJ_NULL;
+    uint label_slot = 0;
+    emit_t *emit = NATIVE_EMITTER(new)(&emit_common, &error, &label_slot, jit->next_label);
+    jit->emit = emit;
+    for (pass_kind_t pass = MP_PASS_STACK_SIZE; pass <= MP_PASS_EMIT && error == MP_OBJ_NULL;) {
+        emit_common.pass = pass;
+        emit_common.ct_cur_child = 0;
+        emit_common.children = NULL;
+        NATIVE_EMITTER_TABLE->start_pass(emit, pass, scope);
+        jit_walk(jit, JIT_EMIT);
+        // the emitter can request multiple emit passes
+        if (NATIVE_EMITTER_TABLE->end_pass(emit) || pass != MP_PASS_EMIT) {
+            ++pass;
+        }
+    }
+    NATIVE_EMITTER(free)(emit);
+    jit->emit = NULL;
+    if (error != MP_OBJ_NULL) {
+        return NULL;
+    }
+
+    // Build the module context for the native code, as the compiler does.
+    mp_module_context_t *native_context = m_new_obj(mp_module_context_t);
+    native_context->module = context->module;
+    #if MICROPY_EMIT_BYTECODE_USES_QSTR_TABLE
+    mp_module_context_alloc_tables(native_context, emit_common.qstr_map.used, emit_common.const_obj_list.len);
+    for (size_t i = 0; i < emit_common.qstr_map.alloc; ++i) {
+        if (mp_map_slot_is_filled(&emit_common.qstr_map, i)) {
+            size_t idx = MP_OBJ_SMALL_INT_VALUE(emit_common.qstr_map.table[i].value);
+            native_context->constants.qstr_table[idx] = MP_OBJ_QSTR_VALUE(emit_common.qstr_map.table[i].key);
+        }
+    }
+    mp_map_deinit(&emit_common.qstr_map);
+    #else
+    mp_module_context_alloc_tables(native_context, 0, emit_common.const_obj_list.len);
+    native_context->constants.source_file = context->constants.source_file;
+    #endif
+    for (size_t i = 0; i < emit_common.const_obj_list.len; ++i) {
+        native_context->constants.obj_table[i] = emit_common.const_obj_list.items[i];
+    }
+
+    mp_raw_code_jit_t *native = m_new_obj(mp_raw_code_jit_t);
+    native->fun_data = scope->raw_code->fun_data;
+    native->children = scope->raw_code->children;
+    native->context_in = context;
+    native->context = native_context;
+    return native;
+}
+
+static mp_raw_code_jit_t *jit_compile(const mp_raw_code_t *rc, const mp_module_context_t *context) {
+    const byte *ip = rc->fun_data;
+    MP_BC_PRELUDE_SIG_DECODE(ip);
+    MP_BC_PRELUDE_SIZE_DECODE(ip);
+    if (n_exc_stack != 0 || n_cell != 0 || (scope_flags & (MP_SCOPE_FLAG_GENERATOR | MP_SCOPE_FLAG_ASYNC))) {
+        return NULL;
+    }
+    size_t n_args = n_pos_args + n_kwonly_args
+        + ((scope_flags & MP_SCOPE_FLAG_VARARGS) != 0)
+        + ((scope_flags & MP_SCOPE_FLAG_VARKEYWORDS) != 0);
+    if (n_args > JIT_MAX_LOCALS) {
+        return NULL;
+    }
+
+    jit_t jit;
+    memset(&jit, 0, sizeof(jit));
+    jit.cm = &context->constants;
+    jit.code = ip + n_info + n_cell;
+    // The source file is qstr 0, and the code info holds the function and argument names.
+    jit.n_qstr = 1;
+    jit.n_locals = n_args;
+    jit.entry.reachable = true;
+    jit.entry.assigned = n_args == JIT_MAX_LOCALS ? 0xffffffff : (1u << n_args) - 1;
+
+    // A scope for the native emitter, with just what it needs for a function.
+    scope_t scope;
+    memset(&scope, 0, sizeof(scope));
+    scope.kind = SCOPE_FUNCTION;
+    scope.emit_options = MP_EMIT_OPT_NATIVE_PYTHON;
+    scope.scope_flags = scope_flags;
+    scope.num_pos_args = n_pos_args;
+    scope.num_kwonly_args = n_kwonly_args;
+    scope.num_def_pos_args = n_def_pos_args;
+    scope.num_locals = n_args;
+    scope.id_info_len = n_pos_args + n_kwonly_args;
+    scope.id_info = m_new(id_info_t, scope.id_info_len);
+    scope.simple_name = jit_decode_qstr(&jit, &ip);
+    for (size_t i = 0; i < scope.id_info_len; ++i) {
+        id_info_t *id = &scope.id_info[i];
+        id->kind = ID_INFO_KIND_LOCAL;
+        id->flags = ID_FLAG_IS_PARAM;
+        id->local_num = i;
+        id->qst = jit_decode_qstr(&jit, &ip);
+    }
+    scope.raw_code = mp_emit_glue_new_raw_code();
+
+    mp_raw_code_jit_t *native = NULL;
+    nlr_buf_t nlr;
+    if (nlr_push(&nlr) == 0) {
+        native = jit_translate(&jit, context, &scope);
+        nlr_pop();
+    }
+    // Otherwise the translation raised, most likely from running out of memory.
+
+    m_del(jit_target_t, jit.targets, jit.alloc_targets);
+    m_del(id_info_t, scope.id_info, scope.id_info_len);
+    return native;
+}
+
+bool mp_emit_jit_call(mp_obj_fun_bc_t *fun) {
+    mp_raw_code_t *rc = (mp_raw_code_t *)fun->rc;
+    mp_raw_code_jit_t *native = rc->jit;
+    if (native == NULL) {
+        uint16_t threshold = MP_STATE_VM(jit_threshold);
+        if (rc->jit_calls == 0 || threshold == 0 || rc->jit_calls++ < threshold) {
+            return false;
+        }
+        #if MICROPY_PY_SYS_SETTRACE
+        if (MP_STATE_THREAD(prof_trace_callback) != MP_OBJ_NULL) {
+            return false;
+        }
+        #endif
+        // Compiling allocates, so wait for a call made with the heap unlocked.
+        if (gc_is_locked()) {
+            return false;
+        }
+        // Only try once, whether or not it works.
+        rc->jit_calls = 0;
+        native = jit_compile(rc, fun->context);
+        if (native == NULL) {
+            return false;
+        }
+        rc->jit = native;
+        MP_STATE_VM(jit_count)++;
+    }
+
+    // The native code can only run with the context it was compiled against,
+    // and that context's globals may be changed by exec().
+    if (fun->context != native->context_in
+        || fun->context->module.globals != native->context->module.globals) {
+        return false;
+    }
+
+    // Switch the function over to the native code.  Frames of it that are
+    // still running bytecode keep working, because the new context's tables
+    // extend the original ones.
+    fun->base.type = &mp_type_fun_native;
+    fun->bytecode = native->fun_data;
+    fun->child_table = native->children;
+    fun->context = native->context;
+    return true;
+}
+
+#endif // MICROPY_EMIT_NATIVE_JIT
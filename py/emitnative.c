@@ -174,6 +174,8 @@
 #define LOCAL_IDX_OLD_GLOBALS(emit) ((emit)->code_state_start + OFFSETOF_CODE_STATE_IP)
 #define LOCAL_IDX_GEN_PC(emit) ((emit)->code_state_start + OFFSETOF_CODE_STATE_IP)
 #define LOCAL_IDX_LOCAL_VAR(emit, local_num) ((emit)->stack_start + (emit)->n_state - 1 - (local_num))
+// CIRCUITPY-CHANGE: descriptors of viper buf arguments, between the Python stack and the locals
+#define LOCAL_IDX_BUF(emit, buf_num) ((emit)->stack_start + (emit)->scope->stack_size + MP_NATIVE_BUF_WORDS * (buf_num))
 
 #if MICROPY_PERSISTENT_CODE_SAVE
 
@@ -225,13 +227,22 @@ typedef enum {
     VTYPE_PTR8 = 0x00 | MP_NATIVE_TYPE_PTR8,
     VTYPE_PTR16 = 0x00 | MP_NATIVE_TYPE_PTR16,
     VTYPE_PTR32 = 0x00 | MP_NATIVE_TYPE_PTR32,
+    // CIRCUITPY-CHANGE: bounds-checked buffers; the value is the address of a descriptor
+    VTYPE_BUF8 = 0x00 | MP_NATIVE_TYPE_BUF8,
+    VTYPE_BUF16 = 0x00 | MP_NATIVE_TYPE_BUF16,
+    VTYPE_BUF32 = 0x00 | MP_NATIVE_TYPE_BUF32,
 
     VTYPE_PTR_NONE = 0x50 | MP_NATIVE_TYPE_PTR,
 
     VTYPE_UNBOUND = 0x60 | MP_NATIVE_TYPE_OBJ,
     VTYPE_BUILTIN_CAST = 0x70 | MP_NATIVE_TYPE_OBJ,
+    // CIRCUITPY-CHANGE
+    VTYPE_BUILTIN_PTR_OP = 0x80 | MP_NATIVE_TYPE_OBJ,
 } vtype_kind_t;
 
+// CIRCUITPY-CHANGE
+#define VTYPE_IS_BUF(vtype) ((vtype) >= VTYPE_BUF8 && (vtype) <= VTYPE_BUF32)
+
 static qstr vtype_to_qstr(vtype_kind_t vtype) {
     switch (vtype) {
         case VTYPE_PYOBJ:
@@ -250,6 +261,13 @@ static qstr vtype_to_qstr(vtype_kind_t vtype) {
             return MP_QSTR_ptr16;
         case VTYPE_PTR32:
             return MP_QSTR_ptr32;
+        // CIRCUITPY-CHANGE
+        case VTYPE_BUF8:
+            return MP_QSTR_buf8;
+        case VTYPE_BUF16:
+            return MP_QSTR_buf16;
+        case VTYPE_BUF32:
+            return MP_QSTR_buf32;
         case VTYPE_PTR_NONE:
         default:
             return MP_QSTR_None;
@@ -280,6 +298,9 @@ struct _emit_t {
     mp_obj_t *error_slot;
     uint *label_slot;
     uint exit_label;
+    // CIRCUITPY-CHANGE: where failed buf bounds checks jump to, if any were emitted
+    uint buf_index_error_label;
+    bool buf_index_error_used;
     int pass;
 
     bool do_viper_types;
@@ -398,6 +419,9 @@ static void emit_native_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scop
     emit->do_viper_types = scope->emit_options == MP_EMIT_OPT_VIPER;
     emit->stack_size = 0;
     emit->scope = scope;
+    // CIRCUITPY-CHANGE
+    emit->buf_index_error_label = *emit->label_slot + 6;
+    emit->buf_index_error_used = false;
 
     // allocate memory for keeping track of the types of locals
     if (emit->local_vtype_alloc < scope->num_locals) {
@@ -459,6 +483,12 @@ static void emit_native_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scop
         // Work out size of state (locals plus stack)
         // n_state counts all stack and locals, even those in registers
         emit->n_state = scope->num_locals + scope->stack_size;
+        // CIRCUITPY-CHANGE: plus the descriptors of buf arguments
+        for (int i = 0; i < emit->scope->num_pos_args; i++) {
+            if (VTYPE_IS_BUF(emit->local_vtype[i])) {
+                emit->n_state += MP_NATIVE_BUF_WORDS;
+            }
+        }
         int num_locals_in_regs = 0;
         if (CAN_USE_REGS_FOR_LOCALS(emit)) {
             num_locals_in_regs = scope->num_locals;
@@ -523,10 +553,16 @@ static void emit_native_start_pass(emit_t *emit, pass_kind_t pass, scope_t *scop
         mp_asm_base_label_assign(&emit->as->base, *emit->label_slot + 5);
 
         // Store arguments into locals (reg or stack), converting to native if needed
+        int num_bufs = 0;
         for (int i = 0; i < emit->scope->num_pos_args; i++) {
             int r = REG_ARG_1;
             ASM_LOAD_REG_REG_OFFSET(emit->as, REG_ARG_1, REG_LOCAL_LAST, i);
-            if (emit->local_vtype[i] != VTYPE_PYOBJ) {
+            // CIRCUITPY-CHANGE: a buf argument becomes the address of its filled-in descriptor
+            if (VTYPE_IS_BUF(emit->local_vtype[i])) {
+                emit_native_mov_reg_state_addr(emit, REG_ARG_3, LOCAL_IDX_BUF(emit, num_bufs++));
+                emit_call_with_imm_arg(emit, MP_F_NATIVE_BUF_FROM_OBJ, emit->local_vtype[i], REG_ARG_2);
+                r = REG_RET;
+            } else if (emit->local_vtype[i] != VTYPE_PYOBJ) {
                 emit_call_with_imm_arg(emit, MP_F_CONVERT_OBJ_TO_NATIVE, emit->local_vtype[i], REG_ARG_2);
                 r = REG_RET;
             }
@@ -665,6 +701,12 @@ static inline void emit_native_write_code_info_qstr(emit_t *emit, qstr qst) {
 static bool emit_native_end_pass(emit_t *emit) {
     emit_native_global_exc_exit(emit);
 
+    // CIRCUITPY-CHANGE: shared target of the buf index checks
+    if (emit->buf_index_error_used) {
+        mp_asm_base_label_assign(&emit->as->base, emit->buf_index_error_label);
+        ASM_CALL_IND(emit->as, MP_F_NATIVE_RAISE_BUF_INDEX);
+    }
+
     if (!emit->do_viper_types) {
         emit->prelude_offset = mp_asm_base_get_code_pos(&emit->as->base);
         emit->prelude_ptr_index = emit->emit_common->ct_cur_child;
@@ -1464,6 +1506,12 @@ static void emit_native_load_global(emit_t *emit, qstr qst, int kind) {
                 emit_post_push_imm(emit, VTYPE_BUILTIN_CAST, native_type);
                 return;
             }
+            // CIRCUITPY-CHANGE: check for builtin pointer reductions
+            int ptr_op = mp_native_ptr_op_from_qstr(qst);
+            if (ptr_op >= 0) {
+                emit_post_push_imm(emit, VTYPE_BUILTIN_PTR_OP, ptr_op);
+                return;
+            }
         }
     }
     emit_call_with_qstr_arg(emit, MP_F_LOAD_NAME + kind, qst, REG_ARG_1);
@@ -1502,6 +1550,37 @@ static void emit_native_load_build_class(emit_t *emit) {
     emit_post_push_reg(emit, VTYPE_PYOBJ, REG_RET);
 }
 
+// CIRCUITPY-CHANGE: check an index in reg_index against the length of the buf that
+// reg_buf points to, then replace reg_buf with the address of the buf's items.
+// Indices are compared unsigned, so negative ones are out of range as well.
+// reg_temp is clobbered, and all three registers must be different.
+static void emit_native_buf_check_index(emit_t *emit, int reg_buf, int reg_index, int reg_temp) {
+    mp_uint_t label = emit->buf_index_error_label;
+    emit->buf_index_error_used = true;
+    ASM_LOAD_REG_REG_OFFSET(emit->as, reg_temp, reg_buf, MP_NATIVE_BUF_LEN);
+    // jump to label if reg_index >= reg_temp
+    #if N_X64
+    asm_x64_cmp_r64_with_r64(emit->as, reg_temp, reg_index);
+    asm_x64_jcc_label(emit->as, ASM_X64_CC_JAE, label);
+    #elif N_X86
+    asm_x86_cmp_r32_with_r32(emit->as, reg_temp, reg_index);
+    asm_x86_jcc_label(emit->as, ASM_X86_CC_JAE, label);
+    #elif N_THUMB
+    asm_thumb_cmp_rlo_rlo(emit->as, reg_index, reg_temp);
+    asm_thumb_bcc_label(emit->as, ASM_THUMB_CC_CS, label);
+    #elif N_ARM
+    asm_arm_cmp_reg_reg(emit->as, reg_index, reg_temp);
+    asm_arm_bcc_label(emit->as, ASM_ARM_CC_CS, label);
+    #elif N_XTENSA || N_XTENSAWIN
+    // bcc only reaches 8 bits, so branch over a jump when the index is in range
+    asm_xtensa_op_bcc(emit->as, ASM_XTENSA_CC_LTU, reg_index, reg_temp, 2);
+    asm_xtensa_j_label(emit->as, label);
+    #else
+    #error not implemented
+    #endif
+    ASM_LOAD_REG_REG_OFFSET(emit->as, reg_buf, reg_buf, MP_NATIVE_BUF_ITEMS);
+}
+
 static void emit_native_load_subscr(emit_t *emit) {
     DEBUG_printf("load_subscr\n");
     // need to compile: base[index]
@@ -1530,7 +1609,8 @@ static void emit_native_load_subscr(emit_t *emit) {
         // capabilities and requirements for loads, so probably best to
         // write a completely separate load-optimiser for each one.
         stack_info_t *top = peek_stack(emit, 0);
-        if (top->vtype == VTYPE_INT && top->kind == STACK_IMM) {
+        // CIRCUITPY-CHANGE: a buf index is always checked in a register
+        if (top->vtype == VTYPE_INT && top->kind == STACK_IMM && !VTYPE_IS_BUF(vtype_base)) {
             // index is an immediate
             mp_int_t index_value = top->data.u_imm;
             emit_pre_pop_discard(emit); // discard index
@@ -1602,23 +1682,47 @@ static void emit_native_load_subscr(emit_t *emit) {
             // index is not an immediate
             vtype_kind_t vtype_index;
             int reg_index = REG_ARG_2;
-            emit_pre_pop_reg_flexible(emit, &vtype_index, &reg_index, REG_ARG_1, REG_ARG_1);
+            // CIRCUITPY-CHANGE: keep REG_ARG_3 free for the length of a buf
+            emit_pre_pop_reg_flexible(emit, &vtype_index, &reg_index, REG_ARG_1, VTYPE_IS_BUF(vtype_base) ? REG_ARG_3 : REG_ARG_1);
             emit_pre_pop_reg(emit, &vtype_base, REG_ARG_1);
             need_reg_single(emit, REG_RET, 0);
             if (vtype_index != VTYPE_INT && vtype_index != VTYPE_UINT) {
                 EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
                     MP_ERROR_TEXT("can't load with '%q' index"), vtype_to_qstr(vtype_index));
             }
+            // CIRCUITPY-CHANGE: a ptr8/16/32 value is only an address, so its loads are
+            // unchecked. A buf8/16/32 value carries the length too, and is checked here
+            // before the same load as the matching ptr type.
+            if (VTYPE_IS_BUF(vtype_base)) {
+                need_reg_single(emit, REG_ARG_3, 0);
+                emit_native_buf_check_index(emit, REG_ARG_1, reg_index, REG_ARG_3);
+                vtype_base = VTYPE_PTR8 + (vtype_base - VTYPE_BUF8);
+            }
             switch (vtype_base) {
                 case VTYPE_PTR8: {
                     // pointer to 8-bit memory
-                    // TODO optimise to use thumb ldrb r1, [r2, r3]
+                    // CIRCUITPY-CHANGE: scaled register index
+                    #if N_THUMB
+                    asm_thumb_ldrb_reg_reg_reg(emit->as, REG_RET, REG_ARG_1, reg_index);
+                    break;
+                    #elif N_X64
+                    asm_x64_mov_mem8_to_r64zx_index(emit->as, REG_ARG_1, reg_index, REG_RET);
+                    break;
+                    #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_LOAD8_REG_REG(emit->as, REG_RET, REG_ARG_1); // store value to (base+index)
                     break;
                 }
                 case VTYPE_PTR16: {
                     // pointer to 16-bit memory
+                    // CIRCUITPY-CHANGE: scaled register index
+                    #if N_THUMB
+                    asm_thumb_ldrh_reg_reg_reg(emit->as, REG_RET, REG_ARG_1, reg_index);
+                    break;
+                    #elif N_X64
+                    asm_x64_mov_mem16_to_r64zx_index(emit->as, REG_ARG_1, reg_index, REG_RET);
+                    break;
+                    #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_LOAD16_REG_REG(emit->as, REG_RET, REG_ARG_1); // load from (base+2*index)
@@ -1626,6 +1730,14 @@ static void emit_native_load_subscr(emit_t *emit) {
                 }
                 case VTYPE_PTR32: {
                     // pointer to word-size memory
+                    // CIRCUITPY-CHANGE: scaled register index
+                    #if N_THUMB
+                    asm_thumb_ldr_reg_reg_reg(emit->as, REG_RET, REG_ARG_1, reg_index);
+                    break;
+                    #elif N_X64
+                    asm_x64_mov_mem32_to_r64zx_index(emit->as, REG_ARG_1, reg_index, REG_RET);
+                    break;
+                    #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
@@ -1751,7 +1863,8 @@ static void emit_native_store_subscr(emit_t *emit) {
         // capabilities and requirements for stores, so probably best to
         // write a completely separate store-optimiser for each one.
         stack_info_t *top = peek_stack(emit, 0);
-        if (top->vtype == VTYPE_INT && top->kind == STACK_IMM) {
+        // CIRCUITPY-CHANGE: a buf index is always checked in a register
+        if (top->vtype == VTYPE_INT && top->kind == STACK_IMM && !VTYPE_IS_BUF(vtype_base)) {
             // index is an immediate
             mp_int_t index_value = top->data.u_imm;
             emit_pre_pop_discard(emit); // discard index
@@ -1847,6 +1960,12 @@ static void emit_native_store_subscr(emit_t *emit) {
                 EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
                     MP_ERROR_TEXT("can't store with '%q' index"), vtype_to_qstr(vtype_index));
             }
+            // CIRCUITPY-CHANGE: check a buf index before the value takes REG_ARG_3
+            if (VTYPE_IS_BUF(vtype_base)) {
+                need_reg_single(emit, REG_ARG_3, 0);
+                emit_native_buf_check_index(emit, REG_ARG_1, reg_index, REG_ARG_3);
+                vtype_base = VTYPE_PTR8 + (vtype_base - VTYPE_BUF8);
+            }
             #if N_X64 || N_X86
             // special case: x86 needs byte stores to be from lower 4 regs (REG_ARG_3 is EDX)
             emit_pre_pop_reg(emit, &vtype_value, reg_value);
@@ -1860,10 +1979,16 @@ static void emit_native_store_subscr(emit_t *emit) {
             switch (vtype_base) {
                 case VTYPE_PTR8: {
                     // pointer to 8-bit memory
-                    // TODO optimise to use thumb strb r1, [r2, r3]
                     #if N_ARM
                     asm_arm_strb_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
                     break;
+                    // CIRCUITPY-CHANGE: scaled register index
+                    #elif N_THUMB
+                    asm_thumb_strb_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
+                    break;
+                    #elif N_X64
+                    asm_x64_mov_r8_to_mem8_index(emit->as, reg_value, REG_ARG_1, reg_index);
+                    break;
                     #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_STORE8_REG_REG(emit->as, reg_value, REG_ARG_1); // store value to (base+index)
@@ -1874,6 +1999,13 @@ static void emit_native_store_subscr(emit_t *emit) {
                     #if N_ARM
                     asm_arm_strh_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
                     break;
+                    // CIRCUITPY-CHANGE: scaled register index
+                    #elif N_THUMB
+                    asm_thumb_strh_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
+                    break;
+                    #elif N_X64
+                    asm_x64_mov_r16_to_mem16_index(emit->as, reg_value, REG_ARG_1, reg_index);
+                    break;
                     #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
@@ -1885,6 +2017,13 @@ static void emit_native_store_subscr(emit_t *emit) {
                     #if N_ARM
                     asm_arm_str_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
                     break;
+                    // CIRCUITPY-CHANGE: scaled register index
+                    #elif N_THUMB
+                    asm_thumb_str_reg_reg_reg(emit->as, reg_value, REG_ARG_1, reg_index);
+                    break;
+                    #elif N_X64
+                    asm_x64_mov_r32_to_mem32_index(emit->as, reg_value, REG_ARG_1, reg_index);
+                    break;
                     #endif
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
                     ASM_ADD_REG_REG(emit->as, REG_ARG_1, reg_index); // add index to base
@@ -2750,6 +2889,11 @@ static void emit_native_call_function(emit_t *emit, mp_uint_t n_positional, mp_u
         assert(!star_flags);
         DEBUG_printf("  cast to %d\n", vtype_fun);
         vtype_kind_t vtype_cast = peek_stack(emit, 1)->data.u_imm;
+        // CIRCUITPY-CHANGE: a buf only comes from an argument, never from a cast
+        if (VTYPE_IS_BUF(vtype_cast)) {
+            EMIT_NATIVE_VIPER_TYPE_ERROR(emit, MP_ERROR_TEXT("casting"));
+            vtype_cast = VTYPE_PYOBJ;
+        }
         switch (peek_vtype(emit, 0)) {
             case VTYPE_PYOBJ: {
                 vtype_kind_t vtype;
@@ -2770,10 +2914,65 @@ static void emit_native_call_function(emit_t *emit, mp_uint_t n_positional, mp_u
                 emit_fold_stack_top(emit, REG_ARG_1);
                 emit_post_top_set_vtype(emit, vtype_cast);
                 break;
+            // CIRCUITPY-CHANGE: casting a buf gives the address of its items
+            case VTYPE_BUF8:
+            case VTYPE_BUF16:
+            case VTYPE_BUF32: {
+                vtype_kind_t vtype;
+                emit_pre_pop_reg(emit, &vtype, REG_ARG_1);
+                emit_pre_pop_discard(emit);
+                ASM_LOAD_REG_REG_OFFSET(emit->as, REG_ARG_1, REG_ARG_1, MP_NATIVE_BUF_ITEMS);
+                emit_post_push_reg(emit, vtype_cast, REG_ARG_1);
+                break;
+            }
             default:
                 // this can happen when casting a cast: int(int)
                 mp_raise_NotImplementedError(MP_ERROR_TEXT("casting"));
         }
+    // CIRCUITPY-CHANGE: ptr_sum(p, n), ptr_min(p, n), ptr_max(p, n), ptr_clamp(p, n, lo, hi)
+    } else if (vtype_fun == VTYPE_BUILTIN_PTR_OP) {
+        static const qstr ptr_op_names[] = {
+            MP_QSTR_ptr_sum, MP_QSTR_ptr_min, MP_QSTR_ptr_max, MP_QSTR_ptr_clamp,
+        };
+        MP_STATIC_ASSERT(offsetof(mp_fun_table_t, native_ptr_reduce) == MP_F_NATIVE_PTR_REDUCE * sizeof(void *));
+        MP_STATIC_ASSERT(offsetof(mp_fun_table_t, native_ptr_clamp) == MP_F_NATIVE_PTR_CLAMP * sizeof(void *));
+        mp_uint_t op = peek_stack(emit, n_positional + 2 * n_keyword)->data.u_imm;
+        mp_uint_t n_args = op == MP_NATIVE_PTR_CLAMP ? 4 : 2;
+        if (n_positional != n_args || n_keyword != 0 || star_flags) {
+            EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
+                MP_ERROR_TEXT("%q() takes %d positional arguments but %d were given"),
+                ptr_op_names[op], (int)n_args, (int)n_positional);
+            // keep the stack balanced so that compilation can carry on
+            emit_native_adjust_stack_size(emit, -(mp_int_t)(n_positional + 2 * n_keyword + 1));
+            emit_post_push_imm(emit, VTYPE_UINT, 0);
+            return;
+        }
+        vtype_kind_t vtype_ptr = peek_vtype(emit, n_args - 1);
+        if (VTYPE_IS_BUF(vtype_ptr)) {
+            op |= (vtype_ptr - VTYPE_BUF8) << MP_NATIVE_PTR_OP_SIZE_POS | MP_NATIVE_PTR_OP_BUF;
+        } else if (vtype_ptr == VTYPE_PTR8 || vtype_ptr == VTYPE_PTR16 || vtype_ptr == VTYPE_PTR32) {
+            op |= (vtype_ptr - VTYPE_PTR8) << MP_NATIVE_PTR_OP_SIZE_POS;
+        } else {
+            EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
+                MP_ERROR_TEXT("can't load from '%q'"), vtype_to_qstr(vtype_ptr));
+        }
+        vtype_kind_t vtype;
+        if ((op & MP_NATIVE_PTR_OP_MASK) == MP_NATIVE_PTR_CLAMP) {
+            // n, lo and hi are passed as objects, so that this stays a 3-argument call
+            emit_get_stack_pointer_to_reg_for_pop(emit, REG_ARG_3, 3);
+            emit_pre_pop_reg(emit, &vtype, REG_ARG_2);
+            emit_pre_pop_discard(emit);
+            emit_call_with_imm_arg(emit, MP_F_NATIVE_PTR_CLAMP, op, REG_ARG_1);
+        } else {
+            emit_pre_pop_reg_reg(emit, &vtype, REG_ARG_3, &vtype_ptr, REG_ARG_2);
+            if (vtype != VTYPE_INT && vtype != VTYPE_UINT) {
+                EMIT_NATIVE_VIPER_TYPE_ERROR(emit,
+                    MP_ERROR_TEXT("can't load with '%q' index"), vtype_to_qstr(vtype));
+            }
+            emit_pre_pop_discard(emit);
+            emit_call_with_imm_arg(emit, MP_F_NATIVE_PTR_REDUCE, op, REG_ARG_1);
+        }
+        emit_post_push_reg(emit, VTYPE_UINT, REG_RET);
     } else {
         assert(vtype_fun == VTYPE_PYOBJ);
         if (star_flags) {
@@ -61,6 +61,11 @@ static byte mp_f_n_args[MP_F_NUMBER_OF] = {
     [MP_F_SMALL_INT_MODULO] = 2,
     [MP_F_NATIVE_YIELD_FROM] = 3,
     [MP_F_SETJMP] = 1,
+    // CIRCUITPY-CHANGE: viper buf arguments and pointer reductions
+    [MP_F_NATIVE_BUF_FROM_OBJ] = 3,
+    [MP_F_NATIVE_RAISE_BUF_INDEX] = 0,
+    [MP_F_NATIVE_PTR_REDUCE] = 3,
+    [MP_F_NATIVE_PTR_CLAMP] = 3,
 };
 
 #define N_X86 (1)
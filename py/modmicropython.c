@@ -31,6 +31,8 @@
 #include "py/runtime.h"
 #include "py/gc.h"
 #include "py/mphal.h"
+// CIRCUITPY-CHANGE
+#include "py/profile.h"
 
 #if MICROPY_PY_MICROPYTHON
 
@@ -50,6 +52,25 @@ static mp_obj_t mp_micropython_opt_level(size_t n_args, const mp_obj_t *args) {
 static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_opt_level_obj, 0, 1, mp_micropython_opt_level);
 #endif
 
+// CIRCUITPY-CHANGE: JIT tier
+#if MICROPY_EMIT_NATIVE_JIT
+static mp_obj_t mp_micropython_jit_threshold(size_t n_args, const mp_obj_t *args) {
+    if (n_args == 0) {
+        return MP_OBJ_NEW_SMALL_INT(MP_STATE_VM(jit_threshold));
+    } else {
+        // The call counters are 16 bits and must be able to pass the threshold.
+        MP_STATE_VM(jit_threshold) = mp_arg_validate_int_range(mp_obj_get_int(args[0]), 0, 0xfffe, MP_QSTR_threshold);
+        return mp_const_none;
+    }
+}
+static MP_DEFINE_CONST_FUN_OBJ_VAR_BETWEEN(mp_micropython_jit_threshold_obj, 0, 1, mp_micropython_jit_threshold);
+
+static mp_obj_t mp_micropython_jit_count(void) {
+    return mp_obj_new_int_from_uint(MP_STATE_VM(jit_count));
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(mp_micropython_jit_count_obj, mp_micropython_jit_count);
+#endif
+
 // CIRCUITPY-CHANGE: avoid warning
 #if CIRCUITPY_MICROPYTHON_ADVANCED && MICROPY_PY_MICROPYTHON_MEM_INFO
 
@@ -172,6 +193,26 @@ static mp_obj_t mp_micropython_schedule(mp_obj_t function, mp_obj_t arg) {
 static MP_DEFINE_CONST_FUN_OBJ_2(mp_micropython_schedule_obj, mp_micropython_schedule);
 #endif
 
+// CIRCUITPY-CHANGE
+#if MICROPY_PROF_SAMPLING
+static mp_obj_t mp_micropython_prof_start(void) {
+    mp_prof_sample_start();
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(mp_micropython_prof_start_obj, mp_micropython_prof_start);
+
+static mp_obj_t mp_micropython_prof_stop(void) {
+    mp_prof_sample_stop();
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(mp_micropython_prof_stop_obj, mp_micropython_prof_stop);
+
+static mp_obj_t mp_micropython_prof_dump(void) {
+    return MP_OBJ_NEW_SMALL_INT(mp_prof_sample_print(&mp_plat_print));
+}
+static MP_DEFINE_CONST_FUN_OBJ_0(mp_micropython_prof_dump_obj, mp_micropython_prof_dump);
+#endif
+
 static const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_micropython) },
     { MP_ROM_QSTR(MP_QSTR_const), MP_ROM_PTR(&mp_identity_obj) },
@@ -179,6 +220,11 @@ static const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     #if CIRCUITPY_MICROPYTHON_ADVANCED && MICROPY_ENABLE_COMPILER
     { MP_ROM_QSTR(MP_QSTR_opt_level), MP_ROM_PTR(&mp_micropython_opt_level_obj) },
     #endif
+    // CIRCUITPY-CHANGE: JIT tier
+    #if MICROPY_EMIT_NATIVE_JIT
+    { MP_ROM_QSTR(MP_QSTR_jit_threshold), MP_ROM_PTR(&mp_micropython_jit_threshold_obj) },
+    { MP_ROM_QSTR(MP_QSTR_jit_count), MP_ROM_PTR(&mp_micropython_jit_count_obj) },
+    #endif
     // CIRCUITPY-CHANGE: avoid warning
     #if CIRCUITPY_MICROPYTHON_ADVANCED && MICROPY_PY_MICROPYTHON_MEM_INFO
     #if MICROPY_MEM_STATS
@@ -216,6 +262,12 @@ static const mp_rom_map_elem_t mp_module_micropython_globals_table[] = {
     #if MICROPY_ENABLE_SCHEDULER
     { MP_ROM_QSTR(MP_QSTR_schedule), MP_ROM_PTR(&mp_micropython_schedule_obj) },
     #endif
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PROF_SAMPLING
+    { MP_ROM_QSTR(MP_QSTR_prof_start), MP_ROM_PTR(&mp_micropython_prof_start_obj) },
+    { MP_ROM_QSTR(MP_QSTR_prof_stop), MP_ROM_PTR(&mp_micropython_prof_stop_obj) },
+    { MP_ROM_QSTR(MP_QSTR_prof_dump), MP_ROM_PTR(&mp_micropython_prof_dump_obj) },
+    #endif
 };
 
 static MP_DEFINE_CONST_DICT(mp_module_micropython_globals, mp_module_micropython_globals_table);
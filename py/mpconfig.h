@@ -432,6 +432,19 @@
 // Convenience definition for whether any native or inline assembler emitter is enabled
 #define MICROPY_EMIT_MACHINE_CODE (MICROPY_EMIT_NATIVE || MICROPY_EMIT_INLINE_ASM)
 
+// CIRCUITPY-CHANGE: JIT tier
+// Whether to recompile hot bytecode functions to native code at runtime, using
+// the native emitter.  Executable memory comes from MP_PLAT_ALLOC_EXEC.
+#ifndef MICROPY_EMIT_NATIVE_JIT
+#define MICROPY_EMIT_NATIVE_JIT (0)
+#endif
+
+// Number of calls after which the JIT tier compiles a bytecode function, or 0
+// to leave the JIT tier off until micropython.jit_threshold() is called.
+#ifndef MICROPY_EMIT_NATIVE_JIT_THRESHOLD
+#define MICROPY_EMIT_NATIVE_JIT_THRESHOLD (0)
+#endif
+
 // Whether native relocatable code loaded from .mpy files is explicitly tracked
 // so that the GC cannot reclaim it.  Needed on architectures that allocate
 // executable memory on the MicroPython heap and don't explicitly track this
@@ -579,6 +592,14 @@
 #define MICROPY_OPT_LOAD_ATTR_FAST_PATH (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
 #endif
 
+// CIRCUITPY-CHANGE
+// Compute binary operations on two small ints (add, subtract, compare, bitwise
+// and shifts) inline in the VM, only calling mp_binary_op on overflow or for
+// other types.  Speeds up integer loops at the cost of some code size.
+#ifndef MICROPY_OPT_VM_SMALL_INT_FAST_PATH
+#define MICROPY_OPT_VM_SMALL_INT_FAST_PATH (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EXTRA_FEATURES)
+#endif
+
 // Use extra RAM to cache map lookups by remembering the likely location of
 // the index. Avoids the hash computation on unordered maps, and avoids the
 // linear search on ordered (especially in-ROM) maps. Can provide a +10-15%
@@ -1554,6 +1575,33 @@ typedef double mp_float_t;
 #define MICROPY_PY_SYS_SETTRACE (0)
 #endif
 
+// CIRCUITPY-CHANGE
+// Whether to provide a sampling profiler, driven by a port timer calling
+// mp_prof_sample(), and the micropython.prof_* functions to control it
+#ifndef MICROPY_PROF_SAMPLING
+#define MICROPY_PROF_SAMPLING (0)
+#endif
+
+// Number of call stacks the sampling profiler can hold before the oldest
+// are overwritten
+#ifndef MICROPY_PROF_SAMPLING_NUM_SAMPLES
+#define MICROPY_PROF_SAMPLING_NUM_SAMPLES (64)
+#endif
+
+// Maximum number of frames recorded per sample; outer frames beyond this are
+// dropped
+#ifndef MICROPY_PROF_SAMPLING_MAX_DEPTH
+#define MICROPY_PROF_SAMPLING_MAX_DEPTH (8)
+#endif
+
+// Hooks called when sampling starts and stops, to run the port's timer
+#ifndef MICROPY_PROF_SAMPLING_TIMER_START
+#define MICROPY_PROF_SAMPLING_TIMER_START()
+#endif
+#ifndef MICROPY_PROF_SAMPLING_TIMER_STOP
+#define MICROPY_PROF_SAMPLING_TIMER_STOP()
+#endif
+
 // Whether to provide "sys.getsizeof" function
 #ifndef MICROPY_PY_SYS_GETSIZEOF
 #define MICROPY_PY_SYS_GETSIZEOF (MICROPY_CONFIG_ROM_LEVEL_AT_LEAST_EVERYTHING)
@@ -229,6 +229,12 @@ typedef struct _mp_state_vm_t {
     #if MICROPY_EMIT_NATIVE
     uint8_t default_emit_opt; // one of MP_EMIT_OPT_xxx
     #endif
+    // CIRCUITPY-CHANGE: JIT tier
+    #if MICROPY_EMIT_NATIVE_JIT
+    uint16_t jit_threshold;
+    // number of functions compiled to native code so far
+    mp_uint_t jit_count;
+    #endif
     #endif
 
     // size of the emergency exception buf, if it's dynamically allocated
@@ -315,6 +321,9 @@ typedef struct _mp_state_thread_t {
     #if MICROPY_PY_SYS_SETTRACE
     mp_obj_t prof_trace_callback;
     bool prof_callback_is_executing;
+    #endif
+    // CIRCUITPY-CHANGE: also used by the sampling profiler
+    #if MICROPY_PY_SYS_SETTRACE || MICROPY_PROF_SAMPLING
     struct _mp_code_state_t *current_code_state;
     #endif
 
@@ -29,6 +29,11 @@
 #include <string.h>
 #include <assert.h>
 
+// CIRCUITPY-CHANGE: wide kernels of the viper ptr_sum/ptr_min/ptr_max/ptr_clamp builtins
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
 #include "py/binary.h"
 #include "py/runtime.h"
 #include "py/smallint.h"
@@ -63,6 +68,29 @@ int mp_native_type_from_qstr(qstr qst) {
             return MP_NATIVE_TYPE_PTR16;
         case MP_QSTR_ptr32:
             return MP_NATIVE_TYPE_PTR32;
+        // CIRCUITPY-CHANGE: bounds-checked buffer arguments
+        case MP_QSTR_buf8:
+            return MP_NATIVE_TYPE_BUF8;
+        case MP_QSTR_buf16:
+            return MP_NATIVE_TYPE_BUF16;
+        case MP_QSTR_buf32:
+            return MP_NATIVE_TYPE_BUF32;
+        default:
+            return -1;
+    }
+}
+
+// CIRCUITPY-CHANGE: viper builtins that reduce or clamp the elements behind a pointer
+int mp_native_ptr_op_from_qstr(qstr qst) {
+    switch (qst) {
+        case MP_QSTR_ptr_sum:
+            return MP_NATIVE_PTR_SUM;
+        case MP_QSTR_ptr_min:
+            return MP_NATIVE_PTR_MIN;
+        case MP_QSTR_ptr_max:
+            return MP_NATIVE_PTR_MAX;
+        case MP_QSTR_ptr_clamp:
+            return MP_NATIVE_PTR_CLAMP;
         default:
             return -1;
     }
@@ -109,6 +137,11 @@ mp_obj_t mp_native_to_obj(mp_uint_t val, mp_uint_t type) {
             return mp_obj_new_int_from_uint(val);
         case MP_NATIVE_TYPE_QSTR:
             return MP_OBJ_NEW_QSTR(val);
+        // CIRCUITPY-CHANGE: a buf value converts back to the object it came from
+        case MP_NATIVE_TYPE_BUF8:
+        case MP_NATIVE_TYPE_BUF16:
+        case MP_NATIVE_TYPE_BUF32:
+            return (mp_obj_t)((mp_uint_t *)val)[MP_NATIVE_BUF_OBJ];
         default: // a pointer
             // we return just the value of the pointer as an integer
             return mp_obj_new_int_from_uint(val);
@@ -232,6 +265,304 @@ static bool mp_native_yield_from(mp_obj_t gen, mp_obj_t send_value, mp_obj_t *re
     return false;
 }
 
+// CIRCUITPY-CHANGE: fill in the frame descriptor of a viper buf8/buf16/buf32 argument.
+// The length is counted in elements of the buf type, rounding down.
+static mp_uint_t *mp_native_buf_from_obj(mp_obj_t obj, mp_uint_t type, mp_uint_t *buf) {
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(obj, &bufinfo, MP_BUFFER_READ);
+    buf[MP_NATIVE_BUF_ITEMS] = (mp_uint_t)bufinfo.buf;
+    buf[MP_NATIVE_BUF_LEN] = bufinfo.len >> ((type & 0xf) - MP_NATIVE_TYPE_BUF8);
+    buf[MP_NATIVE_BUF_OBJ] = (mp_uint_t)obj;
+    return buf;
+}
+
+// CIRCUITPY-CHANGE: target of a failed buf bounds check
+static NORETURN void mp_native_raise_buf_index(void) {
+    mp_raise_IndexError(MP_ERROR_TEXT("index out of range"));
+}
+
+// CIRCUITPY-CHANGE: kernels of the viper ptr_sum/ptr_min/ptr_max/ptr_clamp builtins.
+// Elements are unsigned, as ptr8/ptr16/ptr32 loads are. The bulk of the elements
+// is handled 16 bytes at a time with SSE2 when the compiler targets it, and
+// otherwise 8 bytes at a time from a word-aligned address, so that Thumb-2 and
+// other 32-bit targets use paired (ldrd/ldm, strd/stm) loads and stores.
+
+static inline mp_uint_t native_ptr_get(const uint8_t *p, size_t size_log2) {
+    if (size_log2 == 0) {
+        return *p;
+    } else if (size_log2 == 1) {
+        return *(const uint16_t *)p;
+    } else {
+        return *(const uint32_t *)p;
+    }
+}
+
+static inline void native_ptr_set(uint8_t *p, size_t size_log2, mp_uint_t val) {
+    if (size_log2 == 0) {
+        *p = val;
+    } else if (size_log2 == 1) {
+        *(uint16_t *)p = val;
+    } else {
+        *(uint32_t *)p = val;
+    }
+}
+
+static inline mp_uint_t native_ptr_combine(mp_uint_t kind, mp_uint_t acc, mp_uint_t val) {
+    if (kind == MP_NATIVE_PTR_SUM) {
+        return acc + val;
+    } else if (kind == MP_NATIVE_PTR_MIN) {
+        return val < acc ? val : acc;
+    } else {
+        return val > acc ? val : acc;
+    }
+}
+
+#if defined(__SSE2__)
+
+// Unsigned 16 and 32-bit lanes are compared as signed ones with their top bit flipped.
+static inline __m128i native_sse2_bias(size_t size_log2) {
+    if (size_log2 == 0) {
+        return _mm_setzero_si128();
+    } else if (size_log2 == 1) {
+        return _mm_set1_epi16((short)0x8000);
+    } else {
+        return _mm_set1_epi32((int)0x80000000);
+    }
+}
+
+static inline __m128i native_sse2_splat(size_t size_log2, mp_uint_t val) {
+    if (size_log2 == 0) {
+        return _mm_set1_epi8((char)val);
+    } else if (size_log2 == 1) {
+        return _mm_set1_epi16((short)val);
+    } else {
+        return _mm_set1_epi32((int)val);
+    }
+}
+
+// a and b are biased, see native_sse2_bias
+static inline __m128i native_sse2_minmax(mp_uint_t kind, size_t size_log2, __m128i a, __m128i b) {
+    if (size_log2 == 0) {
+        return kind == MP_NATIVE_PTR_MIN ? _mm_min_epu8(a, b) : _mm_max_epu8(a, b);
+    } else if (size_log2 == 1) {
+        return kind == MP_NATIVE_PTR_MIN ? _mm_min_epi16(a, b) : _mm_max_epi16(a, b);
+    } else {
+        __m128i a_gt_b = _mm_cmpgt_epi32(a, b);
+        if (kind == MP_NATIVE_PTR_MIN) {
+            return _mm_or_si128(_mm_and_si128(a_gt_b, b), _mm_andnot_si128(a_gt_b, a));
+        } else {
+            return _mm_or_si128(_mm_and_si128(a_gt_b, a), _mm_andnot_si128(a_gt_b, b));
+        }
+    }
+}
+
+static inline __m128i native_sse2_cmpeq(size_t size_log2, __m128i a, __m128i b) {
+    if (size_log2 == 0) {
+        return _mm_cmpeq_epi8(a, b);
+    } else if (size_log2 == 1) {
+        return _mm_cmpeq_epi16(a, b);
+    } else {
+        return _mm_cmpeq_epi32(a, b);
+    }
+}
+
+#else
+
+static inline uint64_t native_ptr_load64(const uint8_t *p) {
+    uint64_t w;
+    memcpy(&w, __builtin_assume_aligned(p, 4), sizeof(w));
+    return w;
+}
+
+static inline void native_ptr_store64(uint8_t *p, uint64_t w) {
+    memcpy(__builtin_assume_aligned(p, 4), &w, sizeof(w));
+}
+
+#endif
+
+// Inlined with constant kind and size_log2 so each combination gets its own loop.
+static inline MP_ALWAYSINLINE mp_uint_t native_ptr_reduce_items(mp_uint_t kind, size_t size_log2, const uint8_t *p, size_t n) {
+    size_t size = 1 << size_log2;
+    mp_uint_t acc = kind == MP_NATIVE_PTR_SUM ? 0 : native_ptr_get(p, size_log2);
+
+    #if defined(__SSE2__)
+    size_t lanes = 16 >> size_log2;
+    if (kind == MP_NATIVE_PTR_SUM) {
+        __m128i zero = _mm_setzero_si128();
+        __m128i sum = zero;
+        for (; n >= lanes; n -= lanes, p += 16) {
+            __m128i v = _mm_loadu_si128((const __m128i *)p);
+            if (size_log2 == 0) {
+                v = _mm_sad_epu8(v, zero);
+            } else {
+                if (size_log2 == 1) {
+                    // add pairs as signed values, then undo the bias of each pair
+                    v = _mm_madd_epi16(_mm_xor_si128(v, native_sse2_bias(1)), _mm_set1_epi16(1));
+                    v = _mm_add_epi32(v, _mm_set1_epi32(0x10000));
+                }
+                v = _mm_add_epi64(_mm_unpacklo_epi32(v, zero), _mm_unpackhi_epi32(v, zero));
+            }
+            sum = _mm_add_epi64(sum, v);
+        }
+        uint64_t sums[2];
+        _mm_storeu_si128((__m128i *)sums, sum);
+        acc += (mp_uint_t)(sums[0] + sums[1]);
+    } else if (n >= lanes) {
+        __m128i bias = native_sse2_bias(size_log2);
+        __m128i best = _mm_xor_si128(_mm_loadu_si128((const __m128i *)p), bias);
+        for (; n >= lanes; n -= lanes, p += 16) {
+            __m128i v = _mm_xor_si128(_mm_loadu_si128((const __m128i *)p), bias);
+            best = native_sse2_minmax(kind, size_log2, best, v);
+        }
+        uint8_t best_items[16];
+        _mm_storeu_si128((__m128i *)best_items, _mm_xor_si128(best, bias));
+        for (size_t i = 0; i < 16; i += size) {
+            acc = native_ptr_combine(kind, acc, native_ptr_get(best_items + i, size_log2));
+        }
+    }
+    #else
+    for (; n > 0 && ((uintptr_t)p & 3) != 0; n--, p += size) {
+        acc = native_ptr_combine(kind, acc, native_ptr_get(p, size_log2));
+    }
+    size_t lanes = 8 >> size_log2;
+    unsigned int bits = 8 << size_log2;
+    uint64_t mask = ((uint64_t)1 << bits) - 1;
+    for (; n >= lanes; n -= lanes, p += 8) {
+        uint64_t w = native_ptr_load64(p);
+        for (size_t i = 0; i < lanes; i++, w >>= bits) {
+            acc = native_ptr_combine(kind, acc, (mp_uint_t)(w & mask));
+        }
+    }
+    #endif
+
+    for (; n > 0; n--, p += size) {
+        acc = native_ptr_combine(kind, acc, native_ptr_get(p, size_log2));
+    }
+    return acc;
+}
+
+// Returns the number of elements that were changed.
+static inline MP_ALWAYSINLINE mp_uint_t native_ptr_clamp_items(size_t size_log2, uint8_t *p, size_t n, mp_uint_t lo, mp_uint_t hi) {
+    size_t size = 1 << size_log2;
+    mp_uint_t changed = 0;
+
+    #if defined(__SSE2__)
+    size_t lanes = 16 >> size_log2;
+    __m128i bias = native_sse2_bias(size_log2);
+    __m128i lo_biased = _mm_xor_si128(native_sse2_splat(size_log2, lo), bias);
+    __m128i hi_biased = _mm_xor_si128(native_sse2_splat(size_log2, hi), bias);
+    for (; n >= lanes; n -= lanes, p += 16) {
+        __m128i v = _mm_loadu_si128((const __m128i *)p);
+        __m128i c = native_sse2_minmax(MP_NATIVE_PTR_MAX, size_log2, _mm_xor_si128(v, bias), lo_biased);
+        c = _mm_xor_si128(native_sse2_minmax(MP_NATIVE_PTR_MIN, size_log2, c, hi_biased), bias);
+        int same = _mm_movemask_epi8(native_sse2_cmpeq(size_log2, v, c));
+        if (same != 0xffff) {
+            _mm_storeu_si128((__m128i *)p, c);
+            changed += (16 - __builtin_popcount(same)) >> size_log2;
+        }
+    }
+    #else
+    for (; n > 0 && ((uintptr_t)p & 3) != 0; n--, p += size) {
+        mp_uint_t v = native_ptr_get(p, size_log2);
+        mp_uint_t c = v < lo ? lo : v;
+        c = c > hi ? hi : c;
+        if (c != v) {
+            native_ptr_set(p, size_log2, c);
+            changed += 1;
+        }
+    }
+    size_t lanes = 8 >> size_log2;
+    unsigned int bits = 8 << size_log2;
+    uint64_t mask = ((uint64_t)1 << bits) - 1;
+    for (; n >= lanes; n -= lanes, p += 8) {
+        uint64_t w = native_ptr_load64(p);
+        uint64_t clamped = 0;
+        for (size_t i = 0; i < lanes; i++) {
+            mp_uint_t v = (mp_uint_t)((w >> (i * bits)) & mask);
+            mp_uint_t c = v < lo ? lo : v;
+            c = c > hi ? hi : c;
+            changed += c != v;
+            clamped |= (uint64_t)c << (i * bits);
+        }
+        if (clamped != w) {
+            native_ptr_store64(p, clamped);
+        }
+    }
+    #endif
+
+    for (; n > 0; n--, p += size) {
+        mp_uint_t v = native_ptr_get(p, size_log2);
+        mp_uint_t c = v < lo ? lo : v;
+        c = c > hi ? hi : c;
+        if (c != v) {
+            native_ptr_set(p, size_log2, c);
+            changed += 1;
+        }
+    }
+    return changed;
+}
+
+// Get the elements of a ptr op, checking n against the length of a buf.
+// A negative n is taken to mean no elements.
+static uint8_t *native_ptr_op_items(mp_uint_t op, void *ptr, mp_uint_t *n) {
+    if ((mp_int_t)*n < 0) {
+        *n = 0;
+    }
+    if (op & MP_NATIVE_PTR_OP_BUF) {
+        mp_uint_t *buf = ptr;
+        if (*n > buf[MP_NATIVE_BUF_LEN]) {
+            mp_native_raise_buf_index();
+        }
+        return (uint8_t *)buf[MP_NATIVE_BUF_ITEMS];
+    }
+    return ptr;
+}
+
+static mp_uint_t mp_native_ptr_reduce(mp_uint_t op, void *ptr, mp_uint_t n) {
+    uint8_t *p = native_ptr_op_items(op, ptr, &n);
+    mp_uint_t kind = op & MP_NATIVE_PTR_OP_MASK;
+    if (n == 0) {
+        if (kind != MP_NATIVE_PTR_SUM) {
+            mp_raise_ValueError(MP_ERROR_TEXT("arg is an empty sequence"));
+        }
+        return 0;
+    }
+    #define NATIVE_PTR_REDUCE_CASE(kind, size_log2) \
+    case (kind) | (size_log2) << MP_NATIVE_PTR_OP_SIZE_POS: \
+        return native_ptr_reduce_items((kind), (size_log2), p, n)
+    switch (op & ~MP_NATIVE_PTR_OP_BUF) {
+        NATIVE_PTR_REDUCE_CASE(MP_NATIVE_PTR_SUM, 0);
+        NATIVE_PTR_REDUCE_CASE(MP_NATIVE_PTR_SUM, 1);
+        NATIVE_PTR_REDUCE_CASE(MP_NATIVE_PTR_SUM, 2);
+        NATIVE_PTR_REDUCE_CASE(MP_NATIVE_PTR_MIN, 0);
+        NATIVE_PTR_REDUCE_CASE(MP_NATIVE_PTR_MIN, 1);
+        NATIVE_PTR_REDUCE_CASE(MP_NATIVE_PTR_MIN, 2);
+        NATIVE_PTR_REDUCE_CASE(MP_NATIVE_PTR_MAX, 0);
+        NATIVE_PTR_REDUCE_CASE(MP_NATIVE_PTR_MAX, 1);
+        default:
+            return native_ptr_reduce_items(MP_NATIVE_PTR_MAX, 2, p, n);
+    }
+    #undef NATIVE_PTR_REDUCE_CASE
+}
+
+// args holds n, lo and hi as objects. lo and hi are unsigned like the elements,
+// and saturate at the largest element value.
+static mp_uint_t mp_native_ptr_clamp(mp_uint_t op, void *ptr, const mp_obj_t *args) {
+    mp_uint_t n = mp_obj_get_int_truncated(args[0]);
+    uint8_t *p = native_ptr_op_items(op, ptr, &n);
+    size_t size_log2 = (op >> MP_NATIVE_PTR_OP_SIZE_POS) & 3;
+    mp_uint_t max_val = (mp_uint_t)(((uint64_t)1 << (8 << size_log2)) - 1);
+    mp_uint_t lo = MIN((mp_uint_t)mp_obj_get_int_truncated(args[1]), max_val);
+    mp_uint_t hi = MIN((mp_uint_t)mp_obj_get_int_truncated(args[2]), max_val);
+    if (size_log2 == 0) {
+        return native_ptr_clamp_items(0, p, n, lo, hi);
+    } else if (size_log2 == 1) {
+        return native_ptr_clamp_items(1, p, n, lo, hi);
+    } else {
+        return native_ptr_clamp_items(2, p, n, lo, hi);
+    }
+}
+
 #if !MICROPY_PY_BUILTINS_FLOAT
 
 static mp_obj_t mp_obj_new_float_from_f(float f) {
@@ -357,6 +688,11 @@ const mp_fun_table_t mp_fun_table = {
     &mp_stream_readinto_obj,
     &mp_stream_unbuffered_readline_obj,
     &mp_stream_write_obj,
+    // CIRCUITPY-CHANGE: entries used by viper code
+    mp_native_buf_from_obj,
+    mp_native_raise_buf_index,
+    mp_native_ptr_reduce,
+    mp_native_ptr_clamp,
 };
 
 #elif MICROPY_EMIT_NATIVE && MICROPY_DYNAMIC_COMPILER
@@ -82,9 +82,32 @@ typedef enum {
     MP_F_SMALL_INT_MODULO,
     MP_F_NATIVE_YIELD_FROM,
     MP_F_SETJMP,
+    // CIRCUITPY-CHANGE: viper buffer helpers, stored after the dynamic runtime entries
+    MP_F_NATIVE_BUF_FROM_OBJ = 88,
+    MP_F_NATIVE_RAISE_BUF_INDEX,
+    MP_F_NATIVE_PTR_REDUCE,
+    MP_F_NATIVE_PTR_CLAMP,
     MP_F_NUMBER_OF,
 } mp_fun_kind_t;
 
+// CIRCUITPY-CHANGE: a viper buf8/buf16/buf32 value points to this many words in
+// the function's frame, filled in from the argument by native_buf_from_obj.
+#define MP_NATIVE_BUF_ITEMS (0)
+#define MP_NATIVE_BUF_LEN (1) // in elements, not bytes
+#define MP_NATIVE_BUF_OBJ (2)
+#define MP_NATIVE_BUF_WORDS (3)
+
+// CIRCUITPY-CHANGE: operations of the viper ptr_sum/ptr_min/ptr_max/ptr_clamp
+// builtins. The op passed to native_ptr_reduce and native_ptr_clamp also holds
+// log2 of the element size, and whether the pointer is a buf descriptor.
+#define MP_NATIVE_PTR_SUM (0)
+#define MP_NATIVE_PTR_MIN (1)
+#define MP_NATIVE_PTR_MAX (2)
+#define MP_NATIVE_PTR_CLAMP (3)
+#define MP_NATIVE_PTR_OP_MASK (0x3)
+#define MP_NATIVE_PTR_OP_SIZE_POS (2)
+#define MP_NATIVE_PTR_OP_BUF (0x10)
+
 typedef struct _mp_fun_table_t {
     mp_const_obj_t const_none;
     mp_const_obj_t const_false;
@@ -182,6 +205,14 @@ typedef struct _mp_fun_table_t {
     const mp_obj_fun_builtin_var_t *stream_readinto_obj;
     const mp_obj_fun_builtin_var_t *stream_unbuffered_readline_obj;
     const mp_obj_fun_builtin_var_t *stream_write_obj;
+    // CIRCUITPY-CHANGE: entries used by viper code, starting at index 88
+    mp_uint_t *(*native_buf_from_obj)(mp_obj_t obj, mp_uint_t type, mp_uint_t *buf);
+    #if defined(__GNUC__)
+    NORETURN
+    #endif
+    void (*native_raise_buf_index)(void);
+    mp_uint_t (*native_ptr_reduce)(mp_uint_t op, void *ptr, mp_uint_t n);
+    mp_uint_t (*native_ptr_clamp)(mp_uint_t op, void *ptr, const mp_obj_t *args);
 } mp_fun_table_t;
 
 #if (MICROPY_EMIT_NATIVE && !MICROPY_DYNAMIC_COMPILER) || MICROPY_ENABLE_DYNRUNTIME
@@ -32,6 +32,8 @@
 #include "py/objfun.h"
 #include "py/runtime.h"
 #include "py/bc.h"
+// CIRCUITPY-CHANGE: JIT tier
+#include "py/emitglue.h"
 #include "py/stackctrl.h"
 
 #if MICROPY_DEBUG_VERBOSE // print debugging info
@@ -227,6 +229,11 @@ mp_code_state_t *mp_obj_fun_bc_prepare_codestate(mp_obj_t self_in, size_t n_args
 }
 #endif
 
+// CIRCUITPY-CHANGE: JIT tier
+#if MICROPY_EMIT_NATIVE_JIT
+static mp_obj_t fun_native_call(mp_obj_t self_in, size_t n_args, size_t n_kw, const mp_obj_t *args);
+#endif
+
 // CIRCUITPY-CHANGE: PLACE_IN_ITCM
 static mp_obj_t PLACE_IN_ITCM(fun_bc_call)(mp_obj_t self_in, size_t n_args, size_t n_kw, const mp_obj_t *args) {
     MP_STACK_CHECK();
@@ -239,6 +246,14 @@ static mp_obj_t PLACE_IN_ITCM(fun_bc_call)(mp_obj_t self_in, size_t n_args, size
 
     mp_obj_fun_bc_t *self = MP_OBJ_TO_PTR(self_in);
 
+    // CIRCUITPY-CHANGE: JIT tier
+    #if MICROPY_EMIT_NATIVE_JIT
+    // Count the call, and once the function is hot switch it over to native code.
+    if (self->rc != NULL && mp_emit_jit_call(self)) {
+        return fun_native_call(self_in, n_args, n_kw, args);
+    }
+    #endif
+
     size_t n_state, state_size;
     DECODE_CODESTATE_SIZE(self->bytecode, n_state, state_size);
 
@@ -386,6 +401,10 @@ mp_obj_t mp_obj_new_fun_bc(const mp_obj_t *def_args, const byte *code, const mp_
     o->bytecode = code;
     o->context = context;
     o->child_table = child_table;
+    // CIRCUITPY-CHANGE: set by the caller if the function has a raw code
+    #if MICROPY_PY_SYS_SETTRACE || MICROPY_EMIT_NATIVE_JIT
+    o->rc = NULL;
+    #endif
     if (def_pos_args != NULL) {
         memcpy(o->extra_args, def_pos_args->items, n_def_args * sizeof(mp_obj_t));
     }
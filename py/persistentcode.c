@@ -410,7 +410,9 @@ void mp_raw_code_load(mp_reader_t *reader, mp_compiled_module_t *cm) {
     byte arch = MPY_FEATURE_DECODE_ARCH(header[2]);
     // CIRCUITPY-CHANGE: 'C', not 'M'
     if (header[0] != 'C'
-        || header[1] != MPY_VERSION
+        // CIRCUITPY-CHANGE: accept older .mpy versions
+        || header[1] < MPY_VERSION_MIN
+        || header[1] > MPY_VERSION
         || (arch != MP_NATIVE_ARCH_NONE && MPY_FEATURE_DECODE_SUB_VERSION(header[2]) != MPY_SUB_VERSION)
         || header[3] > MP_SMALL_INT_BITS) {
         mp_raise_ValueError(MP_ERROR_TEXT("incompatible .mpy file"));
@@ -34,9 +34,14 @@
 // as long as MPY_VERSION matches, but a native .mpy (i.e. one with an arch
 // set) must also match MPY_SUB_VERSION. This allows 3 additional updates to
 // the native ABI per bytecode revision.
-#define MPY_VERSION 6
+#define MPY_VERSION 7
 #define MPY_SUB_VERSION 3
 
+// CIRCUITPY-CHANGE
+// The oldest .mpy version that can still be loaded.  Version 7 only added the
+// fused bytecode opcodes, so version 6 files use a subset of its bytecode.
+#define MPY_VERSION_MIN 6
+
 // Macros to encode/decode sub-version to/from the feature byte. This replaces
 // the bits previously used to encode the flags (map caching and unicode)
 // which are no longer used starting at .mpy version 6.
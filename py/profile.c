@@ -24,6 +24,9 @@
  * THE SOFTWARE.
  */
 
+// CIRCUITPY-CHANGE
+#include <string.h>
+
 #include "py/profile.h"
 #include "py/bc0.h"
 #include "py/gc.h"
@@ -975,3 +978,157 @@ void mp_prof_print_instr(const byte *ip, mp_code_state_t *code_state) {
 #endif // MICROPY_PROF_INSTR_DEBUG_PRINT_ENABLE
 
 #endif // MICROPY_PY_SYS_SETTRACE
+
+// CIRCUITPY-CHANGE
+#if MICROPY_PROF_SAMPLING
+
+typedef struct _mp_prof_frame_sample_t {
+    qstr_short_t source_file;
+    qstr_short_t block_name;
+    uint16_t line;
+} mp_prof_frame_sample_t;
+
+typedef struct _mp_prof_stack_sample_t {
+    uint16_t depth;
+    // Innermost frame first.
+    mp_prof_frame_sample_t frames[MICROPY_PROF_SAMPLING_MAX_DEPTH];
+} mp_prof_stack_sample_t;
+
+// Written by mp_prof_sample(), which may run in an interrupt, so this is not
+// part of the GC-scanned state and holds no object references.
+static struct {
+    volatile bool running;
+    size_t next;
+    size_t count;
+    size_t lost;
+    mp_prof_stack_sample_t samples[MICROPY_PROF_SAMPLING_NUM_SAMPLES];
+} prof_samples;
+
+static void prof_sample_frame(const mp_code_state_t *code_state, mp_prof_frame_sample_t *frame) {
+    // Decode the prelude in the same way as the traceback code in vm.c.
+    const byte *ip = code_state->fun_bc->bytecode;
+    // CIRCUITPY-CHANGE: JIT tier
+    #if MICROPY_EMIT_NATIVE_JIT
+    // The function may have been switched to native code while this frame ran.
+    if (code_state->fun_bc->base.type == &mp_type_fun_native) {
+        ip = code_state->fun_bc->rc->fun_data;
+    }
+    #endif
+    MP_BC_PRELUDE_SIG_DECODE(ip);
+    MP_BC_PRELUDE_SIZE_DECODE(ip);
+    const byte *line_info_top = ip + n_info;
+    const byte *bytecode_start = ip + n_info + n_cell;
+    size_t bc = code_state->ip > bytecode_start ? (size_t)(code_state->ip - bytecode_start) : 0;
+    qstr block_name = mp_decode_uint_value(ip);
+    for (size_t i = 0; i < 1 + n_pos_args + n_kwonly_args; ++i) {
+        ip = mp_decode_uint_skip(ip);
+    }
+    #if MICROPY_EMIT_BYTECODE_USES_QSTR_TABLE
+    block_name = code_state->fun_bc->context->constants.qstr_table[block_name];
+    qstr source_file = code_state->fun_bc->context->constants.qstr_table[0];
+    #else
+    qstr source_file = code_state->fun_bc->context->constants.source_file;
+    #endif
+    frame->source_file = source_file;
+    frame->block_name = block_name;
+    frame->line = mp_bytecode_get_source_line(ip, line_info_top, bc);
+}
+
+void mp_prof_sample_start(void) {
+    bool was_running = prof_samples.running;
+    prof_samples.running = false;
+    prof_samples.next = 0;
+    prof_samples.count = 0;
+    prof_samples.lost = 0;
+    prof_samples.running = true;
+    // The timer may be reference counted, so only start it once per run.
+    if (!was_running) {
+        MICROPY_PROF_SAMPLING_TIMER_START();
+    }
+}
+
+void mp_prof_sample_stop(void) {
+    if (prof_samples.running) {
+        MICROPY_PROF_SAMPLING_TIMER_STOP();
+        prof_samples.running = false;
+    }
+}
+
+void mp_prof_sample_deinit(void) {
+    // The recorded qstrs don't survive a soft reset, so drop them along with the timer.
+    mp_prof_sample_stop();
+    memset(&prof_samples, 0, sizeof(prof_samples));
+}
+
+bool mp_prof_sample_is_running(void) {
+    return prof_samples.running;
+}
+
+void mp_prof_sample(void) {
+    if (!prof_samples.running) {
+        return;
+    }
+    const mp_code_state_t *code_state = MP_STATE_THREAD(current_code_state);
+    if (code_state == NULL) {
+        // Not executing any bytecode.
+        return;
+    }
+    mp_prof_stack_sample_t *sample = &prof_samples.samples[prof_samples.next];
+    size_t depth = 0;
+    for (; code_state != NULL && depth < MICROPY_PROF_SAMPLING_MAX_DEPTH; code_state = code_state->prev_state) {
+        prof_sample_frame(code_state, &sample->frames[depth++]);
+    }
+    sample->depth = depth;
+    if (++prof_samples.next == MICROPY_PROF_SAMPLING_NUM_SAMPLES) {
+        prof_samples.next = 0;
+    }
+    if (prof_samples.count < MICROPY_PROF_SAMPLING_NUM_SAMPLES) {
+        prof_samples.count += 1;
+    } else {
+        prof_samples.lost += 1;
+    }
+}
+
+static bool prof_sample_equal(const mp_prof_stack_sample_t *a, const mp_prof_stack_sample_t *b) {
+    return a->depth == b->depth && memcmp(a->frames, b->frames, a->depth * sizeof(a->frames[0])) == 0;
+}
+
+size_t mp_prof_sample_print(const mp_print_t *print) {
+    // Don't let the sampler write to the buffer while it's being read.
+    bool was_running = prof_samples.running;
+    prof_samples.running = false;
+
+    size_t count = prof_samples.count;
+    size_t first = (prof_samples.next + MICROPY_PROF_SAMPLING_NUM_SAMPLES - count) % MICROPY_PROF_SAMPLING_NUM_SAMPLES;
+    size_t lost = prof_samples.lost;
+
+    // Merge identical stacks, marking those already printed.
+    byte *printed = m_new0(byte, count);
+    for (size_t i = 0; i < count; ++i) {
+        if (printed[i]) {
+            continue;
+        }
+        const mp_prof_stack_sample_t *sample = &prof_samples.samples[(first + i) % MICROPY_PROF_SAMPLING_NUM_SAMPLES];
+        size_t n = 1;
+        for (size_t j = i + 1; j < count; ++j) {
+            if (!printed[j] && prof_sample_equal(sample, &prof_samples.samples[(first + j) % MICROPY_PROF_SAMPLING_NUM_SAMPLES])) {
+                printed[j] = 1;
+                n += 1;
+            }
+        }
+        for (size_t d = sample->depth; d > 0; --d) {
+            const mp_prof_frame_sample_t *frame = &sample->frames[d - 1];
+            mp_printf(print, "%s%q (%q:%u)", d == sample->depth ? "" : ";", frame->block_name, frame->source_file, frame->line);
+        }
+        mp_printf(print, " %u\n", (uint)n);
+    }
+    m_del(byte, printed, count);
+
+    prof_samples.next = 0;
+    prof_samples.count = 0;
+    prof_samples.lost = 0;
+    prof_samples.running = was_running;
+    return lost;
+}
+
+#endif // MICROPY_PROF_SAMPLING
@@ -78,4 +78,27 @@ void mp_prof_print_instr(const byte *ip, mp_code_state_t *code_state);
 #endif
 
 #endif // MICROPY_PY_SYS_SETTRACE
+
+// CIRCUITPY-CHANGE
+#if MICROPY_PROF_SAMPLING
+
+// Sampling profiler.  While it is running, the port calls mp_prof_sample()
+// periodically, usually from a timer interrupt.  Each call records the
+// function name and line number of every bytecode frame executing on the
+// current thread into a fixed ring buffer, without allocating.
+void mp_prof_sample_start(void);
+void mp_prof_sample_stop(void);
+bool mp_prof_sample_is_running(void);
+void mp_prof_sample(void);
+
+// Print the recorded samples as collapsed stacks, one line per distinct
+// stack of the form "outer;...;inner count", and discard them.  Returns
+// the number of samples that were overwritten before they could be printed.
+size_t mp_prof_sample_print(const mp_print_t *print);
+
+// Stop sampling and discard the samples.  Called when the VM is torn down.
+void mp_prof_sample_deinit(void);
+
+#endif // MICROPY_PROF_SAMPLING
+
 #endif // MICROPY_INCLUDED_PY_PROFILING_H
@@ -136,6 +136,7 @@ PY_CORE_O_BASENAME = $(addprefix py/,\
 	parsenum.o \
 	proto.o \
 	emitglue.o \
+	emitjit.o \
 	persistentcode.o \
 	runtime.o \
 	runtime_utils.o \
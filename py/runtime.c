@@ -47,6 +47,8 @@
 #include "py/builtin.h"
 #include "py/stackctrl.h"
 #include "py/gc.h"
+// CIRCUITPY-CHANGE: sampling profiler
+#include "py/profile.h"
 
 // CIRCUITPY-CHANGE
 #if CIRCUITPY_WARNINGS
@@ -112,6 +114,11 @@ void mp_init(void) {
     #if MICROPY_EMIT_NATIVE
     MP_STATE_VM(default_emit_opt) = MP_EMIT_OPT_NONE;
     #endif
+    // CIRCUITPY-CHANGE: JIT tier
+    #if MICROPY_EMIT_NATIVE_JIT
+    MP_STATE_VM(jit_threshold) = MICROPY_EMIT_NATIVE_JIT_THRESHOLD;
+    MP_STATE_VM(jit_count) = 0;
+    #endif
     #endif
 
     // init global module dict
@@ -172,6 +179,9 @@ void mp_init(void) {
     #if MICROPY_PY_SYS_SETTRACE
     MP_STATE_THREAD(prof_trace_callback) = MP_OBJ_NULL;
     MP_STATE_THREAD(prof_callback_is_executing) = false;
+    #endif
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_SYS_SETTRACE || MICROPY_PROF_SAMPLING
     MP_STATE_THREAD(current_code_state) = NULL;
     #endif
 
@@ -202,6 +212,11 @@ void mp_init(void) {
 void mp_deinit(void) {
     MP_THREAD_GIL_EXIT();
 
+    // CIRCUITPY-CHANGE: sampling profiler
+    #if MICROPY_PROF_SAMPLING
+    mp_prof_sample_deinit();
+    #endif
+
     // call port specific deinitialization if any
     #ifdef MICROPY_PORT_DEINIT_FUNC
     MICROPY_PORT_DEINIT_FUNC;
@@ -198,6 +198,12 @@ static inline void mp_thread_init_state(mp_state_thread_t *ts, size_t stack_size
     ts->nlr_jump_callback_top = NULL;
     ts->mp_pending_exception = MP_OBJ_NULL;
 
+    // CIRCUITPY-CHANGE
+    #if MICROPY_PY_SYS_SETTRACE || MICROPY_PROF_SAMPLING
+    // No bytecode is executing on this thread yet
+    ts->current_code_state = NULL;
+    #endif
+
     // If locals/globals are not given, inherit from main thread
     if (locals == NULL) {
         locals = mp_state_ctx.thread.dict_locals;
@@ -339,6 +345,8 @@ NORETURN void mp_raise_ZeroDivisionError(void);
 
 // helper functions for native/viper code
 int mp_native_type_from_qstr(qstr qst);
+// CIRCUITPY-CHANGE: viper ptr_sum/ptr_min/ptr_max/ptr_clamp builtins
+int mp_native_ptr_op_from_qstr(qstr qst);
 mp_uint_t mp_native_from_obj(mp_obj_t obj, mp_uint_t type);
 mp_obj_t mp_native_to_obj(mp_uint_t val, mp_uint_t type);
 
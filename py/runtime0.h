@@ -60,6 +60,11 @@
 // Not use for viper, but for dynamic native modules
 #define MP_NATIVE_TYPE_QSTR (0x08)
 
+// CIRCUITPY-CHANGE: bounds-checked viper buffer arguments
+#define MP_NATIVE_TYPE_BUF8 (0x09)
+#define MP_NATIVE_TYPE_BUF16 (0x0a)
+#define MP_NATIVE_TYPE_BUF32 (0x0b)
+
 // Bytecode and runtime boundaries for unary ops
 #define MP_UNARY_OP_NUM_BYTECODE    (MP_UNARY_OP_NOT + 1)
 #define MP_UNARY_OP_NUM_RUNTIME     (MP_UNARY_OP_SIZEOF + 1)
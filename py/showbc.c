@@ -526,6 +526,49 @@ const byte *mp_bytecode_print_str(const mp_print_t *print, const byte *ip_start,
             mp_printf(print, "IMPORT_STAR");
             break;
 
+        // CIRCUITPY-CHANGE: fused opcodes
+        case MP_BC_LOAD_FAST0_ATTR:
+            DECODE_QSTR;
+            mp_printf(print, "LOAD_FAST0_ATTR %s", qstr_str(qst));
+            break;
+
+        case MP_BC_LOAD_FAST0_METHOD:
+            DECODE_QSTR;
+            mp_printf(print, "LOAD_FAST0_METHOD %s", qstr_str(qst));
+            break;
+
+        case MP_BC_STORE_FAST0_ATTR:
+            DECODE_QSTR;
+            mp_printf(print, "STORE_FAST0_ATTR %s", qstr_str(qst));
+            break;
+
+        case MP_BC_BINARY_OP_SMALL_INT: {
+            DECODE_UINT;
+            mp_uint_t op = unum & MP_BC_FUSED_ARG_MASK;
+            mp_int_t arg = (mp_int_t)((unum >> MP_BC_FUSED_ARG_BITS) & MP_BC_FUSED_ARG_MASK) - MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS;
+            mp_printf(print, "BINARY_OP_SMALL_INT " UINT_FMT " %s " INT_FMT, op, qstr_str(mp_binary_op_method_name[op]), arg);
+            break;
+        }
+
+        case MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT: {
+            DECODE_UINT;
+            mp_uint_t local_num = unum >> (2 * MP_BC_FUSED_ARG_BITS);
+            mp_uint_t op = unum & MP_BC_FUSED_ARG_MASK;
+            mp_int_t arg = (mp_int_t)((unum >> MP_BC_FUSED_ARG_BITS) & MP_BC_FUSED_ARG_MASK) - MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS;
+            mp_printf(print, "LOAD_FAST_BINARY_OP_SMALL_INT " UINT_FMT " " UINT_FMT " %s " INT_FMT, local_num, op, qstr_str(mp_binary_op_method_name[op]), arg);
+            break;
+        }
+
+        case MP_BC_BINARY_OP_POP_JUMP_IF: {
+            DECODE_SLABEL;
+            mp_uint_t op = *ip & ~MP_BC_BINARY_OP_POP_JUMP_IF_TRUE;
+            mp_printf(print, "BINARY_OP_POP_JUMP_IF_%s " UINT_FMT " " UINT_FMT " %s",
+                (*ip & MP_BC_BINARY_OP_POP_JUMP_IF_TRUE) ? "TRUE" : "FALSE",
+                (mp_uint_t)(ip + unum - ip_start), op, qstr_str(mp_binary_op_method_name[op]));
+            ip += 1;
+            break;
+        }
+
         default:
             if (ip[-1] < MP_BC_LOAD_CONST_SMALL_INT_MULTI + 64) {
                 mp_printf(print, "LOAD_CONST_SMALL_INT " INT_FMT, (mp_int_t)ip[-1] - MP_BC_LOAD_CONST_SMALL_INT_MULTI - 16);
@@ -33,6 +33,8 @@
 #include "py/objtype.h"
 #include "py/objfun.h"
 #include "py/runtime.h"
+// CIRCUITPY-CHANGE
+#include "py/smallint.h"
 #include "py/bc0.h"
 #include "py/profile.h"
 
@@ -187,6 +189,25 @@
     } \
 } while(0)
 
+// CIRCUITPY-CHANGE
+#elif MICROPY_PROF_SAMPLING
+
+// Only maintain the chain of executing frames, for the sampling profiler.
+#define FRAME_SETUP() do { \
+    MP_STATE_THREAD(current_code_state) = code_state; \
+} while (0)
+
+#define FRAME_ENTER() do { \
+    code_state->prev_state = MP_STATE_THREAD(current_code_state); \
+} while (0)
+
+#define FRAME_LEAVE() do { \
+    MP_STATE_THREAD(current_code_state) = code_state->prev_state; \
+} while (0)
+
+#define FRAME_UPDATE()
+#define TRACE_TICK(current_ip, current_sp, is_exception)
+
 #else // MICROPY_PY_SYS_SETTRACE
 #define FRAME_SETUP()
 #define FRAME_ENTER()
@@ -205,6 +226,92 @@ static mp_obj_t get_active_exception(mp_exc_stack_t *exc_sp, mp_exc_stack_t *exc
     return MP_OBJ_NULL;
 }
 
+// CIRCUITPY-CHANGE
+#if MICROPY_OPT_VM_SMALL_INT_FAST_PATH
+// Compute a binary op on two small ints without calling mp_binary_op, for the
+// ops that are common in integer loops.  Returns MP_OBJ_NULL if an operand is
+// not a small int, the op is not handled here, or the result would not fit in
+// a small int; the caller must then use mp_binary_op.
+static inline mp_obj_t vm_small_int_binary_op(mp_uint_t op, mp_obj_t lhs, mp_obj_t rhs) {
+    if (!mp_obj_is_small_int(lhs) || !mp_obj_is_small_int(rhs)) {
+        return MP_OBJ_NULL;
+    }
+    mp_int_t lhs_val = MP_OBJ_SMALL_INT_VALUE(lhs);
+    mp_int_t rhs_val = MP_OBJ_SMALL_INT_VALUE(rhs);
+    switch (op) {
+        case MP_BINARY_OP_LESS:
+            return mp_obj_new_bool(lhs_val < rhs_val);
+        case MP_BINARY_OP_MORE:
+            return mp_obj_new_bool(lhs_val > rhs_val);
+        case MP_BINARY_OP_EQUAL:
+            return mp_obj_new_bool(lhs_val == rhs_val);
+        case MP_BINARY_OP_LESS_EQUAL:
+            return mp_obj_new_bool(lhs_val <= rhs_val);
+        case MP_BINARY_OP_MORE_EQUAL:
+            return mp_obj_new_bool(lhs_val >= rhs_val);
+        case MP_BINARY_OP_NOT_EQUAL:
+            return mp_obj_new_bool(lhs_val != rhs_val);
+        case MP_BINARY_OP_OR:
+        case MP_BINARY_OP_INPLACE_OR:
+            return MP_OBJ_NEW_SMALL_INT(lhs_val | rhs_val);
+        case MP_BINARY_OP_XOR:
+        case MP_BINARY_OP_INPLACE_XOR:
+            return MP_OBJ_NEW_SMALL_INT(lhs_val ^ rhs_val);
+        case MP_BINARY_OP_AND:
+        case MP_BINARY_OP_INPLACE_AND:
+            return MP_OBJ_NEW_SMALL_INT(lhs_val & rhs_val);
+        case MP_BINARY_OP_LSHIFT:
+        case MP_BINARY_OP_INPLACE_LSHIFT:
+            // negative shifts raise and large shifts overflow, so leave them
+            // to mp_binary_op
+            if (rhs_val < 0
+                || rhs_val >= (mp_int_t)(sizeof(lhs_val) * MP_BITS_PER_BYTE)
+                || lhs_val > (MP_SMALL_INT_MAX >> rhs_val)
+                || lhs_val < (MP_SMALL_INT_MIN >> rhs_val)) {
+                return MP_OBJ_NULL;
+            }
+            lhs_val = (mp_uint_t)lhs_val << rhs_val;
+            break;
+        case MP_BINARY_OP_RSHIFT:
+        case MP_BINARY_OP_INPLACE_RSHIFT:
+            if (rhs_val < 0) {
+                return MP_OBJ_NULL;
+            }
+            if (rhs_val >= (mp_int_t)(sizeof(lhs_val) * MP_BITS_PER_BYTE)) {
+                rhs_val = sizeof(lhs_val) * MP_BITS_PER_BYTE - 1;
+            }
+            return MP_OBJ_NEW_SMALL_INT(lhs_val >> rhs_val);
+        case MP_BINARY_OP_ADD:
+        case MP_BINARY_OP_INPLACE_ADD:
+            // can't overflow mp_int_t because small ints are at least 1 bit narrower
+            lhs_val += rhs_val;
+            break;
+        case MP_BINARY_OP_SUBTRACT:
+        case MP_BINARY_OP_INPLACE_SUBTRACT:
+            lhs_val -= rhs_val;
+            break;
+        default:
+            return MP_OBJ_NULL;
+    }
+    if (!MP_SMALL_INT_FITS(lhs_val)) {
+        return MP_OBJ_NULL;
+    }
+    return MP_OBJ_NEW_SMALL_INT(lhs_val);
+}
+#endif
+
+// CIRCUITPY-CHANGE
+// Binary op as executed by the VM, trying the small-int fast path first.
+static inline mp_obj_t vm_binary_op(mp_uint_t op, mp_obj_t lhs, mp_obj_t rhs) {
+    #if MICROPY_OPT_VM_SMALL_INT_FAST_PATH
+    mp_obj_t res = vm_small_int_binary_op(op, lhs, rhs);
+    if (res != MP_OBJ_NULL) {
+        return res;
+    }
+    #endif
+    return mp_binary_op(op, lhs, rhs);
+}
+
 // fastn has items in reverse order (fastn[0] is local[0], fastn[-1] is local[1], etc)
 // sp points to bottom of stack which grows up
 // returns:
@@ -414,7 +521,16 @@ dispatch_loop:
                     DISPATCH();
                 }
 
+                // CIRCUITPY-CHANGE: fused opcodes
+                ENTRY(MP_BC_LOAD_FAST0_ATTR):
+                    if (fastn[0] == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    PUSH(fastn[0]);
+                    goto load_attr;
+
                 ENTRY(MP_BC_LOAD_ATTR): {
+load_attr:;
                     FRAME_UPDATE();
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
@@ -441,7 +557,16 @@ dispatch_loop:
                     DISPATCH();
                 }
 
+                // CIRCUITPY-CHANGE
+                ENTRY(MP_BC_LOAD_FAST0_METHOD):
+                    if (fastn[0] == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    PUSH(fastn[0]);
+                    goto load_method;
+
                 ENTRY(MP_BC_LOAD_METHOD): {
+load_method:;
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
                     mp_load_method(*sp, qst, sp);
@@ -495,7 +620,16 @@ dispatch_loop:
                     DISPATCH();
                 }
 
+                // CIRCUITPY-CHANGE
+                ENTRY(MP_BC_STORE_FAST0_ATTR):
+                    if (fastn[0] == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    PUSH(fastn[0]);
+                    goto store_attr;
+
                 ENTRY(MP_BC_STORE_ATTR): {
+store_attr:;
                     FRAME_UPDATE();
                     MARK_EXC_IP_SELECTIVE();
                     DECODE_QSTR;
@@ -597,6 +731,21 @@ dispatch_loop:
                     DISPATCH_WITH_PEND_EXC_CHECK();
                 }
 
+                // CIRCUITPY-CHANGE
+                ENTRY(MP_BC_BINARY_OP_POP_JUMP_IF): {
+                    MARK_EXC_IP_SELECTIVE();
+                    DECODE_SLABEL;
+                    const byte *dest_ip = ip + slab;
+                    mp_uint_t op = *ip++;
+                    mp_obj_t rhs = POP();
+                    mp_obj_t lhs = POP();
+                    bool cond = mp_obj_is_true(vm_binary_op(op & ~MP_BC_BINARY_OP_POP_JUMP_IF_TRUE, lhs, rhs));
+                    if (cond == ((op & MP_BC_BINARY_OP_POP_JUMP_IF_TRUE) != 0)) {
+                        ip = dest_ip;
+                    }
+                    DISPATCH_WITH_PEND_EXC_CHECK();
+                }
+
                 ENTRY(MP_BC_JUMP_IF_TRUE_OR_POP): {
                     DECODE_ULABEL;
                     if (mp_obj_is_true(TOP())) {
@@ -1284,6 +1433,27 @@ yield:
                     mp_import_all(POP());
                     DISPATCH();
 
+                // CIRCUITPY-CHANGE
+                ENTRY(MP_BC_BINARY_OP_SMALL_INT): {
+                    MARK_EXC_IP_SELECTIVE();
+                    DECODE_UINT;
+                    mp_obj_t rhs = MP_OBJ_NEW_SMALL_INT((mp_int_t)((unum >> MP_BC_FUSED_ARG_BITS) & MP_BC_FUSED_ARG_MASK) - MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS);
+                    SET_TOP(vm_binary_op(unum & MP_BC_FUSED_ARG_MASK, TOP(), rhs));
+                    DISPATCH();
+                }
+
+                ENTRY(MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT): {
+                    MARK_EXC_IP_SELECTIVE();
+                    DECODE_UINT;
+                    mp_obj_t lhs = fastn[-(mp_int_t)(unum >> (2 * MP_BC_FUSED_ARG_BITS))];
+                    if (lhs == MP_OBJ_NULL) {
+                        goto local_name_error;
+                    }
+                    mp_obj_t rhs = MP_OBJ_NEW_SMALL_INT((mp_int_t)((unum >> MP_BC_FUSED_ARG_BITS) & MP_BC_FUSED_ARG_MASK) - MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS);
+                    PUSH(vm_binary_op(unum & MP_BC_FUSED_ARG_MASK, lhs, rhs));
+                    DISPATCH();
+                }
+
                 #if MICROPY_OPT_COMPUTED_GOTO
                 ENTRY(MP_BC_LOAD_CONST_SMALL_INT_MULTI):
                     PUSH(MP_OBJ_NEW_SMALL_INT((mp_int_t)ip[-1] - MP_BC_LOAD_CONST_SMALL_INT_MULTI - MP_BC_LOAD_CONST_SMALL_INT_MULTI_EXCESS));
@@ -1306,7 +1476,7 @@ yield:
                     MARK_EXC_IP_SELECTIVE();
                     mp_obj_t rhs = POP();
                     mp_obj_t lhs = TOP();
-                    SET_TOP(mp_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs));
+                    SET_TOP(vm_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs));
                     DISPATCH();
                 }
 
@@ -1329,7 +1499,7 @@ yield:
                     } else if (ip[-1] < MP_BC_BINARY_OP_MULTI + MP_BC_BINARY_OP_MULTI_NUM) {
                         mp_obj_t rhs = POP();
                         mp_obj_t lhs = TOP();
-                        SET_TOP(mp_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs));
+                        SET_TOP(vm_binary_op(ip[-1] - MP_BC_BINARY_OP_MULTI, lhs, rhs));
                         DISPATCH();
                     } else
                 #endif // MICROPY_OPT_COMPUTED_GOTO
@@ -1453,6 +1623,13 @@ unwind_loop:
                 && *code_state->ip != MP_BC_END_FINALLY
                 && *code_state->ip != MP_BC_RAISE_LAST) {
                 const byte *ip = code_state->fun_bc->bytecode;
+                // CIRCUITPY-CHANGE: JIT tier
+                #if MICROPY_EMIT_NATIVE_JIT
+                // The function may have been switched to native code while this frame ran.
+                if (code_state->fun_bc->base.type == &mp_type_fun_native) {
+                    ip = code_state->fun_bc->rc->fun_data;
+                }
+                #endif
                 MP_BC_PRELUDE_SIG_DECODE(ip);
                 MP_BC_PRELUDE_SIZE_DECODE(ip);
                 const byte *line_info_top = ip + n_info;
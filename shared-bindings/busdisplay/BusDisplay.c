@@ -393,6 +393,20 @@ MP_DEFINE_CONST_FUN_OBJ_1(busdisplay_busdisplay_get_bus_obj, busdisplay_busdispl
 MP_PROPERTY_GETTER(busdisplay_busdisplay_bus_obj,
     (mp_obj_t)&busdisplay_busdisplay_get_bus_obj);
 
+//|     refresh_pixels: Tuple[int, int]
+//|     """The number of pixels marked as changed for the last refresh, and the
+//|     number that were rendered once overlapping and nearby areas were merged.
+//|     Changes hidden behind opaque TileGrids are not counted. (read-only)"""
+//|
+static mp_obj_t busdisplay_busdisplay_obj_get_refresh_pixels(mp_obj_t self_in) {
+    busdisplay_busdisplay_obj_t *self = native_display(self_in);
+    return common_hal_busdisplay_busdisplay_get_refresh_pixels(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(busdisplay_busdisplay_get_refresh_pixels_obj, busdisplay_busdisplay_obj_get_refresh_pixels);
+
+MP_PROPERTY_GETTER(busdisplay_busdisplay_refresh_pixels_obj,
+    (mp_obj_t)&busdisplay_busdisplay_get_refresh_pixels_obj);
+
 //|     root_group: displayio.Group
 //|     """The root group on the display.
 //|     If the root group is set to `displayio.CIRCUITPYTHON_TERMINAL`, the default CircuitPython terminal will be shown.
@@ -495,6 +509,7 @@ static const mp_rom_map_elem_t busdisplay_busdisplay_locals_dict_table[] = {
     { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&busdisplay_busdisplay_height_obj) },
     { MP_ROM_QSTR(MP_QSTR_rotation), MP_ROM_PTR(&busdisplay_busdisplay_rotation_obj) },
     { MP_ROM_QSTR(MP_QSTR_bus), MP_ROM_PTR(&busdisplay_busdisplay_bus_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_pixels), MP_ROM_PTR(&busdisplay_busdisplay_refresh_pixels_obj) },
     { MP_ROM_QSTR(MP_QSTR_root_group), MP_ROM_PTR(&busdisplay_busdisplay_root_group_obj) },
 };
 static MP_DEFINE_CONST_DICT(busdisplay_busdisplay_locals_dict, busdisplay_busdisplay_locals_dict_table);
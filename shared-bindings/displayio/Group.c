@@ -316,13 +316,17 @@ static mp_obj_t group_subscr(mp_obj_t self_in, mp_obj_t index_obj, mp_obj_t valu
 //|
 //|
 static mp_obj_t displayio_group_obj_sort(size_t n_args, const mp_obj_t *pos_args, mp_map_t *kw_args) {
+    enum { ARG_key, ARG_reverse };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_key, MP_ARG_KW_ONLY | MP_ARG_OBJ, {.u_obj = mp_const_none} },
+        { MP_QSTR_reverse, MP_ARG_KW_ONLY | MP_ARG_BOOL, {.u_bool = false} },
+    };
     displayio_group_t *self = native_group(pos_args[0]);
-    mp_obj_t *args = m_new(mp_obj_t, n_args);
-    for (size_t i = 1; i < n_args; ++i) {
-        args[i] = pos_args[i];
-    }
-    args[0] = MP_OBJ_FROM_PTR(self->members);
-    return mp_obj_list_sort(n_args, args, kw_args);
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all(n_args - 1, pos_args + 1, kw_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    common_hal_displayio_group_sort(self, args[ARG_key].u_obj, args[ARG_reverse].u_bool);
+    return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(displayio_group_sort_obj, 1, displayio_group_obj_sort);
 
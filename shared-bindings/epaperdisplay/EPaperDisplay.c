@@ -65,6 +65,12 @@
 //|         two_byte_sequence_length: bool = False,
 //|         start_up_time: float = 0,
 //|         address_little_endian: bool = False,
+//|         partial_refresh_display_command: Optional[
+//|             Union[int, circuitpython_typing.ReadableBuffer]
+//|         ] = None,
+//|         partial_refresh_time: float = 1,
+//|         seconds_per_partial_frame: float = 1,
+//|         full_refresh_interval: int = 10,
 //|     ) -> None:
 //|         """Create a EPaperDisplay object on the given display bus (`fourwire.FourWire` or `paralleldisplaybus.ParallelBus`).
 //|
@@ -107,9 +113,30 @@
 //|         :param bool two_byte_sequence_length: When true, use two bytes to define sequence length
 //|         :param float start_up_time: Time to wait after reset before sending commands
 //|         :param bool address_little_endian: Send the least significant byte (not bit) of multi-byte addresses first. Ignored when ram is addressed with one byte
+//|         :param int partial_refresh_display_command: Command used to start a partial refresh. Single int or byte-packed command sequence. When given, and the display has ``set_row_window_command``, only the changed areas are sent and refreshed
+//|         :param float partial_refresh_time: Time it takes to do a partial refresh. Ignored when busy_pin is provided.
+//|         :param float seconds_per_partial_frame: Minimum number of seconds between a refresh and the following partial refresh
+//|         :param int full_refresh_interval: Number of partial refreshes in a row before a full refresh is done to clear ghosting. 0 never forces a full refresh.
 //|         """
 //|         ...
 //|
+static const uint8_t *get_refresh_command_sequence(mp_obj_t refresh_obj, bool two_byte_sequence_length, qstr arg_name, size_t *len) {
+    mp_buffer_info_t refresh_bufinfo;
+    mp_int_t refresh_command;
+    if (mp_obj_get_int_maybe(refresh_obj, &refresh_command)) {
+        uint8_t *command_buf = m_malloc(3);
+        command_buf[0] = refresh_command;
+        command_buf[1] = 0;
+        command_buf[2] = 0;
+        *len = two_byte_sequence_length? 3: 2;
+        return command_buf;
+    } else if (mp_get_buffer(refresh_obj, &refresh_bufinfo, MP_BUFFER_READ)) {
+        *len = refresh_bufinfo.len;
+        return refresh_bufinfo.buf;
+    }
+    mp_raise_ValueError_varg(MP_ERROR_TEXT("Invalid %q"), arg_name);
+}
+
 static mp_obj_t epaperdisplay_epaperdisplay_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
     enum { ARG_display_bus, ARG_start_sequence, ARG_stop_sequence, ARG_width, ARG_height,
            ARG_ram_width, ARG_ram_height, ARG_colstart, ARG_rowstart, ARG_rotation,
@@ -118,7 +145,9 @@ static mp_obj_t epaperdisplay_epaperdisplay_make_new(const mp_obj_type_t *type,
            ARG_write_color_ram_command, ARG_color_bits_inverted, ARG_highlight_color,
            ARG_refresh_display_command,  ARG_refresh_time, ARG_busy_pin, ARG_busy_state,
            ARG_seconds_per_frame, ARG_always_toggle_chip_select, ARG_grayscale, ARG_advanced_color_epaper,
-           ARG_two_byte_sequence_length, ARG_start_up_time, ARG_address_little_endian };
+           ARG_two_byte_sequence_length, ARG_start_up_time, ARG_address_little_endian,
+           ARG_partial_refresh_display_command, ARG_partial_refresh_time, ARG_seconds_per_partial_frame,
+           ARG_full_refresh_interval };
     static const mp_arg_t allowed_args[] = {
         { MP_QSTR_display_bus, MP_ARG_REQUIRED | MP_ARG_OBJ },
         { MP_QSTR_start_sequence, MP_ARG_REQUIRED | MP_ARG_OBJ },
@@ -150,6 +179,10 @@ static mp_obj_t epaperdisplay_epaperdisplay_make_new(const mp_obj_type_t *type,
         { MP_QSTR_two_byte_sequence_length, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
         { MP_QSTR_start_up_time, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NEW_SMALL_INT(0)} },
         { MP_QSTR_address_little_endian, MP_ARG_BOOL | MP_ARG_KW_ONLY, {.u_bool = false} },
+        { MP_QSTR_partial_refresh_display_command, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = mp_const_none} },
+        { MP_QSTR_partial_refresh_time, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NEW_SMALL_INT(1)} },
+        { MP_QSTR_seconds_per_partial_frame, MP_ARG_OBJ | MP_ARG_KW_ONLY, {.u_obj = MP_OBJ_NEW_SMALL_INT(1)} },
+        { MP_QSTR_full_refresh_interval, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 10} },
     };
     mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
     mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
@@ -184,24 +217,19 @@ static mp_obj_t epaperdisplay_epaperdisplay_make_new(const mp_obj_type_t *type,
 
     bool two_byte_sequence_length = args[ARG_two_byte_sequence_length].u_bool;
 
-    mp_obj_t refresh_obj = args[ARG_refresh_display_command].u_obj;
-    const uint8_t *refresh_buf;
-    mp_buffer_info_t refresh_bufinfo;
     size_t refresh_buf_len = 0;
-    mp_int_t refresh_command;
-    if (mp_obj_get_int_maybe(refresh_obj, &refresh_command)) {
-        uint8_t *command_buf = m_malloc(3);
-        command_buf[0] = refresh_command;
-        command_buf[1] = 0;
-        command_buf[2] = 0;
-        refresh_buf = command_buf;
-        refresh_buf_len = two_byte_sequence_length? 3: 2;
-    } else if (mp_get_buffer(refresh_obj, &refresh_bufinfo, MP_BUFFER_READ)) {
-        refresh_buf = refresh_bufinfo.buf;
-        refresh_buf_len = refresh_bufinfo.len;
-    } else {
-        mp_raise_ValueError_varg(MP_ERROR_TEXT("Invalid %q"), MP_QSTR_refresh_display_command);
+    const uint8_t *refresh_buf = get_refresh_command_sequence(args[ARG_refresh_display_command].u_obj,
+        two_byte_sequence_length, MP_QSTR_refresh_display_command, &refresh_buf_len);
+
+    size_t partial_refresh_buf_len = 0;
+    const uint8_t *partial_refresh_buf = NULL;
+    if (args[ARG_partial_refresh_display_command].u_obj != mp_const_none) {
+        partial_refresh_buf = get_refresh_command_sequence(args[ARG_partial_refresh_display_command].u_obj,
+            two_byte_sequence_length, MP_QSTR_partial_refresh_display_command, &partial_refresh_buf_len);
     }
+    mp_float_t partial_refresh_time = mp_obj_get_float(args[ARG_partial_refresh_time].u_obj);
+    mp_float_t seconds_per_partial_frame = mp_obj_get_float(args[ARG_seconds_per_partial_frame].u_obj);
+    mp_int_t full_refresh_interval = mp_arg_validate_int_range(args[ARG_full_refresh_interval].u_int, 0, 0xffff, MP_QSTR_full_refresh_interval);
 
     self->base.type = &epaperdisplay_epaperdisplay_type;
     common_hal_epaperdisplay_epaperdisplay_construct(
@@ -218,6 +246,10 @@ static mp_obj_t epaperdisplay_epaperdisplay_make_new(const mp_obj_type_t *type,
         args[ARG_always_toggle_chip_select].u_bool, args[ARG_grayscale].u_bool, args[ARG_advanced_color_epaper].u_bool,
         two_byte_sequence_length, args[ARG_address_little_endian].u_bool
         );
+    if (partial_refresh_buf != NULL) {
+        epaperdisplay_epaperdisplay_set_partial_refresh_parameters(self, partial_refresh_buf, partial_refresh_buf_len,
+            partial_refresh_time, seconds_per_partial_frame, full_refresh_interval);
+    }
 
     return self;
 }
@@ -359,6 +391,20 @@ MP_DEFINE_CONST_FUN_OBJ_1(epaperdisplay_epaperdisplay_get_bus_obj, epaperdisplay
 MP_PROPERTY_GETTER(epaperdisplay_epaperdisplay_bus_obj,
     (mp_obj_t)&epaperdisplay_epaperdisplay_get_bus_obj);
 
+//|     refresh_pixels: Tuple[int, int]
+//|     """The number of pixels marked as changed for the last refresh, and the
+//|     number that were rendered once overlapping and nearby areas were merged.
+//|     Changes hidden behind opaque TileGrids are not counted. (read-only)"""
+//|
+static mp_obj_t epaperdisplay_epaperdisplay_obj_get_refresh_pixels(mp_obj_t self_in) {
+    epaperdisplay_epaperdisplay_obj_t *self = native_display(self_in);
+    return common_hal_epaperdisplay_epaperdisplay_get_refresh_pixels(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(epaperdisplay_epaperdisplay_get_refresh_pixels_obj, epaperdisplay_epaperdisplay_obj_get_refresh_pixels);
+
+MP_PROPERTY_GETTER(epaperdisplay_epaperdisplay_refresh_pixels_obj,
+    (mp_obj_t)&epaperdisplay_epaperdisplay_get_refresh_pixels_obj);
+
 //|     root_group: displayio.Group
 //|     """The root group on the epaper display.
 //|     If the root group is set to `displayio.CIRCUITPYTHON_TERMINAL`, the default CircuitPython terminal will be shown.
@@ -399,6 +445,7 @@ static const mp_rom_map_elem_t epaperdisplay_epaperdisplay_locals_dict_table[] =
     { MP_ROM_QSTR(MP_QSTR_bus), MP_ROM_PTR(&epaperdisplay_epaperdisplay_bus_obj) },
     { MP_ROM_QSTR(MP_QSTR_busy), MP_ROM_PTR(&epaperdisplay_epaperdisplay_busy_obj) },
     { MP_ROM_QSTR(MP_QSTR_time_to_refresh), MP_ROM_PTR(&epaperdisplay_epaperdisplay_time_to_refresh_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_pixels), MP_ROM_PTR(&epaperdisplay_epaperdisplay_refresh_pixels_obj) },
     { MP_ROM_QSTR(MP_QSTR_root_group), MP_ROM_PTR(&epaperdisplay_epaperdisplay_root_group_obj) },
 };
 static MP_DEFINE_CONST_DICT(epaperdisplay_epaperdisplay_locals_dict, epaperdisplay_epaperdisplay_locals_dict_table);
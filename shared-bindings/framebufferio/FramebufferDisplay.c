@@ -307,6 +307,20 @@ static mp_obj_t framebufferio_framebufferdisplay_obj_fill_row(size_t n_args, con
 }
 MP_DEFINE_CONST_FUN_OBJ_KW(framebufferio_framebufferdisplay_fill_row_obj, 1, framebufferio_framebufferdisplay_obj_fill_row);
 
+//|     refresh_pixels: Tuple[int, int]
+//|     """The number of pixels marked as changed for the last refresh, and the
+//|     number that were rendered once overlapping and nearby areas were merged.
+//|     Changes hidden behind opaque TileGrids are not counted. (read-only)"""
+//|
+static mp_obj_t framebufferio_framebufferdisplay_obj_get_refresh_pixels(mp_obj_t self_in) {
+    framebufferio_framebufferdisplay_obj_t *self = native_display(self_in);
+    return common_hal_framebufferio_framebufferdisplay_get_refresh_pixels(self);
+}
+MP_DEFINE_CONST_FUN_OBJ_1(framebufferio_framebufferdisplay_get_refresh_pixels_obj, framebufferio_framebufferdisplay_obj_get_refresh_pixels);
+
+MP_PROPERTY_GETTER(framebufferio_framebufferdisplay_refresh_pixels_obj,
+    (mp_obj_t)&framebufferio_framebufferdisplay_get_refresh_pixels_obj);
+
 //|     root_group: displayio.Group
 //|     """The root group on the display.
 //|     If the root group is set to `displayio.CIRCUITPYTHON_TERMINAL`, the default CircuitPython terminal will be shown.
@@ -352,6 +366,7 @@ static const mp_rom_map_elem_t framebufferio_framebufferdisplay_locals_dict_tabl
     { MP_ROM_QSTR(MP_QSTR_height), MP_ROM_PTR(&framebufferio_framebufferdisplay_height_obj) },
     { MP_ROM_QSTR(MP_QSTR_rotation), MP_ROM_PTR(&framebufferio_framebufferdisplay_rotation_obj) },
     { MP_ROM_QSTR(MP_QSTR_framebuffer), MP_ROM_PTR(&framebufferio_framebufferframebuffer_obj) },
+    { MP_ROM_QSTR(MP_QSTR_refresh_pixels), MP_ROM_PTR(&framebufferio_framebufferdisplay_refresh_pixels_obj) },
     { MP_ROM_QSTR(MP_QSTR_root_group), MP_ROM_PTR(&framebufferio_framebufferdisplay_root_group_obj) },
 };
 static MP_DEFINE_CONST_DICT(framebufferio_framebufferdisplay_locals_dict, framebufferio_framebufferdisplay_locals_dict_table);
@@ -103,13 +103,16 @@ MP_DEFINE_CONST_FUN_OBJ_2(jpegio_jpegdecoder_open_obj, jpegio_jpegdecoder_open);
 //|     ) -> None:
 //|         """Decode JPEG data
 //|
-//|         The bitmap must be large enough to contain the decoded image.
+//|         The image is decoded in small blocks that are copied straight into the bitmap, so the
+//|         bitmap does not need to hold the whole image. Pixels that fall outside the bitmap are
+//|         dropped, and decoding stops once the rows below ``y2`` are reached.
 //|         The pixel data is stored in the `displayio.Colorspace.RGB565_SWAPPED` colorspace.
 //|
 //|         The image is optionally downscaled by a factor of ``2**scale``.
 //|         Scaling by a factor of 8 (scale=3) is particularly efficient in terms of decoding time.
 //|
-//|         The remaining parameters are as for `bitmaptools.blit`.
+//|         The remaining parameters are as for `bitmaptools.blit`. ``x1``, ``y1``, ``x2`` and ``y2``
+//|         select a rectangle of the scaled image, which may be larger than the bitmap.
 //|         Because JPEG is a lossy data format, chroma keying based on the "source
 //|         index" is not reliable, because the same original RGB value might end
 //|         up being decompressed as a similar but not equal color value. Using a
@@ -162,7 +165,9 @@ static mp_obj_t jpegio_jpegdecoder_decode(mp_uint_t n_args, const mp_obj_t *pos_
 
     int x = mp_arg_validate_int_range(args[ARG_x].u_int, 0, bitmap->width, MP_QSTR_x);
     int y = mp_arg_validate_int_range(args[ARG_y].u_int, 0, bitmap->height, MP_QSTR_y);
-    bitmaptools_rect_t lim = bitmaptools_validate_coord_range_pair(&args[ARG_x1], bitmap->width, bitmap->height);
+    int image_width, image_height;
+    common_hal_jpegio_jpegdecoder_get_scaled_size(self, scale, &image_width, &image_height);
+    bitmaptools_rect_t lim = bitmaptools_validate_coord_range_pair(&args[ARG_x1], image_width, image_height);
 
     uint32_t skip_source_index;
     bool skip_source_index_none; // flag whether skip_value was None
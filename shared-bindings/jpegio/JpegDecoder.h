@@ -19,6 +19,7 @@ void common_hal_jpegio_jpegdecoder_construct(jpegio_jpegdecoder_obj_t *self);
 void common_hal_jpegio_jpegdecoder_close(jpegio_jpegdecoder_obj_t *self);
 mp_obj_t common_hal_jpegio_jpegdecoder_set_source_buffer(jpegio_jpegdecoder_obj_t *self, mp_obj_t jpeg_data);
 mp_obj_t common_hal_jpegio_jpegdecoder_set_source_file(jpegio_jpegdecoder_obj_t *self, mp_obj_t file_obj);
+void common_hal_jpegio_jpegdecoder_get_scaled_size(jpegio_jpegdecoder_obj_t *self, int scale, int *width, int *height);
 void common_hal_jpegio_jpegdecoder_decode_into(
     jpegio_jpegdecoder_obj_t *self,
     displayio_bitmap_t *bitmap, int scale, int16_t x, int16_t y,
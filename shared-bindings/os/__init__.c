@@ -16,6 +16,7 @@
 #include "py/objstr.h"
 #include "py/runtime.h"
 #include "shared-bindings/os/__init__.h"
+#include "supervisor/filesystem.h"
 
 //| """functions that an OS normally provides
 //|
@@ -267,6 +268,8 @@ static mp_obj_t os_sync(void) {
         // this assumes that vfs->obj is fs_user_mount_t with block device functions
         disk_ioctl(MP_OBJ_TO_PTR(vfs->obj), CTRL_SYNC, NULL);
     }
+    // CIRCUITPY defers its flush after a sync, so finish it now.
+    filesystem_sync();
     return mp_const_none;
 }
 MP_DEFINE_CONST_FUN_OBJ_0(os_sync_obj, os_sync);
@@ -0,0 +1,206 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/obj.h"
+#include "py/objproperty.h"
+#include "py/runtime.h"
+#include "shared-bindings/recordlog/RecordLog.h"
+#include "shared-bindings/util.h"
+#include "shared/runtime/context_manager_helpers.h"
+
+//| class RecordLog:
+//|     """An append-only log of binary records.
+//|
+//|     Usage::
+//|
+//|         import recordlog
+//|
+//|         try:
+//|             f = open("/telemetry.log", "r+b")
+//|         except OSError:
+//|             f = open("/telemetry.log", "w+b")
+//|         log = recordlog.RecordLog(f)
+//|         log.append(b"reading 1")
+//|         log.append(b"reading 2")
+//|         log.commit()
+//|         for record in reversed(log):
+//|             print(record)
+//|     """
+//|
+//|     def __init__(self, storage: Union[typing.BinaryIO, BlockDevice], *, buffer_size: int = 512) -> None:
+//|         """Open the log kept in ``storage``, or start a new one.
+//|
+//|         :param storage: A file opened for reading and writing in bytes mode,
+//|             but not in append mode, or a block device with ``readblocks``,
+//|             ``writeblocks`` and ``ioctl`` methods. A block device is used
+//|             as a whole.
+//|         :param int buffer_size: The number of bytes of records that are
+//|             held in RAM before they are written to a file, which also limits
+//|             the length of a record. Longer records, appended with a larger
+//|             buffer, are still read. A block device uses its block size instead.
+//|
+//|         Records after the last complete one, left by a commit that was cut
+//|         short, are ignored and later overwritten.
+//|         """
+//|         ...
+//|
+static mp_obj_t recordlog_recordlog_make_new(const mp_obj_type_t *type, size_t n_args, size_t n_kw, const mp_obj_t *all_args) {
+    enum { ARG_storage, ARG_buffer_size };
+    static const mp_arg_t allowed_args[] = {
+        { MP_QSTR_storage, MP_ARG_OBJ | MP_ARG_REQUIRED, {.u_obj = MP_OBJ_NULL} },
+        { MP_QSTR_buffer_size, MP_ARG_INT | MP_ARG_KW_ONLY, {.u_int = 512} },
+    };
+    mp_arg_val_t args[MP_ARRAY_SIZE(allowed_args)];
+    mp_arg_parse_all_kw_array(n_args, n_kw, all_args, MP_ARRAY_SIZE(allowed_args), allowed_args, args);
+
+    size_t buffer_size = mp_arg_validate_int_range(args[ARG_buffer_size].u_int, 16, 65536, MP_QSTR_buffer_size);
+
+    recordlog_recordlog_obj_t *self = mp_obj_malloc(recordlog_recordlog_obj_t, &recordlog_recordlog_type);
+    common_hal_recordlog_recordlog_construct(self, args[ARG_storage].u_obj, buffer_size);
+    return MP_OBJ_FROM_PTR(self);
+}
+
+static void check_for_deinit(recordlog_recordlog_obj_t *self) {
+    if (common_hal_recordlog_recordlog_deinited(self)) {
+        raise_deinited_error();
+    }
+}
+
+//|     def deinit(self) -> None:
+//|         """Commit any pending records and release the buffers. The storage
+//|         is not closed."""
+//|         ...
+//|
+static mp_obj_t recordlog_recordlog_deinit(mp_obj_t self_in) {
+    recordlog_recordlog_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    common_hal_recordlog_recordlog_deinit(self);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(recordlog_recordlog_deinit_obj, recordlog_recordlog_deinit);
+
+//|     def __enter__(self) -> RecordLog:
+//|         """No-op used by Context Managers."""
+//|         ...
+//|
+//  Provided by context manager helper.
+
+//|     def __exit__(self) -> None:
+//|         """Automatically deinitializes when exiting a context. See
+//|         :ref:`lifetime-and-contextmanagers` for more info."""
+//|         ...
+//|
+//  Provided by context manager helper.
+
+//|     def append(self, record: ReadableBuffer) -> None:
+//|         """Add a record to the end of the log. It is kept in RAM until the
+//|         next `commit`, or until the buffer is full."""
+//|         ...
+//|
+static mp_obj_t recordlog_recordlog_append(mp_obj_t self_in, mp_obj_t record_in) {
+    recordlog_recordlog_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+
+    mp_buffer_info_t bufinfo;
+    mp_get_buffer_raise(record_in, &bufinfo, MP_BUFFER_READ);
+    mp_arg_validate_length_max(bufinfo.len, common_hal_recordlog_recordlog_get_max_record_length(self), MP_QSTR_record);
+    common_hal_recordlog_recordlog_append(self, bufinfo.buf, bufinfo.len);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_2(recordlog_recordlog_append_obj, recordlog_recordlog_append);
+
+//|     def commit(self) -> None:
+//|         """Write the records appended since the last commit to storage.
+//|
+//|         Each commit rewrites the end of the file, or the current block of a
+//|         block device, so batching records into fewer commits means less
+//|         wear."""
+//|         ...
+//|
+static mp_obj_t recordlog_recordlog_commit(mp_obj_t self_in) {
+    recordlog_recordlog_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    common_hal_recordlog_recordlog_commit(self);
+    return mp_const_none;
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(recordlog_recordlog_commit_obj, recordlog_recordlog_commit);
+
+//|     max_record_length: int
+//|     """The length of the longest record that can be appended. (read-only)"""
+//|
+static mp_obj_t recordlog_recordlog_get_max_record_length(mp_obj_t self_in) {
+    recordlog_recordlog_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self);
+    return MP_OBJ_NEW_SMALL_INT(common_hal_recordlog_recordlog_get_max_record_length(self));
+}
+MP_DEFINE_CONST_FUN_OBJ_1(recordlog_recordlog_get_max_record_length_obj, recordlog_recordlog_get_max_record_length);
+
+MP_PROPERTY_GETTER(recordlog_recordlog_max_record_length_obj,
+    (mp_obj_t)&recordlog_recordlog_get_max_record_length_obj);
+
+static mp_obj_t recordlog_recordlog_records(recordlog_recordlog_obj_t *self, bool reverse) {
+    check_for_deinit(self);
+    recordlog_records_obj_t *records = mp_obj_malloc(recordlog_records_obj_t, &recordlog_records_type);
+    common_hal_recordlog_recordlog_records(self, records, reverse);
+    return MP_OBJ_FROM_PTR(records);
+}
+
+//|     def __iter__(self) -> Iterator[bytes]:
+//|         """Iterate over the records from oldest to newest. Pending records
+//|         are committed first."""
+//|         ...
+//|
+static mp_obj_t recordlog_recordlog_getiter(mp_obj_t self_in, mp_obj_iter_buf_t *iter_buf) {
+    (void)iter_buf;
+    return recordlog_recordlog_records(MP_OBJ_TO_PTR(self_in), false);
+}
+
+//|     def __reversed__(self) -> Iterator[bytes]:
+//|         """Iterate over the records from newest to oldest. Pending records
+//|         are committed first."""
+//|         ...
+//|
+//|
+static mp_obj_t recordlog_recordlog___reversed__(mp_obj_t self_in) {
+    return recordlog_recordlog_records(MP_OBJ_TO_PTR(self_in), true);
+}
+static MP_DEFINE_CONST_FUN_OBJ_1(recordlog_recordlog___reversed___obj, recordlog_recordlog___reversed__);
+
+static const mp_rom_map_elem_t recordlog_recordlog_locals_dict_table[] = {
+    { MP_ROM_QSTR(MP_QSTR_deinit), MP_ROM_PTR(&recordlog_recordlog_deinit_obj) },
+    { MP_ROM_QSTR(MP_QSTR___enter__), MP_ROM_PTR(&default___enter___obj) },
+    { MP_ROM_QSTR(MP_QSTR___exit__), MP_ROM_PTR(&default___exit___obj) },
+    { MP_ROM_QSTR(MP_QSTR___reversed__), MP_ROM_PTR(&recordlog_recordlog___reversed___obj) },
+    { MP_ROM_QSTR(MP_QSTR_append), MP_ROM_PTR(&recordlog_recordlog_append_obj) },
+    { MP_ROM_QSTR(MP_QSTR_commit), MP_ROM_PTR(&recordlog_recordlog_commit_obj) },
+    { MP_ROM_QSTR(MP_QSTR_max_record_length), MP_ROM_PTR(&recordlog_recordlog_max_record_length_obj) },
+};
+static MP_DEFINE_CONST_DICT(recordlog_recordlog_locals_dict, recordlog_recordlog_locals_dict_table);
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    recordlog_recordlog_type,
+    MP_QSTR_RecordLog,
+    MP_TYPE_FLAG_ITER_IS_GETITER | MP_TYPE_FLAG_HAS_SPECIAL_ACCESSORS,
+    make_new, recordlog_recordlog_make_new,
+    iter, recordlog_recordlog_getiter,
+    locals_dict, &recordlog_recordlog_locals_dict
+    );
+
+static mp_obj_t recordlog_records_iternext(mp_obj_t self_in) {
+    recordlog_records_obj_t *self = MP_OBJ_TO_PTR(self_in);
+    check_for_deinit(self->log);
+    mp_obj_t record = common_hal_recordlog_records_next(self);
+    if (record != mp_const_none) {
+        return record;
+    }
+    return MP_OBJ_STOP_ITERATION;
+}
+
+MP_DEFINE_CONST_OBJ_TYPE(
+    recordlog_records_type,
+    MP_QSTR_Records,
+    MP_TYPE_FLAG_ITER_IS_ITERNEXT,
+    iter, recordlog_records_iternext
+    );
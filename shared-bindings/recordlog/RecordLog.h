@@ -0,0 +1,23 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "shared-module/recordlog/RecordLog.h"
+
+extern const mp_obj_type_t recordlog_recordlog_type;
+extern const mp_obj_type_t recordlog_records_type;
+
+void common_hal_recordlog_recordlog_construct(recordlog_recordlog_obj_t *self, mp_obj_t storage, size_t buffer_size);
+void common_hal_recordlog_recordlog_deinit(recordlog_recordlog_obj_t *self);
+bool common_hal_recordlog_recordlog_deinited(recordlog_recordlog_obj_t *self);
+size_t common_hal_recordlog_recordlog_get_max_record_length(recordlog_recordlog_obj_t *self);
+void common_hal_recordlog_recordlog_append(recordlog_recordlog_obj_t *self, const uint8_t *data, size_t len);
+void common_hal_recordlog_recordlog_commit(recordlog_recordlog_obj_t *self);
+void common_hal_recordlog_recordlog_records(recordlog_recordlog_obj_t *self, recordlog_records_obj_t *records, bool reverse);
+
+// Returns None after the last record.
+mp_obj_t common_hal_recordlog_records_next(recordlog_records_obj_t *self);
@@ -0,0 +1,38 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include "py/obj.h"
+#include "py/runtime.h"
+
+#include "shared-bindings/recordlog/RecordLog.h"
+
+//| """Append-only logs of small records
+//|
+//| The `recordlog` module stores a stream of short binary records, such as
+//| sensor readings, so that they survive power loss and can be read back
+//| newest first. Records are buffered in RAM and written together by
+//| `RecordLog.commit`, and each one carries a CRC so that a write cut short
+//| by a reset loses only the records that were not committed.
+//|
+//| A log can be kept in a file on any filesystem, or directly on a block
+//| device such as a spare flash partition. On a block device the log is a
+//| ring: blocks are written in turn, which spreads wear evenly, and once every
+//| block is used the oldest records are overwritten.
+//| """
+
+static const mp_rom_map_elem_t recordlog_module_globals_table[] = {
+    { MP_ROM_QSTR(MP_QSTR___name__), MP_ROM_QSTR(MP_QSTR_recordlog) },
+    { MP_ROM_QSTR(MP_QSTR_RecordLog), MP_ROM_PTR(&recordlog_recordlog_type) },
+};
+
+static MP_DEFINE_CONST_DICT(recordlog_module_globals, recordlog_module_globals_table);
+
+const mp_obj_module_t recordlog_module = {
+    .base = { &mp_type_module },
+    .globals = (mp_obj_dict_t *)&recordlog_module_globals,
+};
+
+MP_REGISTER_MODULE(MP_QSTR_recordlog, recordlog_module);
@@ -8,6 +8,8 @@
 
 #include <stdbool.h>
 #include <math.h>
+#include <stdlib.h>
+#include <string.h>
 
 #include "py/runtime.h"
 
@@ -68,15 +70,17 @@ static void *scratchpad_alloc(size_t sz) {
     return scratchpad;
 }
 
-static void scratch_bitmap16(displayio_bitmap_t *buf, int rows, int cols) {
+// Returns the `extra` bytes of scratch space that follow the bitmap's rows
+static void *scratch_bitmap16(displayio_bitmap_t *buf, int rows, int cols, size_t extra) {
     int stride = (cols + 1) / 2;
     size_t sz = rows * stride * sizeof(uint32_t);
-    void *data = scratchpad_alloc(sz);
+    uint32_t *data = scratchpad_alloc(sz + extra);
     // memset(data, 0, sz);
     buf->width = cols;
     buf->height = rows;
     buf->stride = stride;
     buf->data = data;
+    return data + rows * stride;
 }
 
 // https://en.wikipedia.org/wiki/YCbCr -> JPEG Conversion
@@ -88,6 +92,92 @@ uint16_t imlib_yuv_to_rgb(uint8_t y, int8_t u, int8_t v) {
     return COLOR_R8_G8_B8_TO_RGB565(r, g, b);
 }
 
+// Splits an n x n kernel into column and row vectors whose outer product it
+// is, so it can be applied as two 1-D passes.
+static bool separate_kernel(int n, const int *krn, int *col, int *row) {
+    int r0 = -1, k0 = -1;
+    for (int i = 0; i < n * n; i++) {
+        if (krn[i]) {
+            r0 = i / n;
+            k0 = i % n;
+            break;
+        }
+    }
+    if (r0 < 0) {
+        return false;
+    }
+
+    // With the common factor taken out of the row, every other row must be
+    // an integer multiple of it.
+    const int *krn_row = krn + r0 * n;
+    int divisor = 0;
+    for (int k = 0; k < n; k++) {
+        int a = abs(krn_row[k]), b = divisor;
+        while (b) {
+            int t = a % b;
+            a = b;
+            b = t;
+        }
+        divisor = a;
+    }
+    for (int k = 0; k < n; k++) {
+        row[k] = krn_row[k] / divisor;
+    }
+    for (int j = 0; j < n; j++) {
+        const int *krn_j = krn + j * n;
+        if (krn_j[k0] % row[k0]) {
+            return false;
+        }
+        col[j] = krn_j[k0] / row[k0];
+        for (int k = 0; k < n; k++) {
+            if (krn_j[k] != col[j] * row[k]) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+// R, G and B in 10 bit fields of one word, so a single multiply-accumulate
+// weights all three channels. Only usable while no field can overflow into
+// its neighbour, i.e. with non-negative weights summing to at most 16.
+#define MORPH_SWAR_FIELD_MAX (0x3ff)
+#define MORPH_SWAR_SPREAD(pixel) \
+    ((COLOR_RGB565_TO_R5(pixel) << 20) | (COLOR_RGB565_TO_G6(pixel) << 10) | COLOR_RGB565_TO_B5(pixel))
+
+static inline int morph_finish_pixel(int32_t r_acc, int32_t g_acc, int32_t b_acc,
+    int32_t m_int, int32_t b_int, bool threshold, int offset, bool invert, int original) {
+    r_acc = (r_acc * m_int + b_int) >> 16;
+    if (r_acc > COLOR_R5_MAX) {
+        r_acc = COLOR_R5_MAX;
+    } else if (r_acc < 0) {
+        r_acc = 0;
+    }
+    g_acc = (g_acc * m_int + b_int * 2) >> 16;
+    if (g_acc > COLOR_G6_MAX) {
+        g_acc = COLOR_G6_MAX;
+    } else if (g_acc < 0) {
+        g_acc = 0;
+    }
+    b_acc = (b_acc * m_int + b_int) >> 16;
+    if (b_acc > COLOR_B5_MAX) {
+        b_acc = COLOR_B5_MAX;
+    } else if (b_acc < 0) {
+        b_acc = 0;
+    }
+
+    int pixel = COLOR_R5_G6_B5_TO_RGB565(r_acc, g_acc, b_acc);
+
+    if (threshold) {
+        if (((COLOR_RGB565_TO_Y(pixel) - offset) < COLOR_RGB565_TO_Y(original)) ^ invert) {
+            pixel = COLOR_RGB565_BINARY_MAX;
+        } else {
+            pixel = COLOR_RGB565_BINARY_MIN;
+        }
+    }
+    return pixel;
+}
+
 void shared_module_bitmapfilter_morph(
     displayio_bitmap_t *bitmap,
     displayio_bitmap_t *mask,
@@ -108,13 +198,75 @@ void shared_module_bitmapfilter_morph(
         default:
             mp_raise_ValueError(MP_ERROR_TEXT("unsupported bitmap depth"));
         case 16: {
+            // Separable kernels are applied as a vertical pass into a row of
+            // column sums, padded by ksize at each end with copies of the edge
+            // sums, followed by a horizontal pass over that row.
+            int n = 2 * ksize + 1;
+            int col[n], row[n];
+            bool separable = ksize > 0 && separate_kernel(n, krn, col, row);
+            bool swar = false;
+            if (separable) {
+                int sum = 0;
+                swar = true;
+                for (int i = 0; i < n * n; i++) {
+                    swar = swar && krn[i] >= 0;
+                    sum += krn[i];
+                }
+                swar = swar && sum * COLOR_G6_MAX <= MORPH_SWAR_FIELD_MAX;
+            }
+            int sums_len = separable ? bitmap->width + 2 * ksize : 0;
+            size_t sums_size = sums_len * (swar ? sizeof(uint32_t) : 3 * sizeof(int32_t));
+
             displayio_bitmap_t buf;
-            scratch_bitmap16(&buf, brows, bitmap->width);
+            void *sums = scratch_bitmap16(&buf, brows, bitmap->width, sums_size);
+            uint32_t *swar_sums = sums;
+            int32_t *channel_sums = sums;
 
             for (int y = 0, yy = bitmap->height; y < yy; y++) {
                 uint16_t *row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, y);
                 uint16_t *buf_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(&buf, (y % brows));
 
+                if (separable) {
+                    uint16_t *k_row_ptrs[n];
+                    for (int j = 0; j < n; j++) {
+                        k_row_ptrs[j] = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap,
+                            IM_MIN(IM_MAX(y + j - ksize, 0), (bitmap->height - 1)));
+                    }
+                    int last = ksize + bitmap->width - 1;
+                    if (swar) {
+                        for (int x = 0, xx = bitmap->width; x < xx; x++) {
+                            uint32_t acc = 0;
+                            for (int j = 0; j < n; j++) {
+                                int pixel = IMAGE_GET_RGB565_PIXEL_FAST(k_row_ptrs[j], x);
+                                acc += col[j] * MORPH_SWAR_SPREAD(pixel);
+                            }
+                            swar_sums[ksize + x] = acc;
+                        }
+                        for (int i = 0; i < ksize; i++) {
+                            swar_sums[i] = swar_sums[ksize];
+                            swar_sums[last + 1 + i] = swar_sums[last];
+                        }
+                    } else {
+                        for (int x = 0, xx = bitmap->width; x < xx; x++) {
+                            int32_t r_acc = 0, g_acc = 0, b_acc = 0;
+                            for (int j = 0; j < n; j++) {
+                                int pixel = IMAGE_GET_RGB565_PIXEL_FAST(k_row_ptrs[j], x);
+                                r_acc += col[j] * COLOR_RGB565_TO_R5(pixel);
+                                g_acc += col[j] * COLOR_RGB565_TO_G6(pixel);
+                                b_acc += col[j] * COLOR_RGB565_TO_B5(pixel);
+                            }
+                            int32_t *sum = channel_sums + 3 * (ksize + x);
+                            sum[0] = r_acc;
+                            sum[1] = g_acc;
+                            sum[2] = b_acc;
+                        }
+                        for (int i = 0; i < ksize; i++) {
+                            memcpy(channel_sums + 3 * i, channel_sums + 3 * ksize, 3 * sizeof(int32_t));
+                            memcpy(channel_sums + 3 * (last + 1 + i), channel_sums + 3 * last, 3 * sizeof(int32_t));
+                        }
+                    }
+                }
+
                 for (int x = 0, xx = bitmap->width; x < xx; x++) {
                     if (mask && common_hal_displayio_bitmap_get_pixel(mask, x, y)) {
                         IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
@@ -123,7 +275,23 @@ void shared_module_bitmapfilter_morph(
                     }
                     int32_t r_acc = 0, g_acc = 0, b_acc = 0, ptr = 0;
 
-                    if (x >= ksize && x < bitmap->width - ksize && y >= ksize && y < bitmap->height - ksize) {
+                    if (swar) {
+                        // swar_sums[x + k] holds the column sum for x + k - ksize
+                        uint32_t acc = 0;
+                        for (int k = 0; k < n; k++) {
+                            acc += row[k] * swar_sums[x + k];
+                        }
+                        r_acc = acc >> 20;
+                        g_acc = (acc >> 10) & MORPH_SWAR_FIELD_MAX;
+                        b_acc = acc & MORPH_SWAR_FIELD_MAX;
+                    } else if (separable) {
+                        const int32_t *sum = channel_sums + 3 * x;
+                        for (int k = 0; k < n; k++, sum += 3) {
+                            r_acc += row[k] * sum[0];
+                            g_acc += row[k] * sum[1];
+                            b_acc += row[k] * sum[2];
+                        }
+                    } else if (x >= ksize && x < bitmap->width - ksize && y >= ksize && y < bitmap->height - ksize) {
                         for (int j = -ksize; j <= ksize; j++) {
                             uint16_t *k_row_ptr = IMAGE_COMPUTE_RGB565_PIXEL_ROW_PTR(bitmap, y + j);
                             for (int k = -ksize; k <= ksize; k++) {
@@ -146,35 +314,9 @@ void shared_module_bitmapfilter_morph(
                             }
                         }
                     }
-                    r_acc = (r_acc * m_int + b_int) >> 16;
-                    if (r_acc > COLOR_R5_MAX) {
-                        r_acc = COLOR_R5_MAX;
-                    } else if (r_acc < 0) {
-                        r_acc = 0;
-                    }
-                    g_acc = (g_acc * m_int + b_int * 2) >> 16;
-                    if (g_acc > COLOR_G6_MAX) {
-                        g_acc = COLOR_G6_MAX;
-                    } else if (g_acc < 0) {
-                        g_acc = 0;
-                    }
-                    b_acc = (b_acc * m_int + b_int) >> 16;
-                    if (b_acc > COLOR_B5_MAX) {
-                        b_acc = COLOR_B5_MAX;
-                    } else if (b_acc < 0) {
-                        b_acc = 0;
-                    }
-
-                    int pixel = COLOR_R5_G6_B5_TO_RGB565(r_acc, g_acc, b_acc);
-
-                    if (threshold) {
-                        if (((COLOR_RGB565_TO_Y(pixel) - offset) < COLOR_RGB565_TO_Y(IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x))) ^ invert) {
-                            pixel = COLOR_RGB565_BINARY_MAX;
-                        } else {
-                            pixel = COLOR_RGB565_BINARY_MIN;
-                        }
-                    }
 
+                    int pixel = morph_finish_pixel(r_acc, g_acc, b_acc, m_int, b_int,
+                        threshold, offset, invert, IMAGE_GET_RGB565_PIXEL_FAST(row_ptr, x));
                     IMAGE_PUT_RGB565_PIXEL_FAST(buf_row_ptr, x, pixel);
                 }
 
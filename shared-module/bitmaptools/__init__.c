@@ -23,6 +23,53 @@
 #define BITMAP_DEBUG(...) (void)0
 // #define BITMAP_DEBUG(...) mp_printf(&mp_plat_print, __VA_ARGS__)
 
+#define ROTOZOOM_FRACTION_BITS (16)
+// Larger steps still leave room for a destination coordinate multiplier in 64 bits.
+#define ROTOZOOM_STEP_LIMIT ((int64_t)1 << 46)
+
+static int64_t _rotozoom_fixed(mp_float_t value) {
+    value *= (1 << ROTOZOOM_FRACTION_BITS);
+    if (value > ROTOZOOM_STEP_LIMIT) {
+        return ROTOZOOM_STEP_LIMIT;
+    }
+    if (value < -ROTOZOOM_STEP_LIMIT) {
+        return -ROTOZOOM_STEP_LIMIT;
+    }
+    return (int64_t)MICROPY_FLOAT_C_FUN(round)(value);
+}
+
+static int64_t _floor_div(int64_t numerator, int64_t denominator) {
+    // denominator must be positive
+    if (numerator >= 0) {
+        return numerator / denominator;
+    }
+    return -((-numerator + denominator - 1) / denominator);
+}
+
+// Narrows [*x0, *x1] to the x for which lo <= start + x * step < hi.
+static void _rotozoom_clip_span(int64_t start, int64_t step, int64_t lo, int64_t hi, int64_t *x0, int64_t *x1) {
+    int64_t first, last;
+    if (step > 0) {
+        first = -_floor_div(start - lo, step);
+        last = -_floor_div(start - hi, step) - 1;
+    } else if (step < 0) {
+        first = _floor_div(start - hi, -step) + 1;
+        last = _floor_div(start - lo, -step);
+    } else {
+        if (start >= lo && start < hi) {
+            return;
+        }
+        first = *x0 + 1;
+        last = *x0;
+    }
+    if (first > *x0) {
+        *x0 = first;
+    }
+    if (last < *x1) {
+        *x1 = last;
+    }
+}
+
 void common_hal_bitmaptools_rotozoom(displayio_bitmap_t *self, int16_t ox, int16_t oy,
     int16_t dest_clip0_x, int16_t dest_clip0_y,
     int16_t dest_clip1_x, int16_t dest_clip1_y,
@@ -171,36 +218,77 @@ void common_hal_bitmaptools_rotozoom(displayio_bitmap_t *self, int16_t ox, int16
         maxy = dest_clip1_y - 1;
     }
 
-    mp_float_t dvCol = cosAngle / scale;
-    mp_float_t duCol = sinAngle / scale;
+    displayio_area_t dirty_area = {minx, miny, maxx + 1, maxy + 1, NULL};
+    displayio_bitmap_set_dirty_area(self, &dirty_area);
 
-    mp_float_t duRow = dvCol;
-    mp_float_t dvRow = -duCol;
+    // A zero (or NaN) scale maps every destination pixel outside of the source.
+    if (!(scale > 0)) {
+        return;
+    }
 
-    mp_float_t startu = px - (ox * dvCol + oy * duCol);
-    mp_float_t startv = py - (ox * dvRow + oy * duRow);
+    // The source point (u, v) sampled for destination pixel (x, y) is
+    //   u = px + (x - ox) * cos / scale + (y - oy) * sin / scale
+    //   v = py - (x - ox) * sin / scale + (y - oy) * cos / scale
+    // evaluated exactly in 16.16 fixed point. Each row first solves for the
+    // span of x that lands inside the source clip window, so the inner loops
+    // only step u and v and never test bounds.
+    int64_t du = _rotozoom_fixed(cosAngle / scale);
+    int64_t dv = _rotozoom_fixed(-sinAngle / scale);
 
-    mp_float_t rowu = startu + miny * duCol;
-    mp_float_t rowv = startv + miny * dvCol;
+    int64_t clip0_u = (int64_t)source_clip0_x << ROTOZOOM_FRACTION_BITS;
+    int64_t clip1_u = (int64_t)source_clip1_x << ROTOZOOM_FRACTION_BITS;
+    int64_t clip0_v = (int64_t)source_clip0_y << ROTOZOOM_FRACTION_BITS;
+    int64_t clip1_v = (int64_t)source_clip1_y << ROTOZOOM_FRACTION_BITS;
 
-    displayio_area_t dirty_area = {minx, miny, maxx + 1, maxy + 1, NULL};
-    displayio_bitmap_set_dirty_area(self, &dirty_area);
+    bool same_depth = self->bits_per_value == source->bits_per_value;
+    uint8_t *source_data = (uint8_t *)source->data;
+    size_t source_stride = source->stride * sizeof(uint32_t);
 
     for (y = miny; y <= maxy; y++) {
-        mp_float_t u = rowu + minx * duRow;
-        mp_float_t v = rowv + minx * dvRow;
-        for (x = minx; x <= maxx; x++) {
-            if (u >= source_clip0_x && u < source_clip1_x && v >= source_clip0_y && v < source_clip1_y) {
-                uint32_t c = common_hal_displayio_bitmap_get_pixel(source, (int)u, (int)v);
+        // u and v at x = 0 on this row
+        int64_t row_u = ((int64_t)px << ROTOZOOM_FRACTION_BITS) - ox * du + (y - oy) * -dv;
+        int64_t row_v = ((int64_t)py << ROTOZOOM_FRACTION_BITS) - ox * dv + (y - oy) * du;
+
+        int64_t x0 = minx, x1 = maxx;
+        _rotozoom_clip_span(row_u, du, clip0_u, clip1_u, &x0, &x1);
+        _rotozoom_clip_span(row_v, dv, clip0_v, clip1_v, &x0, &x1);
+        if (x0 > x1) {
+            continue;
+        }
+
+        // Within the span both coordinates are small and non-negative, so the
+        // increments can run in 32 bits. Unsigned arithmetic keeps the step
+        // past the last pixel well defined.
+        uint32_t u = (uint32_t)(row_u + x0 * du);
+        uint32_t v = (uint32_t)(row_v + x0 * dv);
+        uint32_t step_u = (uint32_t)du;
+        uint32_t step_v = (uint32_t)dv;
+        int16_t count = x1 - x0 + 1;
+
+        if (same_depth && self->bits_per_value == 8) {
+            uint8_t *dest = (uint8_t *)(self->data + y * self->stride) + x0;
+            for (; count > 0; count--, dest++, u += step_u, v += step_v) {
+                uint8_t c = source_data[(v >> ROTOZOOM_FRACTION_BITS) * source_stride + (u >> ROTOZOOM_FRACTION_BITS)];
+                if (skip_index_none || c != skip_index) {
+                    *dest = c;
+                }
+            }
+        } else if (same_depth && self->bits_per_value == 16) {
+            uint16_t *dest = (uint16_t *)(self->data + y * self->stride) + x0;
+            for (; count > 0; count--, dest++, u += step_u, v += step_v) {
+                uint16_t c = ((uint16_t *)(source_data + (v >> ROTOZOOM_FRACTION_BITS) * source_stride))[u >> ROTOZOOM_FRACTION_BITS];
+                if (skip_index_none || c != skip_index) {
+                    *dest = c;
+                }
+            }
+        } else {
+            for (x = x0; count > 0; count--, x++, u += step_u, v += step_v) {
+                uint32_t c = common_hal_displayio_bitmap_get_pixel(source, u >> ROTOZOOM_FRACTION_BITS, v >> ROTOZOOM_FRACTION_BITS);
                 if ((skip_index_none) || (c != skip_index)) {
                     displayio_bitmap_write_pixel(self, x, y, c);
                 }
             }
-            u += duRow;
-            v += dvRow;
         }
-        rowu += duCol;
-        rowv += dvCol;
     }
 }
 
@@ -218,12 +306,66 @@ void common_hal_bitmaptools_fill_region(displayio_bitmap_t *destination,
     displayio_area_t bitmap_area = { 0, 0, destination->width, destination->height, NULL };
     displayio_area_compute_overlap(&area, &bitmap_area, &area);
 
+    if (area.x1 >= area.x2 || area.y1 >= area.y2) {
+        return;
+    }
+
     // update the dirty rectangle
     displayio_bitmap_set_dirty_area(destination, &area);
 
-    int16_t x, y;
-    for (x = area.x1; x < area.x2; x++) {
-        for (y = area.y1; y < area.y2; y++) {
+    uint8_t bits = destination->bits_per_value;
+    size_t stride = destination->stride * sizeof(uint32_t);
+    uint8_t *row = (uint8_t *)destination->data + area.y1 * stride;
+    int16_t height = area.y2 - area.y1;
+
+    if (bits >= 8) {
+        // Fill the first row, then copy it into the rest.
+        size_t bytes_per_value = bits / 8;
+        uint8_t *start = row + area.x1 * bytes_per_value;
+        size_t len = (area.x2 - area.x1) * bytes_per_value;
+        if (bits == 8) {
+            memset(start, value, len);
+        } else if (bits == 16) {
+            uint16_t *p = (uint16_t *)start;
+            for (int16_t x = area.x1; x < area.x2; x++) {
+                *p++ = value;
+            }
+        } else {
+            uint32_t *p = (uint32_t *)start;
+            for (int16_t x = area.x1; x < area.x2; x++) {
+                *p++ = value;
+            }
+        }
+        for (int16_t y = 1; y < height; y++) {
+            memcpy(start + y * stride, start, len);
+        }
+        return;
+    }
+
+    // Repeat the value across a byte so whole bytes can be set at once.
+    uint8_t packed = value;
+    for (uint8_t b = bits; b < 8; b *= 2) {
+        packed |= packed << b;
+    }
+
+    if (area.x1 == 0 && area.x2 == destination->width) {
+        // Whole rows are contiguous, row padding included.
+        memset(row, packed, height * stride);
+        return;
+    }
+
+    // Pixels sharing a byte with pixels outside the region are written one by
+    // one; the bytes between them are set directly.
+    int16_t head_end = MIN((int16_t)((area.x1 + destination->x_mask) & ~destination->x_mask), area.x2);
+    int16_t tail_start = MAX((int16_t)(area.x2 & ~destination->x_mask), head_end);
+    size_t first_byte = head_end >> destination->x_shift;
+    size_t middle_len = (tail_start >> destination->x_shift) - first_byte;
+    for (int16_t y = area.y1; y < area.y2; y++, row += stride) {
+        for (int16_t x = area.x1; x < head_end; x++) {
+            displayio_bitmap_write_pixel(destination, x, y, value);
+        }
+        memset(row + first_byte, packed, middle_len);
+        for (int16_t x = tail_start; x < area.x2; x++) {
             displayio_bitmap_write_pixel(destination, x, y, value);
         }
     }
@@ -1034,6 +1176,97 @@ void common_hal_bitmaptools_draw_circle(displayio_bitmap_t *destination,
     draw_circle(destination, x, y, radius, value);
 }
 
+// Bits within a sub-byte row run from the most significant bit of each byte,
+// so a run of pixels is a run of bits in a big-endian bit stream.
+static uint8_t _read_bits(const uint8_t *src, uint8_t bit, uint8_t count) {
+    uint16_t window = src[0] << 8;
+    if (bit + count > 8) {
+        window |= src[1];
+    }
+    return (window >> (16 - bit - count)) & ((1 << count) - 1);
+}
+
+static void _write_bits(uint8_t *dst, uint8_t bit, uint8_t count, uint8_t value) {
+    uint8_t shift = 8 - bit - count;
+    uint8_t mask = ((1 << count) - 1) << shift;
+    *dst = (*dst & ~mask) | (value << shift);
+}
+
+static void _copy_bits(uint8_t *dst, size_t dst_bit, const uint8_t *src, size_t src_bit, size_t count) {
+    dst += dst_bit / 8;
+    dst_bit %= 8;
+    src += src_bit / 8;
+    src_bit %= 8;
+
+    // Bring the destination up to a byte boundary.
+    if (dst_bit != 0) {
+        uint8_t n = MIN(8 - dst_bit, count);
+        _write_bits(dst, dst_bit, n, _read_bits(src, src_bit, n));
+        dst++;
+        src_bit += n;
+        src += src_bit / 8;
+        src_bit %= 8;
+        count -= n;
+    }
+
+    size_t whole_bytes = count / 8;
+    if (src_bit == 0) {
+        memmove(dst, src, whole_bytes);
+    } else {
+        uint8_t right = 8 - src_bit;
+        for (size_t i = 0; i < whole_bytes; i++) {
+            dst[i] = (src[i] << src_bit) | (src[i + 1] >> right);
+        }
+    }
+    dst += whole_bytes;
+    src += whole_bytes;
+    count %= 8;
+
+    if (count > 0) {
+        _write_bits(dst, 0, count, _read_bits(src, src_bit, count));
+    }
+}
+
+// Copies rows between bitmaps of the same depth without going through the
+// per-pixel accessors. The region must already be clipped to both bitmaps.
+static void _blit_rows(displayio_bitmap_t *destination, displayio_bitmap_t *source, int16_t x, int16_t y,
+    int16_t x1, int16_t y1, int16_t width, int16_t height, uint32_t skip_index, bool skip_index_none) {
+    uint8_t bits = destination->bits_per_value;
+    size_t dest_stride = destination->stride * sizeof(uint32_t);
+    size_t source_stride = source->stride * sizeof(uint32_t);
+    // Walk rows and pixels away from the destination in case the two overlap.
+    int16_t row_step = y > y1 ? -1 : 1;
+    int16_t first_row = y > y1 ? height - 1 : 0;
+    int16_t first_x = x > x1 ? width - 1 : 0;
+    int16_t x_step = x > x1 ? -1 : 1;
+
+    for (int16_t n = height, j = first_row; n > 0; n--, j += row_step) {
+        uint8_t *dest_row = (uint8_t *)destination->data + (y + j) * dest_stride;
+        const uint8_t *source_row = (const uint8_t *)source->data + (y1 + j) * source_stride;
+        if (bits < 8) {
+            _copy_bits(dest_row, x * bits, source_row, x1 * bits, width * bits);
+        } else if (skip_index_none) {
+            memmove(dest_row + x * (bits / 8), source_row + x1 * (bits / 8), width * (bits / 8));
+        } else if (bits == 8) {
+            uint8_t *dest = dest_row + x;
+            const uint8_t *src = source_row + x1;
+            for (int16_t m = width, i = first_x; m > 0; m--, i += x_step) {
+                if (src[i] != skip_index) {
+                    dest[i] = src[i];
+                }
+            }
+        } else {
+            uint16_t *dest = (uint16_t *)dest_row + x;
+            const uint16_t *src = (const uint16_t *)source_row + x1;
+            for (int16_t m = width, i = first_x; m > 0; m--, i += x_step) {
+                if (src[i] != skip_index) {
+                    dest[i] = src[i];
+                }
+            }
+        }
+    }
+}
+
 void common_hal_bitmaptools_blit(displayio_bitmap_t *destination, displayio_bitmap_t *source, int16_t x, int16_t y,
     int16_t x1, int16_t y1, int16_t x2, int16_t y2, uint32_t skip_source_index, bool skip_source_index_none, uint32_t skip_dest_index,
     bool skip_dest_index_none) {
@@ -1046,19 +1279,42 @@ void common_hal_bitmaptools_blit(displayio_bitmap_t *destination, displayio_bitm
     // If skip_value is `None`, then all pixels are copied.
     // This function assumes input checks were performed for pixel index entries.
 
-    // Update the dirty area
-    int16_t dirty_x_max = (x + (x2 - x1));
-    if (dirty_x_max > destination->width) {
-        dirty_x_max = destination->width;
+    // Clip the copy to the destination, moving the source corner along with it
+    if (x < 0) {
+        x1 -= x;
+        x = 0;
+    }
+    if (y < 0) {
+        y1 -= y;
+        y = 0;
+    }
+    if (x2 - x1 > destination->width - x) {
+        x2 = x1 + (destination->width - x);
     }
-    int16_t dirty_y_max = y + (y2 - y1);
-    if (dirty_y_max > destination->height) {
-        dirty_y_max = destination->height;
+    if (y2 - y1 > destination->height - y) {
+        y2 = y1 + (destination->height - y);
     }
+    if (x2 <= x1 || y2 <= y1) {
+        return;
+    }
+    int16_t width = x2 - x1;
+    int16_t height = y2 - y1;
 
-    displayio_area_t a = { x, y, dirty_x_max, dirty_y_max, NULL};
+    // Update the dirty area
+    displayio_area_t a = { x, y, x + width, y + height, NULL};
     displayio_bitmap_set_dirty_area(destination, &a);
 
+    // Whole rows can be copied when both bitmaps share a depth. Sub-byte rows
+    // are copied as bit streams, which can't run backwards within a row, so
+    // blits along a single row of one bitmap take the pixel path.
+    uint8_t bits = destination->bits_per_value;
+    if (bits == source->bits_per_value && skip_dest_index_none &&
+        (skip_source_index_none || bits == 8 || bits == 16) &&
+        (bits >= 8 || source != destination || y != y1)) {
+        _blit_rows(destination, source, x, y, x1, y1, width, height, skip_source_index, skip_source_index_none);
+        return;
+    }
+
     bool x_reverse = false;
     bool y_reverse = false;
 
@@ -1071,30 +1327,26 @@ void common_hal_bitmaptools_blit(displayio_bitmap_t *destination, displayio_bitm
     }
 
     // simplest version - use internal functions for get/set pixels
-    for (int16_t i = 0; i < (x2 - x1); i++) {
+    for (int16_t i = 0; i < width; i++) {
 
         const int xs_index = x_reverse ? ((x2) - i - 1) : x1 + i; // x-index into the source bitmap
-        const int xd_index = x_reverse ? ((x + (x2 - x1)) - i - 1) : x + i; // x-index into the destination bitmap
-
-        if ((xd_index >= 0) && (xd_index < destination->width)) {
-            for (int16_t j = 0; j < (y2 - y1); j++) {
-
-                const int ys_index = y_reverse ? ((y2) - j - 1) : y1 + j;  // y-index into the source bitmap
-                const int yd_index = y_reverse ? ((y + (y2 - y1)) - j - 1) : y + j; // y-index into the destination bitmap
-
-                if ((yd_index >= 0) && (yd_index < destination->height)) {
-                    uint32_t value = common_hal_displayio_bitmap_get_pixel(source, xs_index, ys_index);
-                    if (skip_dest_index_none) { // if skip_dest_index is none, then only check source skip
-                        if ((skip_source_index_none) || (value != skip_source_index)) {   // write if skip_value_none is True
-                            displayio_bitmap_write_pixel(destination, xd_index, yd_index, value);
-                        }
-                    } else { // check dest_value index against skip_dest_index and skip if they match
-                        uint32_t dest_value = common_hal_displayio_bitmap_get_pixel(destination, xd_index, yd_index);
-                        if (dest_value != skip_dest_index) {
-                            if ((skip_source_index_none) || (value != skip_source_index)) {   // write if skip_value_none is True
-                                displayio_bitmap_write_pixel(destination, xd_index, yd_index, value);
-                            }
-                        }
+        const int xd_index = x_reverse ? ((x + width) - i - 1) : x + i; // x-index into the destination bitmap
+
+        for (int16_t j = 0; j < height; j++) {
+
+            const int ys_index = y_reverse ? ((y2) - j - 1) : y1 + j;  // y-index into the source bitmap
+            const int yd_index = y_reverse ? ((y + height) - j - 1) : y + j; // y-index into the destination bitmap
+
+            uint32_t value = common_hal_displayio_bitmap_get_pixel(source, xs_index, ys_index);
+            if (skip_dest_index_none) { // if skip_dest_index is none, then only check source skip
+                if ((skip_source_index_none) || (value != skip_source_index)) {   // write if skip_value_none is True
+                    displayio_bitmap_write_pixel(destination, xd_index, yd_index, value);
+                }
+            } else { // check dest_value index against skip_dest_index and skip if they match
+                uint32_t dest_value = common_hal_displayio_bitmap_get_pixel(destination, xd_index, yd_index);
+                if (dest_value != skip_dest_index) {
+                    if ((skip_source_index_none) || (value != skip_source_index)) {   // write if skip_value_none is True
+                        displayio_bitmap_write_pixel(destination, xd_index, yd_index, value);
                     }
                 }
             }
@@ -189,6 +189,10 @@ mp_obj_t common_hal_busdisplay_busdisplay_get_bus(busdisplay_busdisplay_obj_t *s
     return self->bus.bus;
 }
 
+mp_obj_t common_hal_busdisplay_busdisplay_get_refresh_pixels(busdisplay_busdisplay_obj_t *self) {
+    return displayio_display_core_get_refresh_pixels(&self->core);
+}
+
 mp_obj_t common_hal_busdisplay_busdisplay_get_root_group(busdisplay_busdisplay_obj_t *self) {
     if (self->core.current_group == NULL) {
         return mp_const_none;
@@ -196,16 +200,6 @@ mp_obj_t common_hal_busdisplay_busdisplay_get_root_group(busdisplay_busdisplay_o
     return self->core.current_group;
 }
 
-static const displayio_area_t *_get_refresh_areas(busdisplay_busdisplay_obj_t *self) {
-    if (self->core.full_refresh) {
-        self->core.area.next = NULL;
-        return &self->core.area;
-    } else if (self->core.current_group != NULL) {
-        return displayio_group_get_refresh_areas(self->core.current_group, NULL);
-    }
-    return NULL;
-}
-
 static void _send_pixels(busdisplay_busdisplay_obj_t *self, uint8_t *pixels, uint32_t length) {
     if (!self->bus.data_as_commands) {
         self->bus.send(self->bus.bus, DISPLAY_COMMAND, CHIP_SELECT_TOGGLE_EVERY_BYTE, &self->write_ram_command, 1);
@@ -311,7 +305,7 @@ static void _refresh_display(busdisplay_busdisplay_obj_t *self) {
         return;
     }
     displayio_display_core_start_refresh(&self->core);
-    const displayio_area_t *current_area = _get_refresh_areas(self);
+    const displayio_area_t *current_area = displayio_display_core_get_refresh_areas(&self->core);
     while (current_area != NULL) {
         _refresh_area(self, current_area);
         current_area = current_area->next;
@@ -347,6 +347,10 @@ void displayio_colorconverter_convert(displayio_colorconverter_t *self, const _d
 
 
 
+bool displayio_colorconverter_is_opaque(displayio_colorconverter_t *self) {
+    return self->transparent_color == NO_TRANSPARENT_COLOR;
+}
+
 // Currently no refresh logic is needed for a ColorConverter.
 bool displayio_colorconverter_needs_refresh(displayio_colorconverter_t *self) {
     return false;
@@ -25,6 +25,7 @@ typedef struct displayio_colorconverter {
     uint32_t cached_output_color;
 } displayio_colorconverter_t;
 
+bool displayio_colorconverter_is_opaque(displayio_colorconverter_t *self);
 bool displayio_colorconverter_needs_refresh(displayio_colorconverter_t *self);
 void displayio_colorconverter_finish_refresh(displayio_colorconverter_t *self);
 void displayio_colorconverter_convert(displayio_colorconverter_t *self, const _displayio_colorspace_t *colorspace, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color);
@@ -6,6 +6,7 @@
 
 #include "shared-bindings/displayio/Group.h"
 
+#include "py/gc.h"
 #include "py/runtime.h"
 #include "py/objlist.h"
 #include "shared-bindings/displayio/TileGrid.h"
@@ -14,6 +15,10 @@
 #include "shared-bindings/vectorio/VectorShape.h"
 #endif
 
+// Changed whenever the members of any Group change, which makes every render
+// list stale.
+static uint32_t render_list_generation = 1;
+
 static void check_readonly(displayio_group_t *self) {
     if (self->readonly) {
         mp_raise_RuntimeError(MP_ERROR_TEXT("Read-only"));
@@ -328,10 +333,12 @@ static void _remove_layer(displayio_group_t *self, size_t index) {
 void common_hal_displayio_group_insert(displayio_group_t *self, size_t index, mp_obj_t layer) {
     _add_layer(self, layer);
     mp_obj_list_insert(self->members, index, layer);
+    render_list_generation++;
 }
 
 mp_obj_t common_hal_displayio_group_pop(displayio_group_t *self, size_t index) {
     _remove_layer(self, index);
+    render_list_generation++;
     return mp_obj_list_pop(self->members, index);
 }
 
@@ -354,6 +361,25 @@ void common_hal_displayio_group_set(displayio_group_t *self, size_t index, mp_ob
     _add_layer(self, layer);
     _remove_layer(self, index);
     mp_obj_list_store(self->members, MP_OBJ_NEW_SMALL_INT(index), layer);
+    render_list_generation++;
+}
+
+void common_hal_displayio_group_sort(displayio_group_t *self, mp_obj_t key, bool reverse) {
+    check_readonly(self);
+    mp_obj_t dest[6];
+    mp_load_method(MP_OBJ_FROM_PTR(self->members), MP_QSTR_sort, dest);
+    dest[2] = MP_OBJ_NEW_QSTR(MP_QSTR_key);
+    dest[3] = key;
+    dest[4] = MP_OBJ_NEW_QSTR(MP_QSTR_reverse);
+    dest[5] = mp_obj_new_bool(reverse);
+    mp_call_method_n_kw(0, 2, dest);
+    // Sorting changes the order that members are drawn in, so redraw where they overlap.
+    render_list_generation++;
+    displayio_area_t group_area;
+    if (displayio_group_get_previous_area(self, &group_area)) {
+        displayio_area_copy(&group_area, &self->dirty_area);
+        self->item_removed = true;
+    }
 }
 
 void displayio_group_construct(displayio_group_t *self, mp_obj_list_t *members, uint32_t scale, mp_int_t x, mp_int_t y) {
@@ -364,103 +390,333 @@ void displayio_group_construct(displayio_group_t *self, mp_obj_list_t *members,
     self->scale = scale;
     self->in_group = false;
     self->readonly = false;
+    self->render_list = NULL;
+    self->render_list_len = 0;
+    self->render_list_generation = 0;
+}
+
+// A member of the tree below a Group with its type resolved, so that refreshes
+// don't look it up again for every area.
+enum {
+    RENDER_TILEGRID,
+    RENDER_GROUP,
+    #if CIRCUITPY_VECTORIO
+    RENDER_DRAW,
+    #endif
+};
+
+typedef struct _displayio_render_entry {
+    void *layer;
+    #if CIRCUITPY_VECTORIO
+    const vectorio_draw_protocol_impl_t *draw;
+    #endif
+    // TileGrid: where it is drawn.
+    const displayio_area_t *bounds;
+    // Group: the number of entries for its members, which follow it.
+    uint16_t descendants;
+    uint8_t kind;
+} displayio_render_entry_t;
+
+static bool _make_render_entry(mp_obj_t member, displayio_render_entry_t *entry) {
+    entry->bounds = NULL;
+    entry->descendants = 0;
+    #if CIRCUITPY_VECTORIO
+    const vectorio_draw_protocol_t *draw_protocol = mp_proto_get(MP_QSTR_protocol_draw, member);
+    if (draw_protocol != NULL) {
+        entry->layer = draw_protocol->draw_get_protocol_self(member);
+        entry->draw = draw_protocol->draw_protocol_impl;
+        entry->kind = RENDER_DRAW;
+        return true;
+    }
+    #endif
+    mp_obj_t layer = mp_obj_cast_to_native_base(member, &displayio_tilegrid_type);
+    if (layer != MP_OBJ_NULL) {
+        entry->layer = layer;
+        entry->bounds = &((displayio_tilegrid_t *)layer)->current_area;
+        entry->kind = RENDER_TILEGRID;
+        return true;
+    }
+    layer = mp_obj_cast_to_native_base(member, &displayio_group_type);
+    if (layer != MP_OBJ_NULL) {
+        entry->layer = layer;
+        entry->kind = RENDER_GROUP;
+        return true;
+    }
+    return false;
+}
+
+static size_t _count_render_entries(displayio_group_t *self) {
+    size_t count = 0;
+    for (size_t i = 0; i < self->members->len; i++) {
+        displayio_render_entry_t entry;
+        if (!_make_render_entry(self->members->items[i], &entry)) {
+            continue;
+        }
+        count++;
+        if (entry.kind == RENDER_GROUP) {
+            count += _count_render_entries(entry.layer);
+        }
+    }
+    return count;
+}
+
+// Adds the members from the top down, each Group followed by its own members.
+static size_t _add_render_entries(displayio_group_t *self, displayio_render_entry_t *entries, size_t count) {
+    for (int32_t i = self->members->len - 1; i >= 0; i--) {
+        displayio_render_entry_t *entry = &entries[count];
+        if (!_make_render_entry(self->members->items[i], entry)) {
+            continue;
+        }
+        count++;
+        if (entry->kind == RENDER_GROUP) {
+            size_t first = count;
+            count = _add_render_entries(entry->layer, entries, count);
+            entry->descendants = count - first;
+        }
+    }
+    return count;
+}
+
+// Returns the render list of a display's root Group, rebuilding it if any Group
+// changed since. Returns NULL for read-only Groups, such as the terminal, and
+// when the list can't be allocated; the tree is then walked directly.
+static const displayio_render_entry_t *_get_render_list(displayio_group_t *self) {
+    if (self->readonly || !gc_alloc_possible()) {
+        return NULL;
+    }
+    if (self->render_list != NULL && self->render_list_generation == render_list_generation) {
+        return self->render_list;
+    }
+    size_t len = _count_render_entries(self);
+    if (len == 0 || len > UINT16_MAX) {
+        return NULL;
+    }
+    if (self->render_list == NULL || self->render_list_len != len) {
+        displayio_render_entry_t *render_list = m_renew_maybe(displayio_render_entry_t,
+            self->render_list, self->render_list_len, len, true);
+        if (render_list == NULL) {
+            return NULL;
+        }
+        self->render_list = render_list;
+        self->render_list_len = len;
+    }
+    _add_render_entries(self, self->render_list, 0);
+    self->render_list_generation = render_list_generation;
+    return self->render_list;
+}
+
+static bool _fill_entry(const displayio_render_entry_t *entry, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
+    #if CIRCUITPY_VECTORIO
+    if (entry->kind == RENDER_DRAW) {
+        return entry->draw->draw_fill_area(entry->layer, colorspace, area, mask, buffer);
+    }
+    #endif
+    displayio_area_t overlap;
+    if (!displayio_area_compute_overlap(area, entry->bounds, &overlap)) {
+        return false;
+    }
+    return displayio_tilegrid_fill_area(entry->layer, colorspace, area, mask, buffer);
+}
+
+static bool _fill_area(displayio_group_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
+    if (self->hidden) {
+        return false;
+    }
+    for (int32_t i = self->members->len - 1; i >= 0; i--) {
+        displayio_render_entry_t entry;
+        if (!_make_render_entry(self->members->items[i], &entry)) {
+            continue;
+        }
+        if (entry.kind == RENDER_GROUP) {
+            if (_fill_area(entry.layer, colorspace, area, mask, buffer)) {
+                return true;
+            }
+        } else if (_fill_entry(&entry, colorspace, area, mask, buffer)) {
+            return true;
+        }
+    }
+    return false;
 }
 
 bool displayio_group_fill_area(displayio_group_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
     // Track if any of the layers finishes filling in the given area. We can ignore any remaining
     // layers at that point.
-    if (self->hidden == false) {
-        for (int32_t i = self->members->len - 1; i >= 0; i--) {
-            mp_obj_t layer;
-            #if CIRCUITPY_VECTORIO
-            const vectorio_draw_protocol_t *draw_protocol = mp_proto_get(MP_QSTR_protocol_draw, self->members->items[i]);
-            if (draw_protocol != NULL) {
-                layer = draw_protocol->draw_get_protocol_self(self->members->items[i]);
-                if (draw_protocol->draw_protocol_impl->draw_fill_area(layer, colorspace, area, mask, buffer)) {
-                    return true;
-                }
-                continue;
-            }
-            #endif
-            layer = mp_obj_cast_to_native_base(
-                self->members->items[i], &displayio_tilegrid_type);
-            if (layer != MP_OBJ_NULL) {
-                if (displayio_tilegrid_fill_area(layer, colorspace, area, mask, buffer)) {
-                    return true;
-                }
-                continue;
-            }
-            layer = mp_obj_cast_to_native_base(
-                self->members->items[i], &displayio_group_type);
-            if (layer != MP_OBJ_NULL) {
-                if (displayio_group_fill_area(layer, colorspace, area, mask, buffer)) {
-                    return true;
-                }
-                continue;
+    const displayio_render_entry_t *render_list = _get_render_list(self);
+    if (render_list == NULL) {
+        return _fill_area(self, colorspace, area, mask, buffer);
+    }
+    if (self->hidden) {
+        return false;
+    }
+    for (size_t i = 0; i < self->render_list_len; i++) {
+        const displayio_render_entry_t *entry = &render_list[i];
+        if (entry->kind == RENDER_GROUP) {
+            if (((displayio_group_t *)entry->layer)->hidden) {
+                i += entry->descendants;
             }
+        } else if (_fill_entry(entry, colorspace, area, mask, buffer)) {
+            return true;
         }
     }
     return false;
 }
 
-void displayio_group_finish_refresh(displayio_group_t *self) {
+static void _finish_refresh_entry(const displayio_render_entry_t *entry) {
+    #if CIRCUITPY_VECTORIO
+    if (entry->kind == RENDER_DRAW) {
+        entry->draw->draw_finish_refresh(entry->layer);
+        return;
+    }
+    #endif
+    if (entry->kind == RENDER_TILEGRID) {
+        displayio_tilegrid_finish_refresh(entry->layer);
+    } else {
+        ((displayio_group_t *)entry->layer)->item_removed = false;
+    }
+}
+
+static void _finish_refresh(displayio_group_t *self) {
     self->item_removed = false;
     for (int32_t i = self->members->len - 1; i >= 0; i--) {
-        mp_obj_t layer;
-        #if CIRCUITPY_VECTORIO
-        const vectorio_draw_protocol_t *draw_protocol = mp_proto_get(MP_QSTR_protocol_draw, self->members->items[i]);
-        if (draw_protocol != NULL) {
-            layer = draw_protocol->draw_get_protocol_self(self->members->items[i]);
-            draw_protocol->draw_protocol_impl->draw_finish_refresh(layer);
+        displayio_render_entry_t entry;
+        if (!_make_render_entry(self->members->items[i], &entry)) {
             continue;
         }
-        #endif
-        layer = mp_obj_cast_to_native_base(
-            self->members->items[i], &displayio_tilegrid_type);
-        if (layer != MP_OBJ_NULL) {
-            displayio_tilegrid_finish_refresh(layer);
-            continue;
+        if (entry.kind == RENDER_GROUP) {
+            _finish_refresh(entry.layer);
+        } else {
+            _finish_refresh_entry(&entry);
         }
-        layer = mp_obj_cast_to_native_base(
-            self->members->items[i], &displayio_group_type);
-        if (layer != MP_OBJ_NULL) {
-            displayio_group_finish_refresh(layer);
-            continue;
+    }
+}
+
+void displayio_group_finish_refresh(displayio_group_t *self) {
+    const displayio_render_entry_t *render_list = _get_render_list(self);
+    if (render_list == NULL) {
+        _finish_refresh(self);
+        return;
+    }
+    self->item_removed = false;
+    for (size_t i = 0; i < self->render_list_len; i++) {
+        _finish_refresh_entry(&render_list[i]);
+    }
+}
+
+// The current areas of opaque TileGrids met while walking the layers from the
+// top down. Dirty areas of lower layers that lie within one of them are hidden.
+#define OCCLUDER_LIMIT (4)
+
+typedef struct {
+    const displayio_area_t *areas[OCCLUDER_LIMIT];
+    size_t count;
+} occluders_t;
+
+static bool _occluded(const occluders_t *occluders, const displayio_area_t *area) {
+    for (size_t i = 0; i < occluders->count; i++) {
+        if (displayio_area_contains(occluders->areas[i], area)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+static void _add_occluder(occluders_t *occluders, const displayio_area_t *area) {
+    if (occluders->count < OCCLUDER_LIMIT) {
+        occluders->areas[occluders->count++] = area;
+        return;
+    }
+    // Keep the largest ones.
+    size_t smallest = 0;
+    for (size_t i = 1; i < OCCLUDER_LIMIT; i++) {
+        if (displayio_area_size(occluders->areas[i]) < displayio_area_size(occluders->areas[smallest])) {
+            smallest = i;
         }
     }
+    if (displayio_area_size(area) > displayio_area_size(occluders->areas[smallest])) {
+        occluders->areas[smallest] = area;
+    }
 }
 
-displayio_area_t *displayio_group_get_refresh_areas(displayio_group_t *self, displayio_area_t *tail) {
-    if (self->item_removed) {
+// Unlinks the occluded areas in the list from head up to, but not including,
+// stop, which is where the list was before the latest layer added to it.
+static displayio_area_t *_remove_occluded(const occluders_t *occluders, displayio_area_t *head, displayio_area_t *stop) {
+    if (occluders->count == 0) {
+        return head;
+    }
+    while (head != stop && _occluded(occluders, head)) {
+        head = (displayio_area_t *)head->next;
+    }
+    if (head == stop) {
+        return head;
+    }
+    displayio_area_t *kept = head;
+    while (kept->next != stop) {
+        if (_occluded(occluders, kept->next)) {
+            kept->next = kept->next->next;
+        } else {
+            kept = (displayio_area_t *)kept->next;
+        }
+    }
+    return head;
+}
+
+// Adds the dirty areas of a Group's own removed items, which only layers above
+// the whole Group can hide.
+static displayio_area_t *_group_refresh_areas(displayio_group_t *self, displayio_area_t *tail, const occluders_t *occluders) {
+    if (self->item_removed && !_occluded(occluders, &self->dirty_area)) {
         self->dirty_area.next = tail;
         tail = &self->dirty_area;
     }
+    return tail;
+}
+
+static displayio_area_t *_entry_refresh_areas(const displayio_render_entry_t *entry, displayio_area_t *tail, occluders_t *occluders) {
+    displayio_area_t *layer_tail = tail;
+    #if CIRCUITPY_VECTORIO
+    if (entry->kind == RENDER_DRAW) {
+        tail = entry->draw->draw_get_refresh_areas(entry->layer, tail);
+        return _remove_occluded(occluders, tail, layer_tail);
+    }
+    #endif
+    if (entry->kind == RENDER_GROUP) {
+        return _group_refresh_areas(entry->layer, tail, occluders);
+    }
+    displayio_tilegrid_t *tilegrid = entry->layer;
+    if (!displayio_tilegrid_get_rendered_hidden(tilegrid)) {
+        tail = displayio_tilegrid_get_refresh_areas(tilegrid, tail);
+        tail = _remove_occluded(occluders, tail, layer_tail);
+    }
+    if (displayio_tilegrid_is_opaque(tilegrid)) {
+        _add_occluder(occluders, entry->bounds);
+    }
+    return tail;
+}
 
+static displayio_area_t *_get_refresh_areas(displayio_group_t *self, displayio_area_t *tail, occluders_t *occluders) {
+    tail = _group_refresh_areas(self, tail, occluders);
     for (int32_t i = self->members->len - 1; i >= 0; i--) {
-        mp_obj_t layer;
-        #if CIRCUITPY_VECTORIO
-        const vectorio_draw_protocol_t *draw_protocol = mp_proto_get(MP_QSTR_protocol_draw, self->members->items[i]);
-        if (draw_protocol != NULL) {
-            layer = draw_protocol->draw_get_protocol_self(self->members->items[i]);
-            tail = draw_protocol->draw_protocol_impl->draw_get_refresh_areas(layer, tail);
-            continue;
-        }
-        #endif
-        layer = mp_obj_cast_to_native_base(
-            self->members->items[i], &displayio_tilegrid_type);
-        if (layer != MP_OBJ_NULL) {
-            if (!displayio_tilegrid_get_rendered_hidden(layer)) {
-                tail = displayio_tilegrid_get_refresh_areas(layer, tail);
-            }
+        displayio_render_entry_t entry;
+        if (!_make_render_entry(self->members->items[i], &entry)) {
             continue;
         }
-        layer = mp_obj_cast_to_native_base(
-            self->members->items[i], &displayio_group_type);
-        if (layer != MP_OBJ_NULL) {
-            tail = displayio_group_get_refresh_areas(layer, tail);
-            continue;
+        if (entry.kind == RENDER_GROUP) {
+            tail = _get_refresh_areas(entry.layer, tail, occluders);
+        } else {
+            tail = _entry_refresh_areas(&entry, tail, occluders);
         }
     }
+    return tail;
+}
 
+displayio_area_t *displayio_group_get_refresh_areas(displayio_group_t *self, displayio_area_t *tail) {
+    occluders_t occluders = { .count = 0 };
+    const displayio_render_entry_t *render_list = _get_render_list(self);
+    if (render_list == NULL) {
+        return _get_refresh_areas(self, tail, &occluders);
+    }
+    tail = _group_refresh_areas(self, tail, &occluders);
+    for (size_t i = 0; i < self->render_list_len; i++) {
+        tail = _entry_refresh_areas(&render_list[i], tail, &occluders);
+    }
     return tail;
 }
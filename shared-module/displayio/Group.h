@@ -14,9 +14,16 @@
 #include "shared-module/displayio/area.h"
 #include "shared-module/displayio/Palette.h"
 
+struct _displayio_render_entry;
+
 typedef struct {
     mp_obj_base_t base;
     mp_obj_list_t *members;
+    // The whole tree below a display's root Group in drawing order, rebuilt
+    // after any Group's members change.
+    struct _displayio_render_entry *render_list;
+    uint32_t render_list_generation;
+    uint16_t render_list_len;
     displayio_buffer_transform_t absolute_transform;
     displayio_area_t dirty_area; // Catch all for changed area
     int16_t x;
@@ -11,6 +11,9 @@
 void common_hal_displayio_palette_construct(displayio_palette_t *self, uint16_t color_count, bool dither) {
     self->color_count = color_count;
     self->colors = (_displayio_color_t *)m_malloc(color_count * sizeof(_displayio_color_t));
+    self->native_colors = m_new(uint32_t, color_count);
+    self->native_colorspace = NULL;
+    self->transparent_count = 0;
     self->dither = dither;
 }
 
@@ -23,11 +26,17 @@ bool common_hal_displayio_palette_get_dither(displayio_palette_t *self) {
 }
 
 void common_hal_displayio_palette_make_opaque(displayio_palette_t *self, uint32_t palette_index) {
+    if (self->colors[palette_index].transparent) {
+        self->transparent_count--;
+    }
     self->colors[palette_index].transparent = false;
     self->needs_refresh = true;
 }
 
 void common_hal_displayio_palette_make_transparent(displayio_palette_t *self, uint32_t palette_index) {
+    if (!self->colors[palette_index].transparent) {
+        self->transparent_count++;
+    }
     self->colors[palette_index].transparent = true;
     self->needs_refresh = true;
 }
@@ -45,7 +54,7 @@ void common_hal_displayio_palette_set_color(displayio_palette_t *self, uint32_t
         return;
     }
     self->colors[palette_index].rgb888 = color;
-    self->colors[palette_index].cached_colorspace = NULL;
+    self->native_colorspace = NULL;
     self->needs_refresh = true;
 }
 
@@ -53,34 +62,62 @@ uint32_t common_hal_displayio_palette_get_color(displayio_palette_t *self, uint3
     return self->colors[palette_index].rgb888;
 }
 
+const uint32_t *displayio_palette_get_native_colors(displayio_palette_t *self, const _displayio_colorspace_t *colorspace) {
+    if (self->dither || self->native_colors == NULL) {
+        return NULL;
+    }
+    // Check the grayscale settings because EPaperDisplay will change them on
+    // the same object.
+    if (self->native_colorspace == colorspace &&
+        self->native_grayscale_bit == colorspace->grayscale_bit &&
+        self->native_grayscale == colorspace->grayscale) {
+        return self->native_colors;
+    }
+    displayio_input_pixel_t rgb888_pixel = { 0 };
+    displayio_output_pixel_t output_color;
+    for (uint32_t i = 0; i < self->color_count; i++) {
+        rgb888_pixel.pixel = self->colors[i].rgb888;
+        displayio_convert_color(colorspace, false, &rgb888_pixel, &output_color);
+        self->native_colors[i] = output_color.pixel;
+    }
+    self->native_colorspace = colorspace;
+    self->native_grayscale_bit = colorspace->grayscale_bit;
+    self->native_grayscale = colorspace->grayscale;
+    return self->native_colors;
+}
+
 void displayio_palette_get_color(displayio_palette_t *self, const _displayio_colorspace_t *colorspace, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color) {
     uint32_t palette_index = input_pixel->pixel;
-    if (palette_index > self->color_count || self->colors[palette_index].transparent) {
+    if (palette_index >= self->color_count || self->colors[palette_index].transparent) {
         output_color->opaque = false;
         return;
     }
 
-    // Cache results when not dithering.
-    _displayio_color_t *color = &self->colors[palette_index];
-    // Check the grayscale settings because EPaperDisplay will change them on
-    // the same object.
-    if (!self->dither &&
-        color->cached_colorspace == colorspace &&
-        color->cached_colorspace_grayscale_bit == colorspace->grayscale_bit &&
-        color->cached_colorspace_grayscale == colorspace->grayscale) {
-        output_color->pixel = self->colors[palette_index].cached_color;
+    const uint32_t *native_colors = displayio_palette_get_native_colors(self, colorspace);
+    if (native_colors != NULL) {
+        output_color->pixel = native_colors[palette_index];
         return;
     }
 
     displayio_input_pixel_t rgb888_pixel = *input_pixel;
     rgb888_pixel.pixel = self->colors[palette_index].rgb888;
     displayio_convert_color(colorspace, self->dither, &rgb888_pixel, output_color);
-    if (!self->dither) {
-        color->cached_colorspace = colorspace;
-        color->cached_color = output_color->pixel;
-        color->cached_colorspace_grayscale = colorspace->grayscale;
-        color->cached_colorspace_grayscale_bit = colorspace->grayscale_bit;
+}
+
+// Returns true if every one of the first value_count entries is opaque.
+bool displayio_palette_is_opaque(displayio_palette_t *self, uint32_t value_count) {
+    if (value_count > self->color_count) {
+        return false;
+    }
+    if (self->transparent_count == 0) {
+        return true;
+    }
+    for (uint32_t i = 0; i < value_count; i++) {
+        if (self->colors[i].transparent) {
+            return false;
+        }
     }
+    return true;
 }
 
 bool displayio_palette_needs_refresh(displayio_palette_t *self) {
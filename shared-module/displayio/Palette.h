@@ -28,10 +28,6 @@ typedef struct {
 
 typedef struct {
     uint32_t rgb888;
-    const _displayio_colorspace_t *cached_colorspace;
-    uint32_t cached_color;
-    uint8_t cached_colorspace_grayscale_bit;
-    bool cached_colorspace_grayscale;
     bool transparent; // This may have additional bits added later for blending.
 } _displayio_color_t;
 
@@ -52,13 +48,22 @@ typedef struct {
 typedef struct displayio_palette {
     mp_obj_base_t base;
     _displayio_color_t *colors;
+    // Every color converted for native_colorspace, as the display takes it.
+    uint32_t *native_colors;
+    const _displayio_colorspace_t *native_colorspace;
     uint32_t color_count;
+    uint16_t transparent_count;
+    uint8_t native_grayscale_bit;
+    bool native_grayscale;
     bool needs_refresh;
     bool dither;
 } displayio_palette_t;
 
 
 void displayio_palette_get_color(displayio_palette_t *palette, const _displayio_colorspace_t *colorspace, const displayio_input_pixel_t *input_pixel, displayio_output_pixel_t *output_color);
-;
+// Returns the colors converted for colorspace, indexed by palette entry, or NULL
+// when the palette dithers. Transparency is not applied.
+const uint32_t *displayio_palette_get_native_colors(displayio_palette_t *self, const _displayio_colorspace_t *colorspace);
+bool displayio_palette_is_opaque(displayio_palette_t *self, uint32_t value_count);
 bool displayio_palette_needs_refresh(displayio_palette_t *self);
 void displayio_palette_finish_refresh(displayio_palette_t *self);
@@ -92,6 +92,25 @@ bool displayio_tilegrid_get_rendered_hidden(displayio_tilegrid_t *self) {
     return self->rendered_hidden;
 }
 
+// Returns true if the TileGrid will cover every pixel of its current area.
+bool displayio_tilegrid_is_opaque(displayio_tilegrid_t *self) {
+    if (self->hidden || self->hidden_by_parent || !mp_obj_is_type(self->bitmap, &displayio_bitmap_type)) {
+        return false;
+    }
+    if (self->pixel_shader == mp_const_none) {
+        return true;
+    }
+    if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
+        displayio_bitmap_t *bitmap = self->bitmap;
+        return bitmap->bits_per_value < 16 &&
+               displayio_palette_is_opaque(self->pixel_shader, 1 << bitmap->bits_per_value);
+    }
+    if (mp_obj_is_type(self->pixel_shader, &displayio_colorconverter_type)) {
+        return displayio_colorconverter_is_opaque(self->pixel_shader);
+    }
+    return false;
+}
+
 void common_hal_displayio_tilegrid_set_hidden(displayio_tilegrid_t *self, bool hidden) {
     self->hidden = hidden;
     self->rendered_hidden = false;
@@ -499,6 +518,18 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
         y_shift = temp_shift;
     }
 
+    // A Palette with no transparent color for any bitmap value is a plain
+    // lookup of the colors it already converted.
+    const uint32_t *native_colors = NULL;
+    if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type) &&
+        mp_obj_is_type(self->bitmap, &displayio_bitmap_type)) {
+        displayio_bitmap_t *bitmap = self->bitmap;
+        if (bitmap->bits_per_value < 16 &&
+            displayio_palette_is_opaque(self->pixel_shader, 1 << bitmap->bits_per_value)) {
+            native_colors = displayio_palette_get_native_colors(self->pixel_shader, colorspace);
+        }
+    }
+
     displayio_input_pixel_t input_pixel;
     displayio_output_pixel_t output_pixel;
 
@@ -548,7 +579,9 @@ bool displayio_tilegrid_fill_area(displayio_tilegrid_t *self,
                 tilepalettemapper_tilepalettemapper_get_color(self->pixel_shader, colorspace, &input_pixel, &output_pixel, x_tile_index, y_tile_index);
             }
             #endif
-            if (self->pixel_shader == mp_const_none) {
+            if (native_colors != NULL) {
+                output_pixel.pixel = native_colors[input_pixel.pixel];
+            } else if (self->pixel_shader == mp_const_none) {
                 output_pixel.pixel = input_pixel.pixel;
             } else if (mp_obj_is_type(self->pixel_shader, &displayio_palette_type)) {
                 displayio_palette_get_color(self->pixel_shader, colorspace, &input_pixel, &output_pixel);
@@ -57,6 +57,14 @@ bool displayio_area_compute_overlap(const displayio_area_t *a,
     return true;
 }
 
+// Returns true if inner lies entirely within outer.
+bool displayio_area_contains(const displayio_area_t *outer, const displayio_area_t *inner) {
+    return outer->x1 <= inner->x1 &&
+           outer->y1 <= inner->y1 &&
+           outer->x2 >= inner->x2 &&
+           outer->y2 >= inner->y2;
+}
+
 bool displayio_area_empty(const displayio_area_t *a) {
     return (a->x1 == a->x2) || (a->y1 == a->y2);
 }
@@ -47,6 +47,7 @@ void displayio_area_shift(displayio_area_t *area, int16_t dx, int16_t dy);
 bool displayio_area_compute_overlap(const displayio_area_t *a,
     const displayio_area_t *b,
     displayio_area_t *overlap);
+bool displayio_area_contains(const displayio_area_t *outer, const displayio_area_t *inner);
 uint16_t displayio_area_width(const displayio_area_t *area);
 uint16_t displayio_area_height(const displayio_area_t *area);
 uint32_t displayio_area_size(const displayio_area_t *area);
@@ -149,6 +149,146 @@ bool displayio_display_core_start_refresh(displayio_display_core_t *self) {
     return true;
 }
 
+static void _remove_planned_area(displayio_display_core_t *self, size_t i) {
+    self->refresh_area_count--;
+    self->refresh_areas[i] = self->refresh_areas[self->refresh_area_count];
+}
+
+// Adds an area to the plan, merging it with planned areas when rendering the
+// pixels between them is cheaper than refreshing another area. Planned areas
+// may still overlap afterwards.
+static void _plan_area(displayio_display_core_t *self, const displayio_area_t *area) {
+    displayio_area_t a = *area;
+    size_t i = 0;
+    while (i < self->refresh_area_count) {
+        const displayio_area_t *other = &self->refresh_areas[i];
+        uint32_t separate = displayio_area_size(&a) + displayio_area_size(other);
+        displayio_area_t overlap;
+        if (displayio_area_compute_overlap(&a, other, &overlap)) {
+            separate -= displayio_area_size(&overlap);
+        }
+        displayio_area_t merged;
+        displayio_area_union(&a, other, &merged);
+        if (displayio_area_size(&merged) <= separate + CIRCUITPY_DISPLAY_REFRESH_AREA_COST) {
+            // The merged area may now reach areas already passed.
+            a = merged;
+            _remove_planned_area(self, i);
+            i = 0;
+            continue;
+        }
+        i++;
+    }
+    if (self->refresh_area_count == CIRCUITPY_DISPLAY_REFRESH_AREA_LIMIT) {
+        // Make room by merging with the area that grows the least.
+        size_t best = 0;
+        uint32_t best_growth = UINT32_MAX;
+        for (i = 0; i < self->refresh_area_count; i++) {
+            displayio_area_t merged;
+            displayio_area_union(&a, &self->refresh_areas[i], &merged);
+            uint32_t growth = displayio_area_size(&merged) - displayio_area_size(&self->refresh_areas[i]);
+            if (growth < best_growth) {
+                best = i;
+                best_growth = growth;
+            }
+        }
+        displayio_area_union(&a, &self->refresh_areas[best], &a);
+        _remove_planned_area(self, best);
+    }
+    self->refresh_areas[self->refresh_area_count++] = a;
+}
+
+// Cuts each planned area down to the parts not covered by the areas before it.
+// When there is no room for the parts the two areas are merged and the pass
+// starts again, so it ends after at most one merge per area.
+static void _remove_overlaps(displayio_display_core_t *self) {
+    size_t i = 1;
+    while (i < self->refresh_area_count) {
+        displayio_area_t *a = &self->refresh_areas[i];
+        size_t j = 0;
+        displayio_area_t overlap;
+        while (j < i && !displayio_area_compute_overlap(a, &self->refresh_areas[j], &overlap)) {
+            j++;
+        }
+        if (j == i) {
+            i++;
+            continue;
+        }
+        // The bands of a above, below, left and right of the overlap.
+        displayio_area_t bands[4];
+        size_t band_count = 0;
+        if (a->y1 < overlap.y1) {
+            bands[band_count++] = (displayio_area_t) {a->x1, a->y1, a->x2, overlap.y1, NULL};
+        }
+        if (overlap.y2 < a->y2) {
+            bands[band_count++] = (displayio_area_t) {a->x1, overlap.y2, a->x2, a->y2, NULL};
+        }
+        if (a->x1 < overlap.x1) {
+            bands[band_count++] = (displayio_area_t) {a->x1, overlap.y1, overlap.x1, overlap.y2, NULL};
+        }
+        if (overlap.x2 < a->x2) {
+            bands[band_count++] = (displayio_area_t) {overlap.x2, overlap.y1, a->x2, overlap.y2, NULL};
+        }
+        if (band_count == 0) {
+            _remove_planned_area(self, i);
+            // Check the area moved into slot i against the earlier ones.
+            continue;
+        }
+        if (self->refresh_area_count + band_count - 1 <= CIRCUITPY_DISPLAY_REFRESH_AREA_LIMIT) {
+            *a = bands[0];
+            for (size_t k = 1; k < band_count; k++) {
+                self->refresh_areas[self->refresh_area_count++] = bands[k];
+            }
+            continue;
+        }
+        displayio_area_union(a, &self->refresh_areas[j], &self->refresh_areas[j]);
+        _remove_planned_area(self, i);
+        i = 1;
+    }
+}
+
+const displayio_area_t *displayio_display_core_get_refresh_areas(displayio_display_core_t *self) {
+    self->refresh_area_count = 0;
+    self->dirty_pixels = 0;
+    self->rendered_pixels = 0;
+    if (self->full_refresh) {
+        self->area.next = NULL;
+        self->dirty_pixels = displayio_area_size(&self->area);
+        self->rendered_pixels = self->dirty_pixels;
+        return &self->area;
+    }
+    if (self->current_group == NULL) {
+        return NULL;
+    }
+    const displayio_area_t *area = displayio_group_get_refresh_areas(self->current_group, NULL);
+    while (area != NULL) {
+        displayio_area_t clipped;
+        if (displayio_display_core_clip_area(self, area, &clipped)) {
+            self->dirty_pixels += displayio_area_size(&clipped);
+            _plan_area(self, &clipped);
+        }
+        area = area->next;
+    }
+    _remove_overlaps(self);
+    if (self->refresh_area_count == 0) {
+        return NULL;
+    }
+    for (size_t i = 0; i < self->refresh_area_count; i++) {
+        self->rendered_pixels += displayio_area_size(&self->refresh_areas[i]);
+        self->refresh_areas[i].next = i + 1 < self->refresh_area_count ? &self->refresh_areas[i + 1] : NULL;
+    }
+    DISPLAYIO_CORE_DEBUG("displayiocore planned %d areas, %d of %d dirty pixels\n",
+        self->refresh_area_count, self->rendered_pixels, self->dirty_pixels);
+    return &self->refresh_areas[0];
+}
+
+mp_obj_t displayio_display_core_get_refresh_pixels(displayio_display_core_t *self) {
+    mp_obj_t counts[2] = {
+        mp_obj_new_int_from_uint(self->dirty_pixels),
+        mp_obj_new_int_from_uint(self->rendered_pixels),
+    };
+    return mp_obj_new_tuple(2, counts);
+}
+
 void displayio_display_core_finish_refresh(displayio_display_core_t *self) {
     if (self->current_group != NULL) {
         DISPLAYIO_CORE_DEBUG("displayiocore group_finish_refresh\n");
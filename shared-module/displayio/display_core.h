@@ -23,6 +23,13 @@ typedef struct {
     uint16_t rotation;
     _displayio_colorspace_t colorspace;
 
+    // The non-overlapping areas the last refresh was planned into, and how
+    // many pixels were marked dirty against how many were rendered.
+    displayio_area_t refresh_areas[CIRCUITPY_DISPLAY_REFRESH_AREA_LIMIT];
+    uint8_t refresh_area_count;
+    uint32_t dirty_pixels;
+    uint32_t rendered_pixels;
+
     bool full_refresh; // New group means we need to refresh the whole display.
     bool refresh_in_progress;
 } displayio_display_core_t;
@@ -44,6 +51,11 @@ void displayio_display_core_set_rotation(displayio_display_core_t *self, int rot
 void release_display_core(displayio_display_core_t *self);
 
 bool displayio_display_core_start_refresh(displayio_display_core_t *self);
+// Returns the areas to render for this refresh, clipped to the display, merged
+// where that is cheaper and otherwise split so that none overlap.
+const displayio_area_t *displayio_display_core_get_refresh_areas(displayio_display_core_t *self);
+// Returns a (dirty, rendered) tuple of pixel counts from the last refresh.
+mp_obj_t displayio_display_core_get_refresh_pixels(displayio_display_core_t *self);
 void displayio_display_core_finish_refresh(displayio_display_core_t *self);
 
 void displayio_display_core_collect_ptrs(displayio_display_core_t *self);
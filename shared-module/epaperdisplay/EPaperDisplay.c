@@ -80,6 +80,15 @@ void common_hal_epaperdisplay_epaperdisplay_construct(epaperdisplay_epaperdispla
     self->refresh_sequence = refresh_sequence;
     self->refresh_sequence_len = refresh_sequence_len;
 
+    // Partial refreshes are off until a partial refresh sequence is provided.
+    self->partial_refresh_sequence = NULL;
+    self->partial_refresh_sequence_len = 0;
+    self->partial_refresh_time = 0;
+    self->milliseconds_per_partial_frame = 0;
+    self->full_refresh_interval = 0;
+    self->partial_refresh_count = 0;
+    self->refreshing_partial = false;
+
     self->busy.base.type = &mp_type_NoneType;
     self->two_byte_sequence_length = two_byte_sequence_length;
     if (busy_pin != NULL) {
@@ -103,17 +112,11 @@ bool common_hal_epaperdisplay_epaperdisplay_set_root_group(epaperdisplay_epaperd
 }
 
 static const displayio_area_t *epaperdisplay_epaperdisplay_get_refresh_areas(epaperdisplay_epaperdisplay_obj_t *self) {
-    if (self->core.full_refresh) {
-        self->core.area.next = NULL;
-        return &self->core.area;
-    }
-    const displayio_area_t *first_area = NULL;
-    if (self->core.current_group != NULL) {
-        first_area = displayio_group_get_refresh_areas(self->core.current_group, NULL);
-    }
+    const displayio_area_t *first_area = displayio_display_core_get_refresh_areas(&self->core);
     if (first_area != NULL && self->bus.row_command == NO_COMMAND) {
         // Do a full refresh if the display doesn't support partial updates.
         self->core.area.next = NULL;
+        self->core.rendered_pixels = displayio_area_size(&self->core.area);
         return &self->core.area;
     }
     return first_area;
@@ -183,6 +186,29 @@ void epaperdisplay_epaperdisplay_change_refresh_mode_parameters(epaperdisplay_ep
     self->milliseconds_per_frame = seconds_per_frame * 1000;
 }
 
+void epaperdisplay_epaperdisplay_set_partial_refresh_parameters(epaperdisplay_epaperdisplay_obj_t *self,
+    const uint8_t *partial_refresh_sequence, uint16_t partial_refresh_sequence_len, mp_float_t partial_refresh_time,
+    mp_float_t seconds_per_partial_frame, uint16_t full_refresh_interval) {
+    self->partial_refresh_sequence = partial_refresh_sequence;
+    self->partial_refresh_sequence_len = partial_refresh_sequence_len;
+    self->partial_refresh_time = partial_refresh_time * 1000;
+    self->milliseconds_per_partial_frame = seconds_per_partial_frame * 1000;
+    self->full_refresh_interval = full_refresh_interval;
+    self->partial_refresh_count = 0;
+}
+
+// Partial refreshes only send the dirty areas so the display must be able to window its RAM. A new
+// root group, or enough partial refreshes in a row, gets a full refresh to clear any ghosting.
+static bool epaperdisplay_epaperdisplay_next_refresh_is_partial(epaperdisplay_epaperdisplay_obj_t *self) {
+    if (self->partial_refresh_sequence == NULL || self->bus.row_command == NO_COMMAND || self->acep) {
+        return false;
+    }
+    if (self->core.full_refresh) {
+        return false;
+    }
+    return self->full_refresh_interval == 0 || self->partial_refresh_count < self->full_refresh_interval;
+}
+
 static void epaperdisplay_epaperdisplay_start_refresh(epaperdisplay_epaperdisplay_obj_t *self) {
     if (!displayio_display_bus_is_free(&self->bus)) {
         // Can't acquire display bus; skip updating this display. Try next display.
@@ -205,20 +231,32 @@ uint32_t common_hal_epaperdisplay_epaperdisplay_get_time_to_refresh(epaperdispla
     if (self->core.last_refresh == 0) {
         return 0;
     }
-    // Refresh at seconds per frame rate.
+    // Refresh at seconds per frame rate. Partial refreshes have their own, usually much shorter,
+    // rate.
+    uint32_t milliseconds_per_frame = self->milliseconds_per_frame;
+    if (epaperdisplay_epaperdisplay_next_refresh_is_partial(self)) {
+        milliseconds_per_frame = self->milliseconds_per_partial_frame;
+    }
     uint32_t elapsed_time = supervisor_ticks_ms64() - self->core.last_refresh;
-    if (elapsed_time > self->milliseconds_per_frame) {
+    if (elapsed_time > milliseconds_per_frame) {
         return 0;
     }
-    return self->milliseconds_per_frame - elapsed_time;
+    return milliseconds_per_frame - elapsed_time;
 }
 
-static void epaperdisplay_epaperdisplay_finish_refresh(epaperdisplay_epaperdisplay_obj_t *self) {
+static void epaperdisplay_epaperdisplay_finish_refresh(epaperdisplay_epaperdisplay_obj_t *self, bool partial) {
     // Actually refresh the display now that all pixel RAM has been updated.
-    send_command_sequence(self, false, self->refresh_sequence, self->refresh_sequence_len);
+    if (partial) {
+        send_command_sequence(self, false, self->partial_refresh_sequence, self->partial_refresh_sequence_len);
+        self->partial_refresh_count++;
+    } else {
+        send_command_sequence(self, false, self->refresh_sequence, self->refresh_sequence_len);
+        self->partial_refresh_count = 0;
+    }
 
     supervisor_enable_tick();
     self->refreshing = true;
+    self->refreshing_partial = partial;
 
     displayio_display_core_finish_refresh(&self->core);
 }
@@ -249,6 +287,10 @@ uint16_t common_hal_epaperdisplay_epaperdisplay_get_rotation(epaperdisplay_epape
     return self->core.rotation;
 }
 
+mp_obj_t common_hal_epaperdisplay_epaperdisplay_get_refresh_pixels(epaperdisplay_epaperdisplay_obj_t *self) {
+    return displayio_display_core_get_refresh_pixels(&self->core);
+}
+
 mp_obj_t common_hal_epaperdisplay_epaperdisplay_get_root_group(epaperdisplay_epaperdisplay_obj_t *self) {
     if (self->core.current_group == NULL) {
         return mp_const_none;
@@ -424,6 +466,7 @@ bool common_hal_epaperdisplay_epaperdisplay_refresh(epaperdisplay_epaperdisplay_
         // Can't acquire display bus; skip updating this display. Try next display.
         return false;
     }
+    bool partial = epaperdisplay_epaperdisplay_next_refresh_is_partial(self);
     const displayio_area_t *current_area = epaperdisplay_epaperdisplay_get_refresh_areas(self);
     if (current_area == NULL) {
         return true;
@@ -431,7 +474,7 @@ bool common_hal_epaperdisplay_epaperdisplay_refresh(epaperdisplay_epaperdisplay_
     if (self->acep) {
         epaperdisplay_epaperdisplay_start_refresh(self);
         _clean_area(self);
-        epaperdisplay_epaperdisplay_finish_refresh(self);
+        epaperdisplay_epaperdisplay_finish_refresh(self, false);
         while (self->refreshing && !mp_hal_is_interrupted()) {
             RUN_BACKGROUND_TASKS;
         }
@@ -445,7 +488,7 @@ bool common_hal_epaperdisplay_epaperdisplay_refresh(epaperdisplay_epaperdisplay_
         epaperdisplay_epaperdisplay_refresh_area(self, current_area);
         current_area = current_area->next;
     }
-    epaperdisplay_epaperdisplay_finish_refresh(self);
+    epaperdisplay_epaperdisplay_finish_refresh(self, partial);
     return true;
 }
 
@@ -456,7 +499,8 @@ void epaperdisplay_epaperdisplay_background(epaperdisplay_epaperdisplay_obj_t *s
             bool busy = common_hal_digitalio_digitalinout_get_value(&self->busy);
             refresh_done = busy != self->busy_state;
         } else {
-            refresh_done = supervisor_ticks_ms64() - self->core.last_refresh > self->refresh_time;
+            uint16_t refresh_time = self->refreshing_partial ? self->partial_refresh_time : self->refresh_time;
+            refresh_done = supervisor_ticks_ms64() - self->core.last_refresh > refresh_time;
         }
         if (refresh_done) {
             supervisor_disable_tick();
@@ -498,6 +542,7 @@ void epaperdisplay_epaperdisplay_collect_ptrs(epaperdisplay_epaperdisplay_obj_t
     gc_collect_ptr((void *)self->start_sequence);
     gc_collect_ptr((void *)self->stop_sequence);
     gc_collect_ptr((void *)self->refresh_sequence);
+    gc_collect_ptr((void *)self->partial_refresh_sequence);
 }
 
 size_t maybe_refresh_epaperdisplay(void) {
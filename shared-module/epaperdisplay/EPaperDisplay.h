@@ -22,11 +22,18 @@ typedef struct {
     const uint8_t *start_sequence;
     const uint8_t *stop_sequence;
     const uint8_t *refresh_sequence;
+    const uint8_t *partial_refresh_sequence;
+    uint32_t milliseconds_per_partial_frame;
     uint16_t start_sequence_len;
     uint16_t stop_sequence_len;
     uint16_t refresh_sequence_len;
+    uint16_t partial_refresh_sequence_len;
     uint16_t start_up_time_ms;
     uint16_t refresh_time;
+    uint16_t partial_refresh_time;
+    // Partial refreshes allowed before a full refresh clears the ghosting. 0 means no limit.
+    uint16_t full_refresh_interval;
+    uint16_t partial_refresh_count;
     uint16_t write_black_ram_command;
     uint16_t write_color_ram_command;
     uint8_t hue;
@@ -34,6 +41,7 @@ typedef struct {
     bool black_bits_inverted;
     bool color_bits_inverted;
     bool refreshing;
+    bool refreshing_partial;
     bool grayscale;
     bool acep;
     bool two_byte_sequence_length;
@@ -42,6 +50,9 @@ typedef struct {
 
 void epaperdisplay_epaperdisplay_change_refresh_mode_parameters(epaperdisplay_epaperdisplay_obj_t *self,
     mp_buffer_info_t *start_sequence, float seconds_per_frame);
+void epaperdisplay_epaperdisplay_set_partial_refresh_parameters(epaperdisplay_epaperdisplay_obj_t *self,
+    const uint8_t *partial_refresh_sequence, uint16_t partial_refresh_sequence_len, mp_float_t partial_refresh_time,
+    mp_float_t seconds_per_partial_frame, uint16_t full_refresh_interval);
 void epaperdisplay_epaperdisplay_background(epaperdisplay_epaperdisplay_obj_t *self);
 void epaperdisplay_epaperdisplay_reset(epaperdisplay_epaperdisplay_obj_t *self);
 void release_epaperdisplay(epaperdisplay_epaperdisplay_obj_t *self);
@@ -105,17 +105,80 @@ mp_obj_t common_hal_framebufferio_framebufferdisplay_get_framebuffer(framebuffer
     return self->framebuffer;
 }
 
-static const displayio_area_t *_get_refresh_areas(framebufferio_framebufferdisplay_obj_t *self) {
-    if (self->core.full_refresh) {
-        self->core.area.next = NULL;
-        return &self->core.area;
-    } else if (self->core.current_group != NULL) {
-        return displayio_group_get_refresh_areas(self->core.current_group, NULL);
+#define MARK_ROW_DIRTY(r) (dirty_row_bitmask[r / 8] |= (1 << (r & 7)))
+
+// Renders the area straight into framebuffer memory. Layers only write the
+// pixels they cover, so the rest are cleared afterwards to match the zeroed
+// buffer of _refresh_area.
+static void _refresh_area_in_place(framebufferio_framebufferdisplay_obj_t *self, const displayio_area_t *clipped, uint8_t *dirty_row_bitmask) {
+    uint8_t bytes_per_pixel = self->core.colorspace.depth / 8;
+    uint8_t *buf = (uint8_t *)self->bufinfo.buf + self->first_pixel_offset;
+    size_t rowstride = self->row_stride;
+    uint16_t width = displayio_area_width(clipped);
+
+    // Rows are only contiguous when the framebuffer has no padding. Otherwise
+    // render one row at a time.
+    uint16_t rows_per_pass = 1;
+    if (width * bytes_per_pixel == rowstride) {
+        rows_per_pass = MAX(1, CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE * 8 / width);
+    }
+    uint32_t mask_length = (rows_per_pass * width / 32) + 1;
+    uint32_t mask[mask_length];
+
+    for (int16_t y = clipped->y1; y < clipped->y2; y += rows_per_pass) {
+        displayio_area_t subrectangle = {
+            .x1 = clipped->x1,
+            .y1 = y,
+            .x2 = clipped->x2,
+            .y2 = MIN(clipped->y2, y + rows_per_pass)
+        };
+        uint8_t *dest = buf + subrectangle.y1 * rowstride + subrectangle.x1 * bytes_per_pixel;
+
+        memset(mask, 0, mask_length * sizeof(mask[0]));
+        displayio_display_core_fill_area(&self->core, &subrectangle, mask, (uint32_t *)dest);
+
+        size_t pixels = displayio_area_size(&subrectangle);
+        for (size_t i = 0; i < pixels; i += 32) {
+            uint32_t covered = mask[i / 32];
+            if (covered == 0xffffffff) {
+                continue;
+            }
+            size_t count = MIN(32, pixels - i);
+            for (size_t k = 0; k < count; k++) {
+                if ((covered & (1u << k)) == 0) {
+                    memset(dest + (i + k) * bytes_per_pixel, 0, bytes_per_pixel);
+                }
+            }
+        }
+
+        for (int16_t row = subrectangle.y1; row < subrectangle.y2; row++) {
+            MARK_ROW_DIRTY(row);
+        }
+
+        #if CIRCUITPY_TINYUSB
+        usb_background();
+        #endif
     }
-    return NULL;
 }
 
-#define MARK_ROW_DIRTY(r) (dirty_row_bitmask[r / 8] |= (1 << (r & 7)))
+// Pixels of 8, 16 or 32 bits that are aligned in the framebuffer can be
+// written by the layers directly. Rendering in place is used when it takes no
+// more passes than going through the area buffer.
+static bool _can_refresh_in_place(framebufferio_framebufferdisplay_obj_t *self, const displayio_area_t *clipped) {
+    uint8_t depth = self->core.colorspace.depth;
+    if (depth != 8 && depth != 16 && depth != 32) {
+        return false;
+    }
+    uint8_t bytes_per_pixel = depth / 8;
+    uintptr_t first_pixel = (uintptr_t)self->bufinfo.buf + self->first_pixel_offset;
+    if (first_pixel % bytes_per_pixel != 0 || self->row_stride % bytes_per_pixel != 0) {
+        return false;
+    }
+    uint16_t width = displayio_area_width(clipped);
+    return width * bytes_per_pixel == self->row_stride ||
+           width >= CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE / bytes_per_pixel;
+}
+
 static bool _refresh_area(framebufferio_framebufferdisplay_obj_t *self, const displayio_area_t *area, uint8_t *dirty_row_bitmask) {
     uint16_t buffer_size = CIRCUITPY_DISPLAY_AREA_BUFFER_SIZE / sizeof(uint32_t); // In uint32_ts
 
@@ -124,6 +187,10 @@ static bool _refresh_area(framebufferio_framebufferdisplay_obj_t *self, const di
     if (!displayio_display_core_clip_area(&self->core, area, &clipped)) {
         return true;
     }
+    if (_can_refresh_in_place(self, &clipped)) {
+        _refresh_area_in_place(self, &clipped, dirty_row_bitmask);
+        return true;
+    }
     uint16_t subrectangles = 1;
 
     // If pixels are packed by row then rows are on byte boundaries
@@ -216,7 +283,7 @@ static void _refresh_display(framebufferio_framebufferdisplay_obj_t *self) {
         return;
     }
     displayio_display_core_start_refresh(&self->core);
-    const displayio_area_t *current_area = _get_refresh_areas(self);
+    const displayio_area_t *current_area = displayio_display_core_get_refresh_areas(&self->core);
     if (current_area) {
         bool transposed = (self->core.rotation == 90 || self->core.rotation == 270);
         int row_count = transposed ? self->core.width : self->core.height;
@@ -333,6 +400,10 @@ void framebufferio_framebufferdisplay_reset(framebufferio_framebufferdisplay_obj
     }
 }
 
+mp_obj_t common_hal_framebufferio_framebufferdisplay_get_refresh_pixels(framebufferio_framebufferdisplay_obj_t *self) {
+    return displayio_display_core_get_refresh_pixels(&self->core);
+}
+
 mp_obj_t common_hal_framebufferio_framebufferdisplay_get_root_group(framebufferio_framebufferdisplay_obj_t *self) {
     if (self->core.current_group == NULL) {
         return mp_const_none;
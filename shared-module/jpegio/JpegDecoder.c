@@ -54,11 +54,24 @@ static void check_jresult(JRESULT j) {
 
 void common_hal_jpegio_jpegdecoder_construct(jpegio_jpegdecoder_obj_t *self) {
     self->data_obj = MP_OBJ_NULL;
+    self->read_buffer = NULL;
+    self->read_buffer_start = self->read_buffer_end = 0;
 }
 
 void common_hal_jpegio_jpegdecoder_close(jpegio_jpegdecoder_obj_t *self) {
     self->data_obj = MP_OBJ_NULL;
     memset(&self->bufinfo, 0, sizeof(self->bufinfo));
+    // Keep the read buffer for the next file, but drop anything left over from this one.
+    self->read_buffer_start = self->read_buffer_end = 0;
+}
+
+void common_hal_jpegio_jpegdecoder_get_scaled_size(jpegio_jpegdecoder_obj_t *self, int scale, int *width, int *height) {
+    if (self->data_obj == MP_OBJ_NULL) {
+        *width = *height = 0;
+        return;
+    }
+    *width = self->decoder.width >> scale;
+    *height = self->decoder.height >> scale;
 }
 
 static mp_obj_t common_hal_jpegio_jpegdecoder_decode_common(jpegio_jpegdecoder_obj_t *self, input_func fun) {
@@ -74,33 +87,59 @@ static mp_obj_t common_hal_jpegio_jpegdecoder_decode_common(jpegio_jpegdecoder_o
     return mp_obj_new_tuple(MP_ARRAY_SIZE(elems), elems);
 }
 
-static size_t file_input(JDEC *jd, uint8_t *dest, size_t len) {
-    jpegio_jpegdecoder_obj_t *self = CONTAINER_OF(jd, jpegio_jpegdecoder_obj_t, decoder);
-
-    if (!dest) {
-        // caller passes NULL to skip data; we need to read over the data.
-        // Don't assume a seekable stream, because we want to decode jpegs
-        // right from a native socket object
-        uint8_t buf[512];
-        size_t total = 0;
-        size_t read;
-        do {
-            size_t to_discard = MIN(len - total, sizeof(buf));
-            read = file_input(jd, buf, to_discard);
-            total += read;
-        } while (read != 0 && total != len);
-        return len;
-    }
-
+static size_t stream_read(jpegio_jpegdecoder_obj_t *self, uint8_t *dest, size_t len) {
     int errcode = 0;
-    size_t result = mp_stream_rw(self->data_obj, dest, len, &errcode, MP_STREAM_RW_READ);
+    // Take whatever a single read returns, so that a socket that has sent the whole image isn't
+    // waited on to fill the rest of the buffer.
+    size_t result = mp_stream_rw(self->data_obj, dest, len, &errcode, MP_STREAM_RW_READ | MP_STREAM_RW_ONCE);
     if (errcode != 0) { // raise our own error in case of I/O failure, it's better than the decoder's error
         mp_raise_OSError(errcode);
     }
     return result;
 }
 
+static size_t file_input(JDEC *jd, uint8_t *dest, size_t len) {
+    jpegio_jpegdecoder_obj_t *self = CONTAINER_OF(jd, jpegio_jpegdecoder_obj_t, decoder);
+
+    // The decoder asks for at most JD_SZBUF bytes at a time. Serve those from a larger buffer so
+    // that the underlying file is read in big blocks. Skipped data goes through the buffer too:
+    // don't assume a seekable stream, because we want to decode jpegs right from a native socket
+    // object.
+    size_t total = 0;
+    while (total < len) {
+        if (self->read_buffer_start == self->read_buffer_end) {
+            size_t remaining = len - total;
+            if (dest && remaining >= JPEGIO_READ_BUFFER_SIZE) {
+                // Large enough to read directly into the destination.
+                size_t read = stream_read(self, dest + total, remaining);
+                if (read == 0) {
+                    break;
+                }
+                total += read;
+                continue;
+            }
+            size_t read = stream_read(self, self->read_buffer, JPEGIO_READ_BUFFER_SIZE);
+            if (read == 0) {
+                break;
+            }
+            self->read_buffer_start = 0;
+            self->read_buffer_end = read;
+        }
+        size_t to_copy = MIN(len - total, (size_t)(self->read_buffer_end - self->read_buffer_start));
+        if (dest) { // passes NULL to skip data
+            memcpy(dest + total, self->read_buffer + self->read_buffer_start, to_copy);
+        }
+        self->read_buffer_start += to_copy;
+        total += to_copy;
+    }
+    return total;
+}
+
 mp_obj_t common_hal_jpegio_jpegdecoder_set_source_file(jpegio_jpegdecoder_obj_t *self, mp_obj_t file_obj) {
+    if (self->read_buffer == NULL) {
+        self->read_buffer = m_malloc(JPEGIO_READ_BUFFER_SIZE);
+    }
+    self->read_buffer_start = self->read_buffer_end = 0;
     self->data_obj = file_obj;
     return common_hal_jpegio_jpegdecoder_decode_common(self, file_input);
 }
@@ -147,16 +186,27 @@ static int bitmap_output(JDEC *jd, void *data, JRECT *rect) {
     int y1 = self->lim.y1 - rect->top;
     int y2 = self->lim.y2 - rect->top;
 
-    if (y2 < y1) {
+    if (y2 <= 0) {
         // The last row in the source image to copy FROM is above of this, so
         // no more pixels on any rows
         return DECODER_INTERRUPT;
     }
 
+    if (y1 <= 0 && self->y - y1 >= self->dest->height) {
+        // This row of blocks, and every one after it, lands below the bitmap
+        return DECODER_INTERRUPT;
+    }
+
+    if (y1 >= src_height) {
+        // The first row in the source image to copy FROM is below this, so
+        // no pixels until a later row of blocks
+        return DECODER_CONTINUE;
+    }
+
     y2 = MIN(y2, src_height);
-    if (x2 < x1) {
-        // The last column in the source image to copy FROM is left of this, so
-        // no more pixels on this row but could be on subsequent rows
+    if (x2 <= 0 || x1 >= src_width) {
+        // The columns in the source image to copy FROM are all left or right of
+        // this, so no more pixels on this block but could be on subsequent ones
         return DECODER_CONTINUE;
     }
     x2 = MIN(x2, src_width);
@@ -174,6 +224,11 @@ static int bitmap_output(JDEC *jd, void *data, JRECT *rect) {
         y1 = 0;
     }
 
+    if (x >= self->dest->width) {
+        // This block lands right of the bitmap
+        return DECODER_CONTINUE;
+    }
+
     // blit takes care of x, y out of range
     assert(x1 >= 0);
     assert(y1 >= 0);
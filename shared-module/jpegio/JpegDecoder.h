@@ -12,12 +12,20 @@
 
 #define TJPGD_WORKSPACE_SIZE 3500
 
+// File and stream sources are read this many bytes at a time, rather than in the decoder's
+// small input chunks.
+#ifndef JPEGIO_READ_BUFFER_SIZE
+#define JPEGIO_READ_BUFFER_SIZE 4096
+#endif
+
 typedef struct jpegio_jpegdecoder_obj {
     mp_obj_base_t base;
     JDEC decoder;
     byte workspace[TJPGD_WORKSPACE_SIZE];
     mp_obj_t data_obj;
     mp_buffer_info_t bufinfo;
+    uint8_t *read_buffer;
+    uint16_t read_buffer_start, read_buffer_end;
     displayio_bitmap_t *dest;
     uint16_t x, y;
     bitmaptools_rect_t lim;
@@ -102,7 +102,7 @@ static void tuh_interrupt_callback(void *data) {
         // calls RUN_BACKGROUND_TASKS.)
         if (!common_hal_busio_spi_try_lock(self->bus)) {
             // Come back to us.
-            background_callback_add(&tuh_callback, tuh_interrupt_callback, (void *)self);
+            background_callback_add_priority(&tuh_callback, tuh_interrupt_callback, (void *)self, BACKGROUND_CALLBACK_PRIORITY_USB);
 
             return;
         }
@@ -118,7 +118,7 @@ static void tuh_interrupt_callback(void *data) {
 void max3421e_interrupt_handler(max3421e_max3421e_obj_t *arg) {
     max3421e_max3421e_obj_t *self = (max3421e_max3421e_obj_t *)arg;
     // Schedule the CP background callback.
-    background_callback_add(&tuh_callback, tuh_interrupt_callback, (void *)self);
+    background_callback_add_priority(&tuh_callback, tuh_interrupt_callback, (void *)self, BACKGROUND_CALLBACK_PRIORITY_USB);
     common_hal_max3421e_max3421e_irq_enabled(self, false);
 }
 
@@ -0,0 +1,509 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#include <string.h>
+
+#include "py/mperrno.h"
+#include "py/runtime.h"
+#include "py/stream.h"
+
+#include "shared-bindings/recordlog/RecordLog.h"
+
+// Each record is stored as a 2 byte length, the data, a CRC-32 of the length
+// and data, and the length again so that the log can be walked backwards. All
+// values are little endian.
+#define RECORD_OVERHEAD (8)
+// Erased flash reads as 0xff, so this length marks the unused end of a block.
+#define RECORD_LENGTH_ERASED (0xffff)
+
+// Each block of a block device starts with a magic number and a sequence
+// number that goes up by one for every block written around the ring. 0 is
+// never used as a sequence number.
+#define BLOCK_MAGIC (0x474f4c52) // "RLOG"
+#define BLOCK_HEADER_SIZE (8)
+
+// Continues the CRC-32 crc, which is 0 to start with, over len more bytes.
+static uint32_t crc32(uint32_t crc, const uint8_t *data, size_t len) {
+    static const uint32_t table[16] = {
+        0x00000000, 0x1db71064, 0x3b6e20c8, 0x26d930ac, 0x76dc4190, 0x6b6b51f4, 0x4db26158, 0x5005713c,
+        0xedb88320, 0xf00f9344, 0xd6d6a3e8, 0xcb61b38c, 0x9b64c2b0, 0x86d3d2d4, 0xa00ae278, 0xbdbdf21c,
+    };
+    crc = ~crc;
+    for (size_t i = 0; i < len; i++) {
+        crc = table[(crc ^ data[i]) & 0xf] ^ (crc >> 4);
+        crc = table[(crc ^ (data[i] >> 4)) & 0xf] ^ (crc >> 4);
+    }
+    return ~crc;
+}
+
+static uint16_t get16(const uint8_t *p) {
+    return p[0] | (p[1] << 8);
+}
+
+static uint32_t get32(const uint8_t *p) {
+    return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static void put16(uint8_t *p, uint16_t value) {
+    p[0] = value;
+    p[1] = value >> 8;
+}
+
+static void put32(uint8_t *p, uint32_t value) {
+    put16(p, value);
+    put16(p + 2, value >> 16);
+}
+
+// Returns the data length of the record at p, or -1 if the avail bytes at p
+// don't start with a complete, valid record.
+static mp_int_t record_length(const uint8_t *p, size_t avail) {
+    if (avail < RECORD_OVERHEAD) {
+        return -1;
+    }
+    size_t len = get16(p);
+    if (len == RECORD_LENGTH_ERASED || len + RECORD_OVERHEAD > avail) {
+        return -1;
+    }
+    if (get16(p + len + 6) != len || get32(p + len + 2) != crc32(0, p, len + 2)) {
+        return -1;
+    }
+    return len;
+}
+
+// Returns the end of the valid records in buf that start at start.
+static size_t scan_records(const uint8_t *buf, size_t start, size_t limit) {
+    while (true) {
+        mp_int_t len = record_length(buf + start, limit - start);
+        if (len < 0) {
+            return start;
+        }
+        start += len + RECORD_OVERHEAD;
+    }
+}
+
+static void check_error(int error) {
+    if (error != 0) {
+        mp_raise_OSError(error);
+    }
+}
+
+// Returns a pointer to len bytes of the file at offset, or NULL if they
+// aren't all part of the log. When reading backwards, the window is placed to
+// end at offset + len so that earlier records are read with it.
+static const uint8_t *file_read(recordlog_recordlog_obj_t *self, uint32_t offset, size_t len, bool backwards) {
+    if (len > self->buffer_size || offset > self->end || len > self->end - offset) {
+        return NULL;
+    }
+    if (self->read_len > 0 && offset >= self->read_start && offset + len <= self->read_start + self->read_len) {
+        return self->read_buffer + (offset - self->read_start);
+    }
+    uint32_t start = offset;
+    if (backwards) {
+        start = offset + len > self->buffer_size ? offset + len - self->buffer_size : 0;
+    }
+    size_t count = MIN(self->buffer_size, self->end - start);
+    int error = 0;
+    self->read_len = 0;
+    mp_stream_seek(self->storage, start, MP_SEEK_SET, &error);
+    check_error(error);
+    count = mp_stream_read_exactly(self->storage, self->read_buffer, count, &error);
+    check_error(error);
+    self->read_start = start;
+    self->read_len = count;
+    if (offset + len > start + count) {
+        return NULL;
+    }
+    return self->read_buffer + (offset - start);
+}
+
+// Checks the record with len bytes of data at offset. A record written with a
+// larger buffer than this one is read and checked in pieces. When data isn't
+// NULL, it is set to a bytes object of the record's data.
+static bool file_record(recordlog_recordlog_obj_t *self, uint32_t offset, size_t len, bool backwards, mp_obj_t *data) {
+    size_t size = len + RECORD_OVERHEAD;
+    const uint8_t *p;
+    if (size <= self->buffer_size) {
+        p = file_read(self, offset, size, backwards);
+        if (p == NULL || record_length(p, size) < 0) {
+            return false;
+        }
+        if (data != NULL) {
+            *data = mp_obj_new_bytes(p + 2, len);
+        }
+        return true;
+    }
+
+    // The end of the record is checked first, before the data is read.
+    p = file_read(self, offset + len + 2, 6, backwards);
+    if (p == NULL || get16(p + 4) != len) {
+        return false;
+    }
+    uint32_t expected = get32(p);
+    p = file_read(self, offset, 2, false);
+    if (p == NULL || get16(p) != len) {
+        return false;
+    }
+    uint32_t crc = crc32(0, p, 2);
+    vstr_t vstr;
+    if (data != NULL) {
+        vstr_init_len(&vstr, len);
+    }
+    for (size_t done = 0; done < len;) {
+        size_t count = MIN(len - done, self->buffer_size);
+        p = file_read(self, offset + 2 + done, count, false);
+        if (p == NULL) {
+            crc = ~expected;
+            break;
+        }
+        crc = crc32(crc, p, count);
+        if (data != NULL) {
+            memcpy(vstr.buf + done, p, count);
+        }
+        done += count;
+    }
+    if (crc != expected) {
+        if (data != NULL) {
+            vstr_clear(&vstr);
+        }
+        return false;
+    }
+    if (data != NULL) {
+        *data = mp_obj_new_bytes_from_vstr(&vstr);
+    }
+    return true;
+}
+
+static void file_mount(recordlog_recordlog_obj_t *self) {
+    int error = 0;
+    mp_off_t size = mp_stream_seek(self->storage, 0, MP_SEEK_END, &error);
+    check_error(error);
+    self->end = size;
+
+    if (size == 0) {
+        return;
+    }
+    // Usually the last record is intact, and so is everything before it.
+    const uint8_t *p;
+    if (size >= RECORD_OVERHEAD && (p = file_read(self, size - 2, 2, true)) != NULL) {
+        size_t len = get16(p);
+        if (len + RECORD_OVERHEAD <= (size_t)size && file_record(self, size - len - RECORD_OVERHEAD, len, true, NULL)) {
+            return;
+        }
+    }
+
+    // Otherwise the last commit was cut short. Keep the complete records.
+    uint32_t position = 0;
+    while ((p = file_read(self, position, 2, false)) != NULL) {
+        size_t len = get16(p);
+        if (!file_record(self, position, len, false, NULL)) {
+            break;
+        }
+        position += len + RECORD_OVERHEAD;
+    }
+    self->end = position;
+    // The window may hold data past the new end.
+    self->read_len = 0;
+}
+
+static void block_read(recordlog_recordlog_obj_t *self, uint32_t block) {
+    if (self->read_len > 0 && self->read_start == block) {
+        return;
+    }
+    self->read_len = 0;
+    if (mp_vfs_blockdev_read(&self->blockdev, block, 1, self->read_buffer) != 0) {
+        mp_raise_OSError(MP_EIO);
+    }
+    self->read_start = block;
+    self->read_len = self->buffer_size;
+}
+
+// Returns the sequence number of the block in the read buffer, or 0 if it
+// isn't part of a log.
+static uint32_t block_sequence(recordlog_recordlog_obj_t *self) {
+    if (get32(self->read_buffer) != BLOCK_MAGIC) {
+        return 0;
+    }
+    return get32(self->read_buffer + 4);
+}
+
+static void block_start(recordlog_recordlog_obj_t *self) {
+    memset(self->write_buffer, 0xff, self->buffer_size);
+    put32(self->write_buffer, BLOCK_MAGIC);
+    put32(self->write_buffer + 4, self->head_sequence);
+    // A block without records isn't worth a write. Until it has some, the
+    // sequence number on storage doesn't match and readers skip it.
+    self->used = BLOCK_HEADER_SIZE;
+    self->committed = BLOCK_HEADER_SIZE;
+}
+
+static void block_mount(recordlog_recordlog_obj_t *self) {
+    // Every block header is read once to find both ends of the ring.
+    uint32_t head_sequence = 0;
+    uint32_t tail_sequence = UINT32_MAX;
+    for (uint32_t block = 0; block < self->block_count; block++) {
+        block_read(self, block);
+        uint32_t sequence = block_sequence(self);
+        if (sequence == 0) {
+            continue;
+        }
+        if (sequence > head_sequence) {
+            head_sequence = sequence;
+            self->head_block = block;
+        }
+        if (sequence < tail_sequence) {
+            tail_sequence = sequence;
+            self->tail_block = block;
+        }
+    }
+
+    if (head_sequence == 0) {
+        self->head_block = 0;
+        self->tail_block = 0;
+        self->head_sequence = 1;
+        block_start(self);
+        return;
+    }
+
+    self->head_sequence = head_sequence;
+    block_read(self, self->head_block);
+    memcpy(self->write_buffer, self->read_buffer, self->buffer_size);
+    self->used = scan_records(self->write_buffer, BLOCK_HEADER_SIZE, self->buffer_size);
+    // Drop anything left by a cut short write. It goes with the next commit.
+    memset(self->write_buffer + self->used, 0xff, self->buffer_size - self->used);
+    self->committed = self->used;
+}
+
+static void block_advance(recordlog_recordlog_obj_t *self) {
+    common_hal_recordlog_recordlog_commit(self);
+    self->head_block = (self->head_block + 1) % self->block_count;
+    self->head_sequence++;
+    if (self->head_block == self->tail_block) {
+        // The ring is full, so the oldest block is reused.
+        self->tail_block = (self->tail_block + 1) % self->block_count;
+    }
+    block_start(self);
+}
+
+void common_hal_recordlog_recordlog_construct(recordlog_recordlog_obj_t *self, mp_obj_t storage, size_t buffer_size) {
+    self->storage = storage;
+    self->used = 0;
+    self->committed = 0;
+    self->read_len = 0;
+
+    mp_obj_t dest[2];
+    mp_load_method_maybe(storage, MP_QSTR_readblocks, dest);
+    if (dest[0] == MP_OBJ_NULL) {
+        self->stream = mp_get_stream_raise(storage, MP_STREAM_OP_READ | MP_STREAM_OP_WRITE | MP_STREAM_OP_IOCTL);
+        if (self->stream->is_text) {
+            mp_raise_TypeError(MP_ERROR_TEXT("file must be a file opened in byte mode"));
+        }
+    } else {
+        self->stream = NULL;
+        memset(&self->blockdev, 0, sizeof(self->blockdev));
+        mp_vfs_blockdev_init(&self->blockdev, storage);
+        mp_vfs_blockdev_ioctl(&self->blockdev, MP_BLOCKDEV_IOCTL_INIT, 0);
+        mp_obj_t ret = mp_vfs_blockdev_ioctl(&self->blockdev, MP_BLOCKDEV_IOCTL_BLOCK_SIZE, 0);
+        buffer_size = ret == mp_const_none ? 512 : (size_t)mp_obj_get_int(ret);
+        mp_arg_validate_int_min(buffer_size, BLOCK_HEADER_SIZE + RECORD_OVERHEAD + 1, MP_QSTR_block_size);
+        self->blockdev.block_size = buffer_size;
+        ret = mp_vfs_blockdev_ioctl(&self->blockdev, MP_BLOCKDEV_IOCTL_BLOCK_COUNT, 0);
+        self->block_count = mp_arg_validate_int_min(mp_obj_get_int(ret), 2, MP_QSTR_block_count);
+    }
+
+    self->buffer_size = buffer_size;
+    self->write_buffer = m_new(uint8_t, buffer_size);
+    self->read_buffer = m_new(uint8_t, buffer_size);
+
+    if (self->stream != NULL) {
+        file_mount(self);
+    } else {
+        block_mount(self);
+    }
+}
+
+bool common_hal_recordlog_recordlog_deinited(recordlog_recordlog_obj_t *self) {
+    return self->write_buffer == NULL;
+}
+
+void common_hal_recordlog_recordlog_deinit(recordlog_recordlog_obj_t *self) {
+    if (common_hal_recordlog_recordlog_deinited(self)) {
+        return;
+    }
+    common_hal_recordlog_recordlog_commit(self);
+    m_del(uint8_t, self->write_buffer, self->buffer_size);
+    m_del(uint8_t, self->read_buffer, self->buffer_size);
+    self->write_buffer = NULL;
+    self->read_buffer = NULL;
+    self->storage = MP_OBJ_NULL;
+}
+
+size_t common_hal_recordlog_recordlog_get_max_record_length(recordlog_recordlog_obj_t *self) {
+    size_t space = self->buffer_size - RECORD_OVERHEAD;
+    if (self->stream == NULL) {
+        space -= BLOCK_HEADER_SIZE;
+    }
+    return MIN(space, RECORD_LENGTH_ERASED - 1);
+}
+
+void common_hal_recordlog_recordlog_append(recordlog_recordlog_obj_t *self, const uint8_t *data, size_t len) {
+    size_t size = len + RECORD_OVERHEAD;
+    if (self->used + size > self->buffer_size) {
+        if (self->stream != NULL) {
+            common_hal_recordlog_recordlog_commit(self);
+        } else {
+            block_advance(self);
+        }
+    }
+    uint8_t *p = self->write_buffer + self->used;
+    put16(p, len);
+    memcpy(p + 2, data, len);
+    put32(p + len + 2, crc32(0, p, len + 2));
+    put16(p + len + 6, len);
+    self->used += size;
+}
+
+void common_hal_recordlog_recordlog_commit(recordlog_recordlog_obj_t *self) {
+    if (self->used == self->committed) {
+        return;
+    }
+    if (self->stream != NULL) {
+        // One write and one flush for everything appended since the last
+        // commit, so the filesystem updates its metadata once.
+        int error = 0;
+        mp_stream_seek(self->storage, self->end, MP_SEEK_SET, &error);
+        check_error(error);
+        mp_stream_write_exactly(self->storage, self->write_buffer, self->used, &error);
+        check_error(error);
+        self->stream->ioctl(self->storage, MP_STREAM_FLUSH, 0, &error);
+        check_error(error);
+        self->end += self->used;
+        self->used = 0;
+    } else {
+        if (mp_vfs_blockdev_write(&self->blockdev, self->head_block, 1, self->write_buffer) != 0) {
+            mp_raise_OSError(MP_EIO);
+        }
+        mp_vfs_blockdev_ioctl(&self->blockdev, MP_BLOCKDEV_IOCTL_SYNC, 0);
+        self->committed = self->used;
+        if (self->read_start == self->head_block) {
+            self->read_len = 0;
+        }
+    }
+}
+
+void common_hal_recordlog_recordlog_records(recordlog_recordlog_obj_t *self, recordlog_records_obj_t *records, bool reverse) {
+    // Iterators read from storage, so they need everything to be there.
+    common_hal_recordlog_recordlog_commit(self);
+    records->log = self;
+    records->reverse = reverse;
+    if (self->stream != NULL) {
+        records->position = reverse ? self->end : 0;
+        return;
+    }
+    uint32_t blocks = (self->head_block + self->block_count - self->tail_block) % self->block_count + 1;
+    records->blocks_left = blocks;
+    records->block = reverse ? self->head_block : self->tail_block;
+    records->sequence = reverse ? self->head_sequence : self->head_sequence - (blocks - 1);
+    // 0 means the block hasn't been started.
+    records->position = 0;
+}
+
+static mp_obj_t file_next(recordlog_records_obj_t *self) {
+    recordlog_recordlog_obj_t *log = self->log;
+    const uint8_t *p = file_read(log, self->position, 2, false);
+    if (p == NULL) {
+        return mp_const_none;
+    }
+    size_t len = get16(p);
+    mp_obj_t data;
+    if (!file_record(log, self->position, len, false, &data)) {
+        return mp_const_none;
+    }
+    self->position += len + RECORD_OVERHEAD;
+    return data;
+}
+
+static mp_obj_t file_previous(recordlog_records_obj_t *self) {
+    recordlog_recordlog_obj_t *log = self->log;
+    if (self->position < RECORD_OVERHEAD) {
+        return mp_const_none;
+    }
+    const uint8_t *p = file_read(log, self->position - 2, 2, true);
+    if (p == NULL) {
+        return mp_const_none;
+    }
+    size_t len = get16(p);
+    if (len + RECORD_OVERHEAD > self->position) {
+        return mp_const_none;
+    }
+    uint32_t start = self->position - len - RECORD_OVERHEAD;
+    mp_obj_t data;
+    if (!file_record(log, start, len, true, &data)) {
+        return mp_const_none;
+    }
+    self->position = start;
+    return data;
+}
+
+// Reads the iterator's block. Returns false if the block has been reused
+// since the iterator was made, or was never written.
+static bool block_load(recordlog_records_obj_t *self) {
+    block_read(self->log, self->block);
+    return block_sequence(self->log) == self->sequence;
+}
+
+static mp_obj_t block_next(recordlog_records_obj_t *self) {
+    recordlog_recordlog_obj_t *log = self->log;
+    while (self->blocks_left > 0) {
+        if (self->position == 0) {
+            self->position = BLOCK_HEADER_SIZE;
+        }
+        if (block_load(self)) {
+            const uint8_t *p = log->read_buffer + self->position;
+            mp_int_t len = record_length(p, log->buffer_size - self->position);
+            if (len >= 0) {
+                self->position += len + RECORD_OVERHEAD;
+                return mp_obj_new_bytes(p + 2, len);
+            }
+        }
+        self->blocks_left--;
+        self->block = (self->block + 1) % log->block_count;
+        self->sequence++;
+        self->position = 0;
+    }
+    return mp_const_none;
+}
+
+static mp_obj_t block_previous(recordlog_records_obj_t *self) {
+    recordlog_recordlog_obj_t *log = self->log;
+    while (self->blocks_left > 0) {
+        if (block_load(self)) {
+            if (self->position == 0) {
+                self->position = scan_records(log->read_buffer, BLOCK_HEADER_SIZE, log->buffer_size);
+            }
+            size_t len = get16(log->read_buffer + self->position - 2);
+            if (len + RECORD_OVERHEAD <= self->position - BLOCK_HEADER_SIZE) {
+                size_t start = self->position - len - RECORD_OVERHEAD;
+                const uint8_t *p = log->read_buffer + start;
+                if (record_length(p, len + RECORD_OVERHEAD) >= 0) {
+                    self->position = start;
+                    return mp_obj_new_bytes(p + 2, len);
+                }
+            }
+        }
+        self->blocks_left--;
+        self->block = (self->block + log->block_count - 1) % log->block_count;
+        self->sequence--;
+        self->position = 0;
+    }
+    return mp_const_none;
+}
+
+mp_obj_t common_hal_recordlog_records_next(recordlog_records_obj_t *self) {
+    if (self->log->stream != NULL) {
+        return self->reverse ? file_previous(self) : file_next(self);
+    }
+    return self->reverse ? block_previous(self) : block_next(self);
+}
@@ -0,0 +1,49 @@
+// This file is part of the CircuitPython project: https://circuitpython.org
+//
+// SPDX-FileCopyrightText: Copyright (c) 2026 Adafruit Industries LLC
+//
+// SPDX-License-Identifier: MIT
+
+#pragma once
+
+#include "py/obj.h"
+#include "py/stream.h"
+#include "extmod/vfs.h"
+
+typedef struct {
+    mp_obj_base_t base;
+    // A binary file, or a block device when stream is NULL.
+    mp_obj_t storage;
+    const mp_stream_p_t *stream;
+    mp_vfs_blockdev_t blockdev;
+    size_t buffer_size;
+    // Records waiting to be written. For a block device this is an image of
+    // the head block, of which the first committed bytes are already stored.
+    uint8_t *write_buffer;
+    size_t used;
+    size_t committed;
+    // A window of the storage: a file offset, or a whole block.
+    uint8_t *read_buffer;
+    uint32_t read_start;
+    size_t read_len;
+    // File: the end of the last valid record.
+    uint32_t end;
+    // Block device: the ring of blocks from tail_block to head_block.
+    uint32_t block_count;
+    uint32_t head_block;
+    uint32_t tail_block;
+    uint32_t head_sequence;
+} recordlog_recordlog_obj_t;
+
+typedef struct {
+    mp_obj_base_t base;
+    recordlog_recordlog_obj_t *log;
+    // File: the offset of the next record, or the end of it when reversed.
+    // Block device: the same, but within the current block.
+    uint32_t position;
+    // Block device only.
+    uint32_t block;
+    uint32_t sequence;
+    uint32_t blocks_left;
+    bool reverse;
+} recordlog_records_obj_t;
@@ -20,6 +20,9 @@ static sdcardio_sdcard_obj_t sdcard;
 
 static mp_vfs_mount_t _sdcard_vfs;
 fs_user_mount_t _sdcard_usermount;
+#if MICROPY_FATFS_BLOCK_CACHE
+static fat_block_cache_t _sdcard_block_cache;
+#endif
 
 static bool _init_error = false;
 static bool _mounted = false;
@@ -100,6 +103,11 @@ void automount_sd_card(void) {
     // Initialise underlying block device
     vfs->blockdev.block_size = FF_MIN_SS; // default, will be populated by call to MP_BLOCKDEV_IOCTL_BLOCK_SIZE
     mp_vfs_blockdev_init(&vfs->blockdev, &sdcard);
+    #if MICROPY_FATFS_BLOCK_CACHE
+    // Empty the cache since the card may have been swapped.
+    fat_block_cache_init(&_sdcard_block_cache);
+    vfs->block_cache = &_sdcard_block_cache;
+    #endif
 
     // mount the block device so the VFS methods can be used
     FRESULT res = f_mount(&vfs->fatfs);
@@ -164,11 +164,11 @@ static void usb_video_cb_fun(void *unused) {
 
     unsigned cur = supervisor_ticks_ms32();
     if (cur - start_ms < interval_ms) {
-        background_callback_add(&usb_video_cb, usb_video_cb_fun, NULL); // re-queue
+        background_callback_add_priority(&usb_video_cb, usb_video_cb_fun, NULL, BACKGROUND_CALLBACK_PRIORITY_USB); // re-queue
         return;                             // not enough time
     }
     if (tx_busy) {
-        background_callback_add(&usb_video_cb, usb_video_cb_fun, NULL); // re-queue
+        background_callback_add_priority(&usb_video_cb, usb_video_cb_fun, NULL, BACKGROUND_CALLBACK_PRIORITY_USB); // re-queue
         return;
     }
     start_ms += interval_ms;
@@ -181,7 +181,7 @@ static void usb_video_cb_fun(void *unused) {
 
 void usb_video_task(void) {
     if (usb_video_is_enabled) {
-        background_callback_add(&usb_video_cb, usb_video_cb_fun, NULL);
+        background_callback_add_priority(&usb_video_cb, usb_video_cb_fun, NULL, BACKGROUND_CALLBACK_PRIORITY_USB);
     }
 }
 
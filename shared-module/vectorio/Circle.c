@@ -44,6 +44,30 @@ uint32_t common_hal_vectorio_circle_get_pixel(void *obj, int16_t x, int16_t y) {
     return pythagorasSmallerThanRadius ? self->color_index : 0;
 }
 
+// The circle is symmetric, so rows and columns have the same span: every
+// coordinate within floor(sqrt(radius^2 - line^2)) of the center.
+uint16_t common_hal_vectorio_circle_get_spans(void *obj, int16_t line, bool along_y, int16_t *spans, uint16_t max_spans) {
+    vectorio_circle_t *self = obj;
+    int16_t radius = self->radius;
+    line = abs(line);
+    if (line > radius) {
+        return 0;
+    }
+    int32_t remaining = (int32_t)radius * radius - (int32_t)line * line;
+    // Newton's method converges from above, and radius >= sqrt(remaining).
+    int32_t half = remaining ? radius : 0;
+    if (half > 0) {
+        int32_t next = (half + remaining / half) / 2;
+        while (next < half) {
+            half = next;
+            next = (half + remaining / half) / 2;
+        }
+    }
+    spans[0] = -half;
+    spans[1] = half + 1;
+    return 1;
+}
+
 
 void common_hal_vectorio_circle_get_area(void *circle, displayio_area_t *out_area) {
     vectorio_circle_t *self = circle;
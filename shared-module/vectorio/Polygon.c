@@ -185,6 +185,125 @@ uint32_t common_hal_vectorio_polygon_get_pixel(void *obj, int16_t x, int16_t y)
     return winding_number == 0 ? 0 : self->color_index;
 }
 
+// Crossings kept per line before giving up on spans for it.
+#define VECTORIO_POLYGON_EVENT_LIMIT (32)
+
+typedef struct {
+    int32_t position;
+    int8_t winding;
+} polygon_event_t;
+
+static int32_t floor_div(int32_t numerator, int32_t denominator) {
+    // denominator must be positive
+    if (numerator >= 0) {
+        return numerator / denominator;
+    }
+    return -((-numerator + denominator - 1) / denominator);
+}
+
+// Solves get_pixel's winding test for a whole row or column at once. An edge
+// winds (x, y) when y is within its half-open y range and
+//   dir * ((x - x1) * (y2 - y1) - (y - y1) * (x2 - x1)) < 0
+// where dir is +1 for upward edges and -1 for downward ones. Along a line that
+// is a half-line of positions per edge, so each edge adds a winding event and
+// a sweep over the sorted events yields the spans with nonzero winding.
+uint16_t common_hal_vectorio_polygon_get_spans(void *obj, int16_t line, bool along_y, int16_t *spans, uint16_t max_spans) {
+    vectorio_polygon_t *self = obj;
+
+    if (self->len == 0) {
+        return 0;
+    }
+
+    polygon_event_t events[VECTORIO_POLYGON_EVENT_LIMIT];
+    size_t n_events = 0;
+    // Winding before the first event
+    int winding = 0;
+
+    int16_t x1 = self->points_list[self->len - 2];
+    int16_t y1 = self->points_list[self->len - 1];
+    for (uint16_t i = 0; i < self->len; i += 2) {
+        int16_t x2 = self->points_list[i];
+        int16_t y2 = self->points_list[i + 1];
+        int32_t dx = x2 - x1;
+        int32_t dy = y2 - y1;
+        int8_t dir = dy > 0 ? 1 : -1;
+        int32_t lo = MIN(y1, y2);
+        int32_t hi = MAX(y1, y2);
+
+        if (dy == 0) {
+            // Horizontal edges never wind.
+        } else if (!along_y) {
+            if (line >= lo && line < hi) {
+                // Wound for x < x1 + ceil(dir * (line - y1) * dx / |dy|)
+                if (n_events == VECTORIO_POLYGON_EVENT_LIMIT) {
+                    return VECTORIO_SPANS_UNKNOWN;
+                }
+                events[n_events].position = x1 - floor_div(-dir * (line - y1) * dx, dir * dy);
+                events[n_events++].winding = -dir;
+                winding += dir;
+            }
+        } else {
+            // Wound for y with (y - y1) * a > b
+            int32_t a = dir * dx;
+            int32_t b = (line - x1) * dir * dy;
+            if (a > 0) {
+                lo = MAX(lo, y1 + floor_div(b, a) + 1);
+            } else if (a < 0) {
+                hi = MIN(hi, y1 - floor_div(b, -a));
+            } else if (b >= 0) {
+                lo = hi;
+            }
+            if (lo < hi) {
+                if (n_events + 2 > VECTORIO_POLYGON_EVENT_LIMIT) {
+                    return VECTORIO_SPANS_UNKNOWN;
+                }
+                events[n_events].position = lo;
+                events[n_events++].winding = dir;
+                events[n_events].position = hi;
+                events[n_events++].winding = -dir;
+            }
+        }
+
+        x1 = x2;
+        y1 = y2;
+    }
+
+    // A closed polygon crosses every line as often upward as downward.
+    if (winding != 0) {
+        return VECTORIO_SPANS_UNKNOWN;
+    }
+
+    for (size_t i = 1; i < n_events; i++) {
+        polygon_event_t event = events[i];
+        size_t j = i;
+        for (; j > 0 && events[j - 1].position > event.position; j--) {
+            events[j] = events[j - 1];
+        }
+        events[j] = event;
+    }
+
+    uint16_t count = 0;
+    int32_t start = 0;
+    for (size_t i = 0; i < n_events;) {
+        int32_t position = events[i].position;
+        int before = winding;
+        for (; i < n_events && events[i].position == position; i++) {
+            winding += events[i].winding;
+        }
+        if (before == 0 && winding != 0) {
+            start = position;
+        } else if (before != 0 && winding == 0) {
+            if (count == max_spans) {
+                return VECTORIO_SPANS_UNKNOWN;
+            }
+            spans[2 * count] = start;
+            spans[2 * count + 1] = position;
+            count++;
+        }
+    }
+    return count;
+}
+
 mp_obj_t common_hal_vectorio_polygon_get_draw_protocol(void *polygon) {
     vectorio_polygon_t *self = polygon;
     return self->draw_protocol_instance;
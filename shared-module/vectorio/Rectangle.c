@@ -33,6 +33,17 @@ uint32_t common_hal_vectorio_rectangle_get_pixel(void *obj, int16_t x, int16_t y
     return 0;
 }
 
+uint16_t common_hal_vectorio_rectangle_get_spans(void *obj, int16_t line, bool along_y, int16_t *spans, uint16_t max_spans) {
+    vectorio_rectangle_t *self = obj;
+    int16_t line_end = along_y ? self->width : self->height;
+    if (line < 0 || line >= line_end || self->width == 0 || self->height == 0) {
+        return 0;
+    }
+    spans[0] = 0;
+    spans[1] = along_y ? self->height : self->width;
+    return 1;
+}
+
 
 void common_hal_vectorio_rectangle_get_area(void *rectangle, displayio_area_t *out_area) {
     vectorio_rectangle_t *self = rectangle;
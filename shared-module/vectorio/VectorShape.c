@@ -5,6 +5,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "stdlib.h"
+#include <string.h>
 
 #include "shared-module/vectorio/__init__.h"
 #include "shared-bindings/vectorio/VectorShape.h"
@@ -326,6 +327,57 @@ void common_hal_vectorio_vector_shape_set_pixel_shader(vectorio_vector_shape_t *
     common_hal_vectorio_vector_shape_set_dirty(self);
 }
 
+// Spans per row kept on the stack while filling; rows needing more test each pixel.
+#define VECTORIO_SHAPE_SPAN_LIMIT (16)
+
+// Asks the shape for the spans it covers on screen row y, converted to screen
+// x and clipped to the overlap. Returns the number of spans, or
+// VECTORIO_SPANS_UNKNOWN if the row must be drawn by testing each pixel.
+static uint16_t _get_screen_spans(vectorio_vector_shape_t *self, const displayio_area_t *overlap, int16_t y, int16_t *spans) {
+    // The shape line is fixed along a screen row; the other shape coordinate
+    // steps by +/-1 with screen x.
+    int16_t x0, y0, x1, y1;
+    screen_to_shape_coordinates(self, overlap->x1, y, &x0, &y0);
+    screen_to_shape_coordinates(self, overlap->x1 + 1, y, &x1, &y1);
+    bool along_y = self->absolute_transform->transpose_xy;
+    int16_t line = along_y ? x0 : y0;
+    int32_t start = along_y ? y0 : x0;
+    bool reversed = along_y ? y1 < y0 : x1 < x0;
+
+    uint16_t count = self->ishape.get_spans(self->ishape.shape, line, along_y, spans, VECTORIO_SHAPE_SPAN_LIMIT);
+    if (count == VECTORIO_SPANS_UNKNOWN) {
+        return count;
+    }
+
+    uint16_t out = 0;
+    for (uint16_t i = 0; i < count; i++) {
+        uint16_t k = reversed ? count - 1 - i : i;
+        int32_t screen_x1, screen_x2;
+        if (reversed) {
+            screen_x1 = overlap->x1 + start - spans[2 * k + 1] + 1;
+            screen_x2 = overlap->x1 + start - spans[2 * k] + 1;
+        } else {
+            screen_x1 = overlap->x1 + spans[2 * k] - start;
+            screen_x2 = overlap->x1 + spans[2 * k + 1] - start;
+        }
+        screen_x1 = MAX(screen_x1, overlap->x1);
+        screen_x2 = MIN(screen_x2, overlap->x2);
+        if (screen_x1 >= screen_x2) {
+            continue;
+        }
+        // Reversed spans are read from the end while written from the start,
+        // so stash them past the shape's spans until all are converted.
+        uint16_t dest = reversed ? 2 * (VECTORIO_SHAPE_SPAN_LIMIT + out) : 2 * out;
+        spans[dest] = screen_x1;
+        spans[dest + 1] = screen_x2;
+        out++;
+    }
+    if (reversed) {
+        memmove(spans, spans + 2 * VECTORIO_SHAPE_SPAN_LIMIT, 2 * out * sizeof(int16_t));
+    }
+    return out;
+}
+
 bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displayio_colorspace_t *colorspace, const displayio_area_t *area, uint32_t *mask, uint32_t *buffer) {
     // Shape areas are relative to 0,0.  This will allow rotation about a known axis.
     //   The consequence is that the area reported by the shape itself is _relative_ to 0,0.
@@ -373,9 +425,16 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
     displayio_area_t shape_area;
     self->ishape.get_area(self->ishape.shape, &shape_area);
 
+    // Within spans every pixel has the shape's value, so get_pixel is only
+    // asked for the first covered one.
+    uint32_t shape_pixel = 0;
+    int16_t spans[4 * VECTORIO_SHAPE_SPAN_LIMIT];
+
     uint16_t mask_start_px = line_dirty_offset_px;
     for (input_pixel.y = overlap.y1; input_pixel.y < overlap.y2; ++input_pixel.y) {
         mask_start_px += column_dirty_offset_px;
+        uint16_t span_count = _get_screen_spans(self, &overlap, input_pixel.y, spans);
+        uint16_t span = 0;
         for (input_pixel.x = overlap.x1; input_pixel.x < overlap.x2; ++input_pixel.x) {
             // Check the mask first to see if the pixel has already been set.
             uint16_t pixel_index = mask_start_px + (input_pixel.x - overlap.x1);
@@ -388,16 +447,32 @@ bool vectorio_vector_shape_fill_area(vectorio_vector_shape_t *self, const _displ
             }
             output_pixel.pixel = 0;
 
-            // Cast input screen coordinates to shape coordinates to pick the pixel to draw
-            int16_t pixel_to_get_x;
-            int16_t pixel_to_get_y;
-            screen_to_shape_coordinates(self, input_pixel.x, input_pixel.y, &pixel_to_get_x, &pixel_to_get_y);
-
-            VECTORIO_SHAPE_PIXEL_DEBUG(" get_pixel %p (%3d, %3d) -> ( %3d, %3d )", self->ishape.shape, input_pixel.x, input_pixel.y, pixel_to_get_x, pixel_to_get_y);
             #ifdef VECTORIO_PERF
             uint64_t pre_pixel = common_hal_time_monotonic_ns();
             #endif
-            input_pixel.pixel = self->ishape.get_pixel(self->ishape.shape, pixel_to_get_x, pixel_to_get_y);
+            bool test_pixel = span_count == VECTORIO_SPANS_UNKNOWN;
+            input_pixel.pixel = 0;
+            if (!test_pixel) {
+                while (span < span_count && input_pixel.x >= spans[2 * span + 1]) {
+                    span++;
+                }
+                if (span < span_count && input_pixel.x >= spans[2 * span]) {
+                    input_pixel.pixel = shape_pixel;
+                    test_pixel = shape_pixel == 0;
+                }
+            }
+            if (test_pixel) {
+                // Cast input screen coordinates to shape coordinates to pick the pixel to draw
+                int16_t pixel_to_get_x;
+                int16_t pixel_to_get_y;
+                screen_to_shape_coordinates(self, input_pixel.x, input_pixel.y, &pixel_to_get_x, &pixel_to_get_y);
+
+                VECTORIO_SHAPE_PIXEL_DEBUG(" get_pixel %p (%3d, %3d) -> ( %3d, %3d )", self->ishape.shape, input_pixel.x, input_pixel.y, pixel_to_get_x, pixel_to_get_y);
+                input_pixel.pixel = self->ishape.get_pixel(self->ishape.shape, pixel_to_get_x, pixel_to_get_y);
+                if (span_count != VECTORIO_SPANS_UNKNOWN) {
+                    shape_pixel = input_pixel.pixel;
+                }
+            }
             #ifdef VECTORIO_PERF
             uint64_t post_pixel = common_hal_time_monotonic_ns();
             pixel_time += post_pixel - pre_pixel;
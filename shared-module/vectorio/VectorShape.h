@@ -13,6 +13,7 @@
 #include "py/obj.h"
 #include "shared-module/displayio/area.h"
 #include "shared-module/displayio/Palette.h"
+#include "shared-module/vectorio/__init__.h"
 
 typedef void get_area_function(mp_obj_t shape, displayio_area_t *out_area);
 typedef uint32_t get_pixel_function(mp_obj_t shape, int16_t x, int16_t y);
@@ -27,6 +28,7 @@ typedef struct {
     mp_obj_t shape;
     get_area_function *get_area;
     get_pixel_function *get_pixel;
+    get_spans_function *get_spans;
 } vectorio_ishape_t;
 
 typedef struct {
@@ -14,3 +14,11 @@ typedef struct {
     mp_obj_t obj;
     event_function *event;
 } vectorio_event_t;
+
+// Shapes describe their coverage of a line of shape coordinates as spans:
+// pairs of [start, end) in increasing order along the line.
+// `along_y` selects a column (line is x, spans are in y) rather than a row.
+// Returns the number of spans, or VECTORIO_SPANS_UNKNOWN when they don't fit
+// in max_spans and the caller must fall back to testing each pixel.
+#define VECTORIO_SPANS_UNKNOWN (UINT16_MAX)
+typedef uint16_t get_spans_function(mp_obj_t shape, int16_t line, bool along_y, int16_t *spans, uint16_t max_spans);
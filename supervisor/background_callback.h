@@ -7,6 +7,7 @@
 #pragma once
 
 #include <stdbool.h>
+#include <stdint.h>
 
 /** Background callbacks are a linked list of tasks to call in the background.
  *
@@ -27,6 +28,11 @@
  *
  * background_callback_add can be called from interrupt context.
  *
+ * Each callback has a priority, which is BACKGROUND_CALLBACK_PRIORITY_NORMAL
+ * unless background_callback_add_priority is used. Pending callbacks of a
+ * higher priority run first, and ones queued while a lower priority callback
+ * runs are run next, ahead of any other lower priority work.
+ *
  * If your work isn't triggered by an event, then it may be better implemented
  * using ticks, which runs tasks every millisecond or so. Ticks are enabled with
  * supervisor_enable_tick() and disabled with supervisor_disable_tick(). When
@@ -34,13 +40,42 @@
  * which includes port_background_tick(), every millisecond.
  */
 typedef void (*background_callback_fun)(void *data);
+
+typedef enum {
+    BACKGROUND_CALLBACK_PRIORITY_NORMAL,
+    BACKGROUND_CALLBACK_PRIORITY_DISPLAY,
+    BACKGROUND_CALLBACK_PRIORITY_USB,
+    BACKGROUND_CALLBACK_PRIORITY_AUDIO,
+    BACKGROUND_CALLBACK_PRIORITY_COUNT
+} background_callback_priority_t;
+
 typedef struct background_callback {
     background_callback_fun fun;
     void *data;
     struct background_callback *next;
     struct background_callback *prev;
+    uint8_t priority;
+    #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+    // Run-time accounting, in subticks (1/32768 of a second).
+    uint32_t run_count;
+    uint32_t run_subticks;
+    uint32_t max_subticks;
+    #endif
 } background_callback_t;
 
+#if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+typedef struct {
+    uint32_t run_count;
+    uint32_t run_subticks;
+    uint32_t max_subticks;
+} background_callback_stats_t;
+
+/* Get the totals of all the callbacks of the given priority that ran since the
+ * last background_callback_reset. Per-callback totals are kept in the
+ * callback itself. */
+void background_callback_get_stats(background_callback_priority_t priority, background_callback_stats_t *stats);
+#endif
+
 /* Add a background callback for which 'fun' and 'data' were previously set */
 void background_callback_add_core(background_callback_t *cb);
 
@@ -53,6 +88,9 @@ void background_callback_add_core(background_callback_t *cb);
  */
 void background_callback_add(background_callback_t *cb, background_callback_fun fun, void *data);
 
+/* Like background_callback_add, but also set the priority of the callback. */
+void background_callback_add_priority(background_callback_t *cb, background_callback_fun fun, void *data, background_callback_priority_t priority);
+
 /* Run all background callbacks.  Normally, this is done by the supervisor
  * whenever the list is non-empty */
 void background_callback_run_all(void);
@@ -16,6 +16,12 @@ void filesystem_background(void);
 void filesystem_tick(void);
 bool filesystem_init(bool create_allowed, bool force_create);
 void filesystem_flush(void);
+// Flush the CIRCUITPY flash cache once writes have been quiet for
+// CIRCUITPY_FILESYSTEM_FLUSH_QUIET_MS. This is what a FatFs sync does.
+void filesystem_request_flush(void);
+// Flush the CIRCUITPY flash cache before returning, but keep it allocated.
+// Use this when the data must be on flash, such as before an eject.
+void filesystem_sync(void);
 bool filesystem_present(void);
 void filesystem_set_internal_writable_by_usb(bool usb_writable);
 void filesystem_set_internal_concurrent_write_protection(bool concurrent_write_protection);
@@ -28,6 +28,9 @@ struct _fs_user_mount_t;
 void supervisor_flash_init_vfs(struct _fs_user_mount_t *vfs);
 void supervisor_flash_flush(void);
 void supervisor_flash_release_cache(void);
+// True when the write cache can't take another sector without writing one
+// back. Flushes are not deferred then. Defaults to false.
+bool supervisor_flash_cache_is_full(void);
 
 void supervisor_flash_set_extended(bool extended);
 bool supervisor_flash_get_extended(void);
@@ -14,7 +14,12 @@
 #include "supervisor/shared/tick.h"
 #include "shared-bindings/microcontroller/__init__.h"
 
-static volatile background_callback_t *volatile callback_head, *volatile callback_tail;
+// One queue per priority. While background_callback_run_all runs, the
+// callbacks it took from the queues wait in the run lists.
+static volatile background_callback_t *volatile callback_head[BACKGROUND_CALLBACK_PRIORITY_COUNT];
+static volatile background_callback_t *volatile callback_tail[BACKGROUND_CALLBACK_PRIORITY_COUNT];
+static background_callback_t *run_head[BACKGROUND_CALLBACK_PRIORITY_COUNT];
+static background_callback_t *run_tail[BACKGROUND_CALLBACK_PRIORITY_COUNT];
 
 #ifndef CALLBACK_CRITICAL_BEGIN
 #define CALLBACK_CRITICAL_BEGIN (common_hal_mcu_disable_interrupts())
@@ -23,24 +28,65 @@ static volatile background_callback_t *volatile callback_head, *volatile callbac
 #define CALLBACK_CRITICAL_END (common_hal_mcu_enable_interrupts())
 #endif
 
+#if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+static background_callback_stats_t priority_stats[BACKGROUND_CALLBACK_PRIORITY_COUNT];
+
+static uint64_t now_subticks(void) {
+    uint8_t subticks = 0;
+    uint64_t ticks = port_get_raw_ticks(&subticks);
+    return (ticks << 5) | subticks;
+}
+
+// Called in the critical section, so the totals can be read consistently. Like
+// the queue links, the counts are written after the callback returns, so a
+// callback must not free its own background_callback_t.
+static void record_run(background_callback_t *cb, size_t priority, uint32_t elapsed) {
+    cb->run_count++;
+    cb->run_subticks += elapsed;
+    if (elapsed > cb->max_subticks) {
+        cb->max_subticks = elapsed;
+    }
+    background_callback_stats_t *stats = &priority_stats[priority];
+    stats->run_count++;
+    stats->run_subticks += elapsed;
+    if (elapsed > stats->max_subticks) {
+        stats->max_subticks = elapsed;
+    }
+}
+
+void background_callback_get_stats(background_callback_priority_t priority, background_callback_stats_t *stats) {
+    if (priority >= BACKGROUND_CALLBACK_PRIORITY_COUNT) {
+        priority = BACKGROUND_CALLBACK_PRIORITY_NORMAL;
+    }
+    CALLBACK_CRITICAL_BEGIN;
+    *stats = priority_stats[priority];
+    CALLBACK_CRITICAL_END;
+}
+#endif
+
 MP_WEAK void PLACE_IN_ITCM(port_wake_main_task)(void) {
 }
 
 void PLACE_IN_ITCM(background_callback_add_core)(background_callback_t * cb) {
+    size_t priority = cb->priority;
+    if (priority >= BACKGROUND_CALLBACK_PRIORITY_COUNT) {
+        priority = BACKGROUND_CALLBACK_PRIORITY_NORMAL;
+    }
     CALLBACK_CRITICAL_BEGIN;
-    if (cb->prev || callback_head == cb) {
+    // Only the first callback of a list has no prev.
+    if (cb->prev || callback_head[priority] == cb || run_head[priority] == cb) {
         CALLBACK_CRITICAL_END;
         return;
     }
     cb->next = 0;
-    cb->prev = (background_callback_t *)callback_tail;
-    if (callback_tail) {
-        callback_tail->next = cb;
+    cb->prev = (background_callback_t *)callback_tail[priority];
+    if (callback_tail[priority]) {
+        callback_tail[priority]->next = cb;
     }
-    if (!callback_head) {
-        callback_head = cb;
+    if (!callback_head[priority]) {
+        callback_head[priority] = cb;
     }
-    callback_tail = cb;
+    callback_tail[priority] = cb;
     CALLBACK_CRITICAL_END;
 
     port_wake_main_task();
@@ -52,12 +98,42 @@ void PLACE_IN_ITCM(background_callback_add)(background_callback_t * cb, backgrou
     background_callback_add_core(cb);
 }
 
+void PLACE_IN_ITCM(background_callback_add_priority)(background_callback_t * cb, background_callback_fun fun, void *data, background_callback_priority_t priority) {
+    cb->priority = priority;
+    background_callback_add(cb, fun, data);
+}
+
 inline bool background_callback_pending(void) {
-    return callback_head != NULL;
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        if (callback_head[i] != NULL) {
+            return true;
+        }
+    }
+    return false;
 }
 
 static int background_prevention_count;
 
+// Move the queued callbacks of the given priorities to the end of their run
+// lists. Must be called in the critical section.
+static void PLACE_IN_ITCM(take_queued)(size_t lowest_priority) {
+    for (size_t i = lowest_priority; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        background_callback_t *head = (background_callback_t *)callback_head[i];
+        if (!head) {
+            continue;
+        }
+        if (run_tail[i]) {
+            run_tail[i]->next = head;
+            head->prev = run_tail[i];
+        } else {
+            run_head[i] = head;
+        }
+        run_tail[i] = (background_callback_t *)callback_tail[i];
+        callback_head[i] = NULL;
+        callback_tail[i] = NULL;
+    }
+}
+
 void PLACE_IN_ITCM(background_callback_run_all)() {
     port_background_task();
     if (!background_callback_pending()) {
@@ -69,21 +145,46 @@ void PLACE_IN_ITCM(background_callback_run_all)() {
         return;
     }
     ++background_prevention_count;
-    background_callback_t *cb = (background_callback_t *)callback_head;
-    callback_head = NULL;
-    callback_tail = NULL;
-    while (cb) {
-        background_callback_t *next = cb->next;
+    // Callbacks queued from here on wait for the next call, so that one which
+    // re-queues itself can't run forever. The exception is higher priority work
+    // queued while a callback runs, which is taken before lower priority
+    // callbacks continue.
+    take_queued(0);
+    size_t priority = BACKGROUND_CALLBACK_PRIORITY_COUNT;
+    while (priority > 0) {
+        background_callback_t *cb = run_head[priority - 1];
+        if (!cb) {
+            priority--;
+            continue;
+        }
+        run_head[priority - 1] = cb->next;
+        if (cb->next) {
+            cb->next->prev = NULL;
+        } else {
+            run_tail[priority - 1] = NULL;
+        }
         cb->next = cb->prev = NULL;
         background_callback_fun fun = cb->fun;
         void *data = cb->data;
         CALLBACK_CRITICAL_END;
         // Leave the critical section in order to run the callback function
+        #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+        uint64_t start = now_subticks();
+        #endif
         if (fun) {
             fun(data);
         }
+        #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+        uint32_t elapsed = (uint32_t)(now_subticks() - start);
+        #endif
         CALLBACK_CRITICAL_BEGIN;
-        cb = next;
+        #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+        record_run(cb, priority - 1, elapsed);
+        #endif
+        if (priority < BACKGROUND_CALLBACK_PRIORITY_COUNT) {
+            take_queued(priority);
+            priority = BACKGROUND_CALLBACK_PRIORITY_COUNT;
+        }
     }
     --background_prevention_count;
     CALLBACK_CRITICAL_END;
@@ -104,55 +205,72 @@ void background_callback_allow() {
 
 // Filter out queued callbacks if they are allocated on the heap.
 void background_callback_reset() {
-    background_callback_t *new_head = NULL;
-    background_callback_t **previous_next = &new_head;
-    background_callback_t *new_tail = NULL;
     CALLBACK_CRITICAL_BEGIN;
-    background_callback_t *cb = (background_callback_t *)callback_head;
-    while (cb) {
-        background_callback_t *next = cb->next;
-        cb->next = NULL;
-        // Unlink any callbacks that are allocated on the python heap or if they
-        // reference data on the python heap. The python heap will be disappear
-        // soon after this.
-        if (gc_ptr_on_heap((void *)cb) || gc_ptr_on_heap(cb->data)) {
-            cb->prev = NULL; // Used to indicate a callback isn't queued.
-        } else {
-            // Set .next of the previous callback.
-            *previous_next = cb;
-            // Set our .next for the next callback.
-            previous_next = &cb->next;
-            // Set our prev to the last callback.
-            cb->prev = new_tail;
-            // Now we're the tail of the list.
-            new_tail = cb;
+    // Nothing is running now, so anything left in the run lists is queued again.
+    take_queued(0);
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        background_callback_t *new_head = NULL;
+        background_callback_t **previous_next = &new_head;
+        background_callback_t *new_tail = NULL;
+        background_callback_t *cb = run_head[i];
+        while (cb) {
+            background_callback_t *next = cb->next;
+            cb->next = NULL;
+            // Unlink any callbacks that are allocated on the python heap or if they
+            // reference data on the python heap. The python heap will be disappear
+            // soon after this.
+            if (gc_ptr_on_heap((void *)cb) || gc_ptr_on_heap(cb->data)) {
+                cb->prev = NULL; // Used to indicate a callback isn't queued.
+            } else {
+                // Set .next of the previous callback.
+                *previous_next = cb;
+                // Set our .next for the next callback.
+                previous_next = &cb->next;
+                // Set our prev to the last callback.
+                cb->prev = new_tail;
+                // Now we're the tail of the list.
+                new_tail = cb;
+            }
+            cb = next;
         }
-        cb = next;
+        callback_head[i] = new_head;
+        callback_tail[i] = new_tail;
+        run_head[i] = NULL;
+        run_tail[i] = NULL;
     }
-    callback_head = new_head;
-    callback_tail = new_tail;
     background_prevention_count = 0;
+    #if CIRCUITPY_BACKGROUND_CALLBACK_STATS
+    memset(priority_stats, 0, sizeof(priority_stats));
+    #endif
     CALLBACK_CRITICAL_END;
 }
 
 void background_callback_gc_collect(void) {
     // We don't enter the callback critical section here.  We rely on
     // gc_collect_ptr _NOT_ entering background callbacks, so it is not
-    // possible for the list to be cleared.
+    // possible for the lists to be cleared.
     //
-    // However, it is possible for the list to be extended.  We make the
+    // However, it is possible for the lists to be extended.  We make the
     // minor assumption that no newly added callback is for a
     // collectable object.  That is, we only plug the hole where an
     // object becomes collectable AFTER it is added but before the
     // callback is run, not the hole where an object was ALREADY
     // collectable but adds a background task for itself.
     //
-    // It's necessary to traverse the whole list here, as the callbacks
+    // It's necessary to traverse the whole lists here, as the callbacks
     // themselves can be in non-gc memory, and some of the cb->data
-    // objects themselves might be in non-gc memory.
-    background_callback_t *cb = (background_callback_t *)callback_head;
-    while (cb) {
-        gc_collect_ptr(cb->data);
-        cb = cb->next;
+    // objects themselves might be in non-gc memory. The run lists are
+    // included because a callback may collect while others wait to run.
+    for (size_t i = 0; i < BACKGROUND_CALLBACK_PRIORITY_COUNT; i++) {
+        background_callback_t *cb = (background_callback_t *)callback_head[i];
+        while (cb) {
+            gc_collect_ptr(cb->data);
+            cb = cb->next;
+        }
+        cb = run_head[i];
+        while (cb) {
+            gc_collect_ptr(cb->data);
+            cb = cb->next;
+        }
     }
 }
@@ -33,8 +33,13 @@ const uint8_t file_transfer_base_uuid[16] = {0x72, 0x65, 0x66, 0x73, 0x6e, 0x61,
 
 static mp_obj_list_t characteristic_list;
 static mp_obj_t characteristic_list_items[2];
-// 2 * 10 ringbuf packets, 512 for a disk sector and 12 for the file transfer write header.
-#define PACKET_BUFFER_SIZE (2 * 10 + 512 + 12)
+// Number of 512 byte WRITE_DATA chunks a client may have in flight at once.
+#ifndef FILE_TRANSFER_WRITE_WINDOW
+#define FILE_TRANSFER_WRITE_WINDOW (4)
+#endif
+// Per chunk in the window: 2 * 10 ringbuf packets, 512 for a disk sector and 12 for
+// the file transfer write header.
+#define PACKET_BUFFER_SIZE (FILE_TRANSFER_WRITE_WINDOW * (2 * 10 + 512 + 12))
 // uint32_t so its aligned
 static uint32_t _buffer[PACKET_BUFFER_SIZE / 4 + 1];
 static uint32_t _outgoing1[BLEIO_PACKET_BUFFER_MAX_PACKET_SIZE / 4];
@@ -71,7 +76,7 @@ void supervisor_start_bluetooth_file_transfer(void) {
         NULL,                                       // no initial value
         NULL); // no description
 
-    uint32_t version = 4;
+    uint32_t version = 5;
     mp_buffer_info_t bufinfo;
     bufinfo.buf = &version;
     bufinfo.len = sizeof(version);
@@ -236,13 +241,21 @@ static uint8_t _process_read_pacing(const uint8_t *raw_buf, size_t command_len)
 // Used by write and write data to know when the write is complete.
 static size_t total_write_length;
 static uint64_t _truncated_time;
+// Chunks granted to the client, the offset last acknowledged and whether the
+// file is open for WRITE_DATA.
+static uint16_t _write_window;
+static uint32_t _acked_offset;
+static bool _writing;
 
 static uint8_t _process_write(const uint8_t *raw_buf, size_t command_len) {
     struct write_command *command = (struct write_command *)raw_buf;
     size_t header_size = sizeof(struct write_command);
+    _write_window = MAX(1, MIN(command->window, FILE_TRANSFER_WRITE_WINDOW));
+    _writing = false;
     struct write_pacing response;
     response.command = WRITE_PACING;
     response.status = STATUS_OK;
+    response.window = _write_window;
     if (command->path_length > (COMMAND_SIZE - header_size - 1)) { // -1 for the null we'll write
         // TODO: throw away any more packets of path.
         response.status = STATUS_ERROR;
@@ -285,9 +298,9 @@ static uint8_t _process_write(const uint8_t *raw_buf, size_t command_len) {
     }
     // Write out the pacing response.
 
-    // Align the next chunk to a sector boundary.
+    // Align the end of the window to a sector boundary.
     uint32_t offset = command->offset;
-    size_t chunk_size = MIN(total_write_length - offset, 512 - (offset % 512));
+    size_t chunk_size = MIN(total_write_length - offset, _write_window * 512 - (offset % 512));
     // Special case when truncating the file. (Deleting stuff off the end.)
     if (chunk_size == 0) {
         f_lseek(&active_file, offset);
@@ -305,6 +318,8 @@ static uint8_t _process_write(const uint8_t *raw_buf, size_t command_len) {
         common_hal_bleio_packet_buffer_flush(&_transfer_packet_buffer);
         return ANY_COMMAND;
     }
+    _acked_offset = offset;
+    _writing = true;
 
     return WRITE_DATA;
 }
@@ -315,10 +330,21 @@ static uint8_t _process_write_data(const uint8_t *raw_buf, size_t command_len) {
     struct write_pacing response;
     response.command = WRITE_PACING;
     response.status = STATUS_OK;
+    response.window = _write_window;
+    if (!_writing) {
+        // The rest of a window sent before the write failed. Drop it quietly.
+        if (command->data_size <= (COMMAND_SIZE - header_size - 1) &&
+            command_len < header_size + command->data_size) {
+            return THIS_COMMAND;
+        }
+        return ANY_COMMAND;
+    }
     if (command->data_size > (COMMAND_SIZE - header_size - 1)) { // -1 for the null we'll write
         // TODO: throw away any more packets of path.
         response.status = STATUS_ERROR;
         common_hal_bleio_packet_buffer_write(&_transfer_packet_buffer, (const uint8_t *)&response, sizeof(struct write_pacing), NULL, 0);
+        f_close(&active_file);
+        _writing = false;
         filesystem_unlock(active_mount);
         override_fattime(0);
         return ANY_COMMAND;
@@ -335,13 +361,22 @@ static uint8_t _process_write_data(const uint8_t *raw_buf, size_t command_len) {
         // TODO: throw away any more packets of path.
         response.status = STATUS_ERROR;
         common_hal_bleio_packet_buffer_write(&_transfer_packet_buffer, (const uint8_t *)&response, sizeof(struct write_pacing), NULL, 0);
+        f_close(&active_file);
+        _writing = false;
         filesystem_unlock(active_mount);
         override_fattime(0);
         return ANY_COMMAND;
     }
     offset += command->data_size;
-    // Align the next chunk to a sector boundary.
-    size_t chunk_size = MIN(total_write_length - offset, 512);
+    // With a window, only acknowledge once half of it has arrived so the client
+    // can keep sending while the acknowledgement is on its way.
+    if (total_write_length != offset && _write_window > 1 &&
+        offset - _acked_offset < _write_window * 512 / 2) {
+        return WRITE_DATA;
+    }
+    _acked_offset = offset;
+    // Align the end of the window to a sector boundary.
+    size_t chunk_size = MIN(total_write_length - offset, _write_window * 512 - (offset % 512));
     response.offset = offset;
     response.free_space = chunk_size;
     response.truncated_time = _truncated_time;
@@ -349,6 +384,7 @@ static uint8_t _process_write_data(const uint8_t *raw_buf, size_t command_len) {
     if (total_write_length == offset) {
         f_truncate(&active_file);
         f_close(&active_file);
+        _writing = false;
         override_fattime(0);
         filesystem_unlock(active_mount);
         // Don't reload until everything is written out of the packet buffer.
@@ -673,6 +709,7 @@ void supervisor_bluetooth_file_transfer_background(void) {
 
 void supervisor_bluetooth_file_transfer_disconnected(void) {
     next_command = ANY_COMMAND;
+    _writing = false;
     current_offset = 0;
     f_close(&active_file);
     autoreload_resume(AUTORELOAD_SUSPEND_BLE);
@@ -47,10 +47,16 @@ struct read_pacing {
     uint32_t chunk_size;
 } __attribute__((packed));
 
+// Version 5 adds a write window. A client that sets window in the write
+// command may keep sending WRITE_DATA of up to 512 bytes each, each starting
+// in a new packet, until free_space bytes past the last acknowledged offset
+// are in flight. WRITE_PACING acknowledgements are then batched and report
+// the window that was granted. A window of 0 or 1 is the original one chunk
+// per round trip.
 #define WRITE 0x20
 struct write_command {
     uint8_t command;
-    uint8_t reserved;
+    uint8_t window;
     uint16_t path_length;
     uint32_t offset;
     uint64_t modification_time;
@@ -62,7 +68,7 @@ struct write_command {
 struct write_pacing {
     uint8_t command;
     uint8_t status;
-    uint16_t reserved;
+    uint16_t window;
     uint32_t offset;
     uint64_t truncated_time;
     uint32_t free_space;
@@ -22,7 +22,8 @@
 
 #define NO_SECTOR_LOADED 0xFFFFFFFF
 
-// The currently cached sector in the cache, ram or flash based.
+// The sector cached in the scratch sector at the end of the flash. This is
+// only used when there isn't enough ram to cache even one sector there.
 static uint32_t current_sector;
 
 static const external_flash_device possible_devices[] = {EXTERNAL_FLASH_DEVICES};
@@ -31,15 +32,34 @@ static const external_flash_device possible_devices[] = {EXTERNAL_FLASH_DEVICES}
 static const external_flash_device *flash_device = NULL;
 
 // Track which blocks (up to 32) in the current sector currently live in the
-// cache.
+// scratch sector.
 static uint32_t dirty_mask;
 
-// Table of pointers to each cached block. Should be zero'd after allocation.
 #define BLOCKS_PER_SECTOR (SPI_FLASH_ERASE_SIZE / FILESYSTEM_BLOCK_SIZE)
 #define PAGES_PER_BLOCK (FILESYSTEM_BLOCK_SIZE / SPI_FLASH_PAGE_SIZE)
 #define FLASH_CACHE_TABLE_NUM_ENTRIES (BLOCKS_PER_SECTOR * PAGES_PER_BLOCK)
 #define FLASH_CACHE_TABLE_SIZE (FLASH_CACHE_TABLE_NUM_ENTRIES * sizeof (uint8_t *))
-static uint8_t **flash_cache_table = NULL;
+
+// A sector cached in ram. Writes to it are collected here so that the sector
+// is only erased and rewritten once, when the entry is flushed or evicted.
+typedef struct {
+    // The cached sector, or NO_SECTOR_LOADED if the entry is free.
+    uint32_t sector;
+    // Track which blocks (up to 32) of the sector currently live in the cache.
+    uint32_t dirty_mask;
+    // The value of flash_cache_use_count when the entry was last written.
+    uint32_t last_use;
+    // Table of pointers to each cached page. Should be zero'd after allocation.
+    uint8_t **table;
+} flash_cache_entry_t;
+
+// FatFs interleaves writes to the FAT, the directory and the file data, so
+// caching several sectors avoids rewriting each of them for every block.
+static flash_cache_entry_t flash_cache[SPI_FLASH_CACHE_SECTORS];
+// The number of entries at the start of flash_cache that have their tables
+// allocated. More are allocated, while the port heap allows, as needed.
+static size_t flash_cache_allocated;
+static uint32_t flash_cache_use_count;
 
 // Wait until both the write enable and write in progress bits have cleared.
 static bool wait_for_flash_ready(void) {
@@ -279,7 +299,7 @@ void supervisor_flash_init(void) {
 
     current_sector = NO_SECTOR_LOADED;
     dirty_mask = 0;
-    flash_cache_table = NULL;
+    flash_cache_allocated = 0;
 }
 
 // The size of each individual block.
@@ -329,35 +349,45 @@ static bool flush_scratch_flash(void) {
     return true;
 }
 
-// Free all entries in the partially or completely filled flash_cache_table, and then free the table itself.
-static void release_ram_cache(void) {
-    if (flash_cache_table == NULL) {
+// Free all entries in the partially or completely filled table of a cache
+// entry, and then free the table itself.
+static void release_ram_cache_entry(flash_cache_entry_t *entry) {
+    if (entry->table == NULL) {
         return;
     }
 
     for (size_t i = 0; i < FLASH_CACHE_TABLE_NUM_ENTRIES; i++) {
         // Table may not be completely full. Stop at first NULL entry.
-        if (flash_cache_table[i] == NULL) {
+        if (entry->table[i] == NULL) {
             break;
         }
-        port_free(flash_cache_table[i]);
+        port_free(entry->table[i]);
+    }
+    port_free(entry->table);
+    entry->table = NULL;
+}
+
+static void release_ram_cache(void) {
+    for (size_t i = 0; i < flash_cache_allocated; i++) {
+        release_ram_cache_entry(&flash_cache[i]);
     }
-    port_free(flash_cache_table);
-    flash_cache_table = NULL;
+    flash_cache_allocated = 0;
 }
 
 // Attempts to allocate a new set of page buffers for caching a full sector in
 // ram. Each page is allocated separately so that the GC doesn't need to provide
 // one huge block. We can free it as we write if we want to also.
-static bool allocate_ram_cache(void) {
-    flash_cache_table = port_malloc(FLASH_CACHE_TABLE_SIZE, false);
-    if (flash_cache_table == NULL) {
+static bool allocate_ram_cache_entry(flash_cache_entry_t *entry) {
+    entry->sector = NO_SECTOR_LOADED;
+    entry->dirty_mask = 0;
+    entry->table = port_malloc(FLASH_CACHE_TABLE_SIZE, false);
+    if (entry->table == NULL) {
         // Not enough space even for the cache table.
         return false;
     }
 
     // Clear all the entries so it's easy to find the last entry.
-    memset(flash_cache_table, 0, FLASH_CACHE_TABLE_SIZE);
+    memset(entry->table, 0, FLASH_CACHE_TABLE_SIZE);
 
     bool success = true;
     for (size_t i = 0; i < BLOCKS_PER_SECTOR && success; i++) {
@@ -367,41 +397,34 @@ static bool allocate_ram_cache(void) {
                 success = false;
                 break;
             }
-            flash_cache_table[i * PAGES_PER_BLOCK + j] = page_cache;
+            entry->table[i * PAGES_PER_BLOCK + j] = page_cache;
         }
     }
 
     // We couldn't allocate enough so give back what we got.
     if (!success) {
-        release_ram_cache();
+        release_ram_cache_entry(entry);
     }
     return success;
 }
 
-// Flush the cached sector from ram onto the flash. We'll free the cache unless
-// keep_cache is true.
-static bool flush_ram_cache(bool keep_cache) {
-    if (flash_cache_table == NULL) {
-        // Nothing to flush because there is no cache.
-        return true;
-    }
+// Flush a sector cached in ram onto the flash. The entry is free afterwards.
+static bool flush_ram_cache_entry(flash_cache_entry_t *entry) {
+    uint32_t sector = entry->sector;
+    uint32_t sector_dirty_mask = entry->dirty_mask;
+    entry->sector = NO_SECTOR_LOADED;
+    entry->dirty_mask = 0;
 
-    if (current_sector == NO_SECTOR_LOADED) {
-        if (!keep_cache) {
-            release_ram_cache();
-        }
-        return true;
-    }
     // First, copy out any blocks that we haven't touched from the sector
     // we've cached. If we don't do this we'll erase the data during the sector
     // erase below.
     bool copy_to_ram_ok = true;
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
-        if ((dirty_mask & (1 << i)) == 0) {
+        if ((sector_dirty_mask & (1 << i)) == 0) {
             for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
                 copy_to_ram_ok = read_flash(
-                    current_sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
-                    flash_cache_table[i * PAGES_PER_BLOCK + j],
+                    sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
+                    entry->table[i * PAGES_PER_BLOCK + j],
                     SPI_FLASH_PAGE_SIZE);
                 if (!copy_to_ram_ok) {
                     break;
@@ -416,21 +439,80 @@ static bool flush_ram_cache(bool keep_cache) {
     if (!copy_to_ram_ok) {
         return false;
     }
-    // Second, erase the current sector.
-    erase_sector(current_sector);
+    // Second, erase the sector.
+    erase_sector(sector);
     // Lastly, write all the data in ram that we've cached.
     for (size_t i = 0; i < BLOCKS_PER_SECTOR; i++) {
         for (size_t j = 0; j < PAGES_PER_BLOCK; j++) {
-            write_flash(current_sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
-                flash_cache_table[i * PAGES_PER_BLOCK + j],
+            write_flash(sector + (i * PAGES_PER_BLOCK + j) * SPI_FLASH_PAGE_SIZE,
+                entry->table[i * PAGES_PER_BLOCK + j],
                 SPI_FLASH_PAGE_SIZE);
         }
     }
+    return true;
+}
+
+// Flush the cached sectors from ram onto the flash, in address order. We'll
+// free the cache unless keep_cache is true.
+static bool flush_ram_cache(bool keep_cache) {
+    bool ok = true;
+    for (;;) {
+        flash_cache_entry_t *next = NULL;
+        for (size_t i = 0; i < flash_cache_allocated; i++) {
+            flash_cache_entry_t *entry = &flash_cache[i];
+            if (entry->sector != NO_SECTOR_LOADED && (next == NULL || entry->sector < next->sector)) {
+                next = entry;
+            }
+        }
+        if (next == NULL) {
+            break;
+        }
+        ok = flush_ram_cache_entry(next) && ok;
+    }
     // We're done with the cache for now so give it back.
     if (!keep_cache) {
         release_ram_cache();
     }
-    return true;
+    return ok;
+}
+
+static flash_cache_entry_t *find_ram_cache_entry(uint32_t sector) {
+    for (size_t i = 0; i < flash_cache_allocated; i++) {
+        if (flash_cache[i].sector == sector) {
+            return &flash_cache[i];
+        }
+    }
+    return NULL;
+}
+
+// Get a free entry to cache a new sector in. This is an unused entry if there
+// is one, then a newly allocated one, and otherwise the least recently used
+// entry after flushing it. Returns NULL if not even one entry fits in ram.
+static flash_cache_entry_t *get_ram_cache_entry(void) {
+    flash_cache_entry_t *lru = NULL;
+    for (size_t i = 0; i < flash_cache_allocated; i++) {
+        flash_cache_entry_t *entry = &flash_cache[i];
+        if (entry->sector == NO_SECTOR_LOADED) {
+            return entry;
+        }
+        if (lru == NULL || (int32_t)(entry->last_use - lru->last_use) < 0) {
+            lru = entry;
+        }
+    }
+    if (flash_cache_allocated < SPI_FLASH_CACHE_SECTORS
+        && allocate_ram_cache_entry(&flash_cache[flash_cache_allocated])) {
+        return &flash_cache[flash_cache_allocated++];
+    }
+    if (lru != NULL) {
+        #ifdef MICROPY_HW_LED_MSC
+        port_pin_set_output_level(MICROPY_HW_LED_MSC, true);
+        #endif
+        flush_ram_cache_entry(lru);
+        #ifdef MICROPY_HW_LED_MSC
+        port_pin_set_output_level(MICROPY_HW_LED_MSC, false);
+        #endif
+    }
+    return lru;
 }
 
 // Delegates to the correct flash flush method depending on the existing cache.
@@ -440,12 +522,11 @@ static void spi_flash_flush_keep_cache(bool keep_cache) {
     port_pin_set_output_level(MICROPY_HW_LED_MSC, true);
     #endif
     // If we've cached to the flash itself flush from there.
-    if (flash_cache_table == NULL) {
+    if (current_sector != NO_SECTOR_LOADED) {
         flush_scratch_flash();
-    } else {
-        flush_ram_cache(keep_cache);
+        current_sector = NO_SECTOR_LOADED;
     }
-    current_sector = NO_SECTOR_LOADED;
+    flush_ram_cache(keep_cache);
     #ifdef MICROPY_HW_LED_MSC
     port_pin_set_output_level(MICROPY_HW_LED_MSC, false);
     #endif
@@ -459,6 +540,22 @@ void supervisor_flash_release_cache(void) {
     spi_flash_flush_keep_cache(false);
 }
 
+bool supervisor_flash_cache_is_full(void) {
+    // The scratch sector holds just one sector.
+    if (current_sector != NO_SECTOR_LOADED) {
+        return true;
+    }
+    if (flash_cache_allocated < SPI_FLASH_CACHE_SECTORS) {
+        return false;
+    }
+    for (size_t i = 0; i < flash_cache_allocated; i++) {
+        if (flash_cache[i].sector == NO_SECTOR_LOADED) {
+            return false;
+        }
+    }
+    return true;
+}
+
 static int32_t convert_block_to_flash_addr(uint32_t block) {
     if (0 <= block && block < supervisor_flash_get_block_count()) {
         // a block in partition 1
@@ -479,19 +576,20 @@ static bool external_flash_read_block(uint8_t *dest, uint32_t block) {
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
     uint32_t mask = 1 << (block_index);
-    // We're reading from the currently cached sector.
-    if (current_sector == this_sector && (mask & dirty_mask) > 0) {
-        if (flash_cache_table != NULL) {
-            for (int i = 0; i < PAGES_PER_BLOCK; i++) {
-                memcpy(dest + i * SPI_FLASH_PAGE_SIZE,
-                    flash_cache_table[block_index * PAGES_PER_BLOCK + i],
-                    SPI_FLASH_PAGE_SIZE);
-            }
-            return true;
-        } else {
-            uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
-            return read_flash(scratch_address, dest, FILESYSTEM_BLOCK_SIZE);
+    // We're reading from a sector cached in ram.
+    flash_cache_entry_t *entry = find_ram_cache_entry(this_sector);
+    if (entry != NULL && (mask & entry->dirty_mask) > 0) {
+        for (int i = 0; i < PAGES_PER_BLOCK; i++) {
+            memcpy(dest + i * SPI_FLASH_PAGE_SIZE,
+                entry->table[block_index * PAGES_PER_BLOCK + i],
+                SPI_FLASH_PAGE_SIZE);
         }
+        return true;
+    }
+    // We're reading from the sector cached in the scratch sector.
+    if (current_sector == this_sector && (mask & dirty_mask) > 0) {
+        uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
+        return read_flash(scratch_address, dest, FILESYSTEM_BLOCK_SIZE);
     }
     return read_flash(address, dest, FILESYSTEM_BLOCK_SIZE);
 }
@@ -509,9 +607,11 @@ static bool external_flash_write_block(const uint8_t *data, uint32_t block) {
     uint32_t this_sector = address & (~(SPI_FLASH_ERASE_SIZE - 1));
     size_t block_index = (address / FILESYSTEM_BLOCK_SIZE) % BLOCKS_PER_SECTOR;
     uint32_t mask = 1 << (block_index);
-    // Flush the cache if we're moving onto a sector or we're writing the
-    // same block again.
-    if (current_sector != this_sector || (mask & dirty_mask) > 0) {
+    // A sector cached in ram takes any number of writes to its blocks. The
+    // scratch sector needs flushing if we're moving onto another sector or
+    // we're writing the same block again.
+    flash_cache_entry_t *entry = find_ram_cache_entry(this_sector);
+    if (entry == NULL && (current_sector != this_sector || (mask & dirty_mask) > 0)) {
         // Check to see if we'd write to an erased page. In that case we
         // can write directly.
         if (page_erased(address)) {
@@ -520,23 +620,29 @@ static bool external_flash_write_block(const uint8_t *data, uint32_t block) {
         if (current_sector != NO_SECTOR_LOADED) {
             supervisor_flash_flush();
         }
-        if (flash_cache_table == NULL && !allocate_ram_cache()) {
+        entry = get_ram_cache_entry();
+        if (entry != NULL) {
+            entry->sector = this_sector;
+            entry->dirty_mask = 0;
+        } else {
             erase_sector(flash_device->total_size - SPI_FLASH_ERASE_SIZE);
             wait_for_flash_ready();
+            current_sector = this_sector;
+            dirty_mask = 0;
         }
-        current_sector = this_sector;
-        dirty_mask = 0;
     }
-    dirty_mask |= mask;
     // Copy the block to the appropriate cache.
-    if (flash_cache_table != NULL) {
+    if (entry != NULL) {
+        entry->dirty_mask |= mask;
+        entry->last_use = ++flash_cache_use_count;
         for (int i = 0; i < PAGES_PER_BLOCK; i++) {
-            memcpy(flash_cache_table[block_index * PAGES_PER_BLOCK + i],
+            memcpy(entry->table[block_index * PAGES_PER_BLOCK + i],
                 data + i * SPI_FLASH_PAGE_SIZE,
                 SPI_FLASH_PAGE_SIZE);
         }
         return true;
     } else {
+        dirty_mask |= mask;
         uint32_t scratch_address = flash_device->total_size - SPI_FLASH_ERASE_SIZE + block_index * FILESYSTEM_BLOCK_SIZE;
         return write_flash(scratch_address, data, FILESYSTEM_BLOCK_SIZE);
     }
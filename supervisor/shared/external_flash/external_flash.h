@@ -24,6 +24,12 @@
 #define SPI_FLASH_MAX_BAUDRATE 8000000
 #endif
 
+// The most erase sectors to cache in ram at once. Each takes
+// SPI_FLASH_ERASE_SIZE bytes of the port heap, allocated only when needed.
+#ifndef SPI_FLASH_CACHE_SECTORS
+#define SPI_FLASH_CACHE_SECTORS (4)
+#endif
+
 void supervisor_external_flash_flush(void);
 
 // Configure anything that needs to get set up before the external flash
@@ -29,10 +29,34 @@ static fs_user_mount_t _saves_usermount;
 
 static volatile uint32_t filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
 volatile bool filesystem_flush_requested = false;
+#if CIRCUITPY_FILESYSTEM_FLUSH_QUIET_MS > 0
+// Counts down from the last sync request. 0 means no flush is pending.
+static volatile uint32_t filesystem_flush_quiet_ms = 0;
+#endif
+
+void filesystem_request_flush(void) {
+    #if CIRCUITPY_FILESYSTEM_FLUSH_QUIET_MS > 0
+    if (supervisor_flash_cache_is_full()) {
+        // Every cached sector is dirty, so waiting can't save another erase
+        // and would only leave more data unwritten.
+        filesystem_flush_quiet_ms = 0;
+        supervisor_flash_flush();
+        return;
+    }
+    // Each request restarts the countdown so that a burst of syncs turns into
+    // one flush. The flush interval still bounds how long data stays cached.
+    filesystem_flush_quiet_ms = CIRCUITPY_FILESYSTEM_FLUSH_QUIET_MS;
+    #else
+    supervisor_flash_flush();
+    #endif
+}
 
 void filesystem_background(void) {
     if (filesystem_flush_requested) {
         filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
+        #if CIRCUITPY_FILESYSTEM_FLUSH_QUIET_MS > 0
+        filesystem_flush_quiet_ms = 0;
+        #endif
         // Flush but keep caches
         supervisor_flash_flush();
         filesystem_flush_requested = false;
@@ -40,6 +64,14 @@ void filesystem_background(void) {
 }
 
 inline void filesystem_tick(void) {
+    #if CIRCUITPY_FILESYSTEM_FLUSH_QUIET_MS > 0
+    if (filesystem_flush_quiet_ms > 0) {
+        filesystem_flush_quiet_ms--;
+        if (filesystem_flush_quiet_ms == 0) {
+            filesystem_flush_requested = true;
+        }
+    }
+    #endif
     if (filesystem_flush_interval_ms == 0) {
         // 0 means not turned on.
         return;
@@ -225,10 +257,17 @@ bool filesystem_init(bool create_allowed, bool force_create) {
     return true;
 }
 
-void PLACE_IN_ITCM(filesystem_flush)(void) {
+void filesystem_sync(void) {
     // Reset interval before next flush.
     filesystem_flush_interval_ms = CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS;
+    #if CIRCUITPY_FILESYSTEM_FLUSH_QUIET_MS > 0
+    filesystem_flush_quiet_ms = 0;
+    #endif
     supervisor_flash_flush();
+}
+
+void PLACE_IN_ITCM(filesystem_flush)(void) {
+    filesystem_sync();
     // Don't keep caches because this is called when starting or stopping the VM.
     supervisor_flash_release_cache();
 }
@@ -10,6 +10,7 @@
 #include "lib/oofatfs/diskio.h"
 #include "lib/oofatfs/ff.h"
 #include "supervisor/flash.h"
+#include "supervisor/filesystem.h"
 #include "supervisor/shared/tick.h"
 
 #define VFS_INDEX 0
@@ -29,6 +30,12 @@ static mp_obj_t supervisor_flash_obj_make_new(const mp_obj_type_t *type, size_t
 }
 
 
+static volatile bool filesystem_dirty = false;
+
+MP_WEAK bool supervisor_flash_cache_is_full(void) {
+    return false;
+}
+
 static bool flash_ioctl(mp_obj_t self_in, size_t cmd, size_t arg, mp_int_t *out_value) {
     if (out_value != NULL) {
         *out_value = 0;
@@ -43,7 +50,11 @@ static bool flash_ioctl(mp_obj_t self_in, size_t cmd, size_t arg, mp_int_t *out_
             supervisor_flash_flush();
             break; // TODO properly
         case MP_BLOCKDEV_IOCTL_SYNC:
-            supervisor_flash_flush();
+            // FatFs syncs on every file flush and close. Let the writes from
+            // several of them share one flash erase and program cycle.
+            if (filesystem_dirty) {
+                filesystem_request_flush();
+            }
             break;
         case MP_BLOCKDEV_IOCTL_BLOCK_COUNT:
             *out_value = PART1_START_BLOCK;
@@ -149,8 +160,6 @@ static mp_uint_t flash_read_blocks(mp_obj_t self_in, uint8_t *dest, uint32_t blo
     return supervisor_flash_read_blocks(dest, block_num, num_blocks);
 }
 
-static volatile bool filesystem_dirty = false;
-
 static mp_uint_t flash_write_blocks(mp_obj_t self_in, const uint8_t *src, uint32_t block_num, uint32_t num_blocks) {
     if (block_num == 0) {
         if (num_blocks > 1) {
@@ -27,6 +27,10 @@
 #include "shared-module/keypad/__init__.h"
 #endif
 
+#if MICROPY_PROF_SAMPLING
+#include "py/profile.h"
+#endif
+
 #include "shared-bindings/microcontroller/__init__.h"
 
 #if CIRCUITPY_WATCHDOG
@@ -73,7 +77,7 @@ bool supervisor_background_ticks_ok(void) {
 }
 
 void supervisor_tick(void) {
-    #if CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS > 0
+    #if CIRCUITPY_FILESYSTEM_FLUSH_INTERVAL_MS > 0 || CIRCUITPY_FILESYSTEM_FLUSH_QUIET_MS > 0
     filesystem_tick();
     #endif
 
@@ -82,7 +86,11 @@ void supervisor_tick(void) {
     keypad_tick();
     #endif
 
-    background_callback_add(&tick_callback, supervisor_background_tick, NULL);
+    #if MICROPY_PROF_SAMPLING
+    mp_prof_sample();
+    #endif
+
+    background_callback_add_priority(&tick_callback, supervisor_background_tick, NULL, BACKGROUND_CALLBACK_PRIORITY_DISPLAY);
 }
 
 uint64_t supervisor_ticks_ms64() {
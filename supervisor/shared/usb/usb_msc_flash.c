@@ -16,6 +16,7 @@
 #include "py/mpstate.h"
 
 #include "shared-module/storage/__init__.h"
+#include "supervisor/background_callback.h"
 #include "supervisor/filesystem.h"
 #include "supervisor/shared/reload.h"
 
@@ -153,6 +154,76 @@ static fs_user_mount_t *get_vfs(int lun) {
     return NULL;
 }
 
+#if CIRCUITPY_USB_MSC_PIPELINE
+// Disk access is overlapped with USB transfers using one buffer and a
+// background callback, which runs after TinyUSB has queued the next transfer.
+// WRITE10 data is copied into the buffer and written to the disk from the
+// callback, while the next chunk is received. After a READ10, the callback
+// reads the following blocks into the buffer, while the data is sent.
+//
+// Because WRITE10 succeeds before its data is written, a failed write is
+// remembered and reported as a medium error on the next command to the LUN,
+// and autoreload waits until the last chunk has been written.
+typedef enum {
+    MSC_BUF_IDLE,
+    MSC_BUF_WRITE_PENDING,
+    MSC_BUF_READ_AHEAD_PENDING,
+    MSC_BUF_READ_AHEAD_VALID,
+} msc_buf_state_t;
+
+static uint8_t _msc_buf[CFG_TUD_MSC_BUFSIZE];
+static msc_buf_state_t _msc_buf_state = MSC_BUF_IDLE;
+static uint8_t _msc_buf_lun;
+static uint32_t _msc_buf_lba;
+static uint32_t _msc_buf_block_count;
+static background_callback_t _msc_buf_callback;
+static bool _msc_buf_write_failed[LUN_COUNT];
+static bool _msc_buf_autoreload_pending;
+
+// Write out any pending WRITE10 data, and forget any read-ahead.
+static void _msc_buf_sync(void) {
+    if (_msc_buf_state == MSC_BUF_WRITE_PENDING) {
+        fs_user_mount_t *vfs = get_vfs(_msc_buf_lun);
+        if (vfs == NULL || disk_write(vfs, _msc_buf, _msc_buf_lba, _msc_buf_block_count) != RES_OK) {
+            _msc_buf_write_failed[_msc_buf_lun] = true;
+        }
+    }
+    _msc_buf_state = MSC_BUF_IDLE;
+    if (_msc_buf_autoreload_pending) {
+        // The WRITE10 that completed last has now reached the disk.
+        _msc_buf_autoreload_pending = false;
+        autoreload_resume(AUTORELOAD_SUSPEND_USB);
+        autoreload_trigger();
+    }
+}
+
+// Returns true, and sets the sense data, if a deferred write to lun failed
+// since the last time this was checked.
+static bool _msc_buf_report_write_error(uint8_t lun) {
+    if (lun >= LUN_COUNT || !_msc_buf_write_failed[lun]) {
+        return false;
+    }
+    _msc_buf_write_failed[lun] = false;
+    // Write error.
+    tud_msc_set_sense(lun, SCSI_SENSE_MEDIUM_ERROR, 0x0C, 0x00);
+    return true;
+}
+
+static void _msc_buf_background(void *unused) {
+    (void)unused;
+    if (_msc_buf_state == MSC_BUF_WRITE_PENDING) {
+        _msc_buf_sync();
+    } else if (_msc_buf_state == MSC_BUF_READ_AHEAD_PENDING) {
+        fs_user_mount_t *vfs = get_vfs(_msc_buf_lun);
+        if (vfs != NULL && disk_read(vfs, _msc_buf, _msc_buf_lba, _msc_buf_block_count) == RES_OK) {
+            _msc_buf_state = MSC_BUF_READ_AHEAD_VALID;
+        } else {
+            _msc_buf_state = MSC_BUF_IDLE;
+        }
+    }
+}
+#endif
+
 static void _usb_msc_uneject(void) {
     for (uint8_t i = 0; i < LUN_COUNT; i++) {
         ejected[i] = false;
@@ -165,6 +236,9 @@ void usb_msc_mount(void) {
 }
 
 void usb_msc_umount(void) {
+    #if CIRCUITPY_USB_MSC_PIPELINE
+    _msc_buf_sync();
+    #endif
     for (uint8_t i = 0; i < LUN_COUNT; i++) {
         fs_user_mount_t *vfs = get_vfs(i);
         if (vfs == NULL) {
@@ -176,6 +250,9 @@ void usb_msc_umount(void) {
 }
 
 void usb_msc_remount(fs_user_mount_t *fs_mount) {
+    #if CIRCUITPY_USB_MSC_PIPELINE
+    _msc_buf_sync();
+    #endif
     for (uint8_t i = 0; i < LUN_COUNT; i++) {
         fs_user_mount_t *vfs = get_vfs(i);
         if (vfs == NULL || vfs != fs_mount) {
@@ -197,6 +274,15 @@ int32_t tud_msc_scsi_cb(uint8_t lun, const uint8_t scsi_cmd[16], void *buffer, u
     const void *response = NULL;
     int32_t resplen = 0;
 
+    #if CIRCUITPY_USB_MSC_PIPELINE
+    // This includes SYNCHRONIZE CACHE, which is the host's usual way to find
+    // out that its writes have been stored.
+    _msc_buf_sync();
+    if (_msc_buf_report_write_error(lun)) {
+        return -1;
+    }
+    #endif
+
     switch (scsi_cmd[0]) {
         case SCSI_CMD_PREVENT_ALLOW_MEDIUM_REMOVAL:
             // Host is about to read/write etc ... better not to disconnect disk
@@ -266,7 +352,35 @@ int32_t tud_msc_read10_cb(uint8_t lun, uint32_t lba, uint32_t offset, void *buff
         return -1;
     }
 
+    #if CIRCUITPY_USB_MSC_PIPELINE
+    if (_msc_buf_state == MSC_BUF_WRITE_PENDING) {
+        _msc_buf_sync();
+    }
+    if (_msc_buf_report_write_error(lun)) {
+        return -1;
+    }
+    if (_msc_buf_state == MSC_BUF_READ_AHEAD_VALID && _msc_buf_lun == lun &&
+        _msc_buf_lba == lba && _msc_buf_block_count == block_count) {
+        memcpy(buffer, _msc_buf, bufsize);
+    } else {
+        // A read-ahead that hasn't run yet is abandoned here.
+        _msc_buf_sync();
+        disk_read(vfs, buffer, lba, block_count);
+    }
+    // Read the next blocks while this data is sent, assuming a sequential
+    // read. Only do this while the host has the drive to itself, because
+    // otherwise CircuitPython could change the blocks in the meantime.
+    _msc_buf_state = MSC_BUF_IDLE;
+    if (locked[lun] && lba + 2 * block_count <= disk_block_count) {
+        _msc_buf_state = MSC_BUF_READ_AHEAD_PENDING;
+        _msc_buf_lun = lun;
+        _msc_buf_lba = lba + block_count;
+        _msc_buf_block_count = block_count;
+        background_callback_add_priority(&_msc_buf_callback, _msc_buf_background, NULL, BACKGROUND_CALLBACK_PRIORITY_USB);
+    }
+    #else
     disk_read(vfs, buffer, lba, block_count);
+    #endif
 
     return block_count * MSC_FLASH_BLOCK_SIZE;
 }
@@ -276,12 +390,31 @@ int32_t tud_msc_read10_cb(uint8_t lun, uint32_t lba, uint32_t offset, void *buff
 int32_t tud_msc_write10_cb(uint8_t lun, uint32_t lba, uint32_t offset, uint8_t *buffer, uint32_t bufsize) {
     (void)lun;
     (void)offset;
+
+    #if CIRCUITPY_USB_MSC_PIPELINE
+    // Finish the previous chunk, then write this one while the next is received.
+    _msc_buf_sync();
+    if (_msc_buf_report_write_error(lun)) {
+        // Don't leave autoreload suspended by earlier chunks of a failed command.
+        autoreload_resume(AUTORELOAD_SUSPEND_USB);
+        return -1;
+    }
+    #endif
     autoreload_suspend(AUTORELOAD_SUSPEND_USB);
 
     const uint32_t block_count = bufsize / MSC_FLASH_BLOCK_SIZE;
 
     fs_user_mount_t *vfs = get_vfs(lun);
+    #if CIRCUITPY_USB_MSC_PIPELINE
+    memcpy(_msc_buf, buffer, bufsize);
+    _msc_buf_state = MSC_BUF_WRITE_PENDING;
+    _msc_buf_lun = lun;
+    _msc_buf_lba = lba;
+    _msc_buf_block_count = block_count;
+    background_callback_add_priority(&_msc_buf_callback, _msc_buf_background, NULL, BACKGROUND_CALLBACK_PRIORITY_USB);
+    #else
     disk_write(vfs, buffer, lba, block_count);
+    #endif
     // Since by getting here we assume the mount is read-only to
     // MicroPython let's update the cached FatFs sector if it's the one
     // we just wrote.
@@ -306,6 +439,14 @@ int32_t tud_msc_write10_cb(uint8_t lun, uint32_t lba, uint32_t offset, uint8_t *
 void tud_msc_write10_complete_cb(uint8_t lun) {
     (void)lun;
 
+    #if CIRCUITPY_USB_MSC_PIPELINE
+    if (_msc_buf_state == MSC_BUF_WRITE_PENDING) {
+        // The last chunk is still being written; autoreload once it is done.
+        _msc_buf_autoreload_pending = true;
+        return;
+    }
+    #endif
+
     // This write is complete; initiate an autoreload.
     autoreload_resume(AUTORELOAD_SUSPEND_USB);
     autoreload_trigger();
@@ -338,6 +479,14 @@ bool tud_msc_test_unit_ready_cb(uint8_t lun) {
     if (current_mount == NULL) {
         return false;
     }
+    #if CIRCUITPY_USB_MSC_PIPELINE
+    if (_msc_buf_state == MSC_BUF_WRITE_PENDING) {
+        _msc_buf_sync();
+    }
+    if (_msc_buf_report_write_error(lun)) {
+        return false;
+    }
+    #endif
     if (ejected[lun] || eject_once[lun]) {
         eject_once[lun] = false;
         // Set 0x3a for media not present.
@@ -359,12 +508,19 @@ bool tud_msc_start_stop_cb(uint8_t lun, uint8_t power_condition, bool start, boo
     if (current_mount == NULL) {
         return false;
     }
+    #if CIRCUITPY_USB_MSC_PIPELINE
+    _msc_buf_sync();
+    if (_msc_buf_report_write_error(lun)) {
+        return false;
+    }
+    #endif
     if (load_eject) {
         if (!start) {
             // Eject but first flush.
             if (disk_ioctl(current_mount, CTRL_SYNC, NULL) != RES_OK) {
                 return false;
             } else {
+                filesystem_sync();
                 blockdev_unlock(current_mount);
                 ejected[lun] = true;
                 locked[lun] = false;
@@ -379,6 +535,7 @@ bool tud_msc_start_stop_cb(uint8_t lun, uint8_t power_condition, bool start, boo
             if (disk_ioctl(current_mount, CTRL_SYNC, NULL) != RES_OK) {
                 return false;
             }
+            filesystem_sync();
         }
         // Always start the unit, even if ejected. Whether media is present is a separate check.
     }
@@ -21,6 +21,7 @@
 #include "supervisor/fatfs.h"
 #include "supervisor/filesystem.h"
 #include "supervisor/port.h"
+#include "supervisor/port_heap.h"
 #include "supervisor/shared/reload.h"
 #include "supervisor/shared/web_workflow/web_workflow.h"
 #include "supervisor/shared/web_workflow/websocket.h"
@@ -68,6 +69,7 @@ typedef struct {
     char header_value[256];
     char origin[64];        // We store the origin so we can reply back with it.
     char host[64];          // We store the host to check against origin.
+    char if_none_match[64]; // ETags the client already has cached.
     size_t content_length;
     size_t offset;
     uint64_t timestamp_ms;
@@ -79,6 +81,7 @@ typedef struct {
     bool json;
     bool websocket;
     bool new_socket;
+    bool keep_alive;
     uint32_t websocket_version;
     // RFC6455 for websockets says this header should be 24 base64 characters long.
     char websocket_key[24 + 1];
@@ -101,9 +104,21 @@ static mp_int_t web_api_port = 80;
 
 static socketpool_socketpool_obj_t pool;
 static socketpool_socket_obj_t listening;
-static socketpool_socket_obj_t active;
 
-static _request active_request;
+// Number of client connections served at once. Browsers open several
+// connections to load a page, so a single connection serializes them.
+#ifndef WEB_WORKFLOW_CONNECTIONS
+#define WEB_WORKFLOW_CONNECTIONS (3)
+#endif
+
+typedef struct {
+    socketpool_socket_obj_t socket;
+    _request request;
+} _connection;
+
+static _connection connections[WEB_WORKFLOW_CONNECTIONS];
+// New sockets are accepted here and then moved into a connection slot.
+static socketpool_socket_obj_t incoming;
 
 static char _api_password[64];
 static char web_instance_name[50];
@@ -310,7 +325,10 @@ bool supervisor_start_web_workflow(void) {
         common_hal_socketpool_socketpool_construct(&pool, &common_hal_wifi_radio_obj);
 
         socketpool_socket_reset(&listening);
-        socketpool_socket_reset(&active);
+        socketpool_socket_reset(&incoming);
+        for (size_t i = 0; i < WEB_WORKFLOW_CONNECTIONS; i++) {
+            socketpool_socket_reset(&connections[i].socket);
+        }
 
         websocket_init();
     }
@@ -318,8 +336,10 @@ bool supervisor_start_web_workflow(void) {
     initialized = pool.base.type == &socketpool_socketpool_type;
 
     if (initialized) {
-        if (!common_hal_socketpool_socket_get_closed(&active)) {
-            common_hal_socketpool_socket_close(&active);
+        for (size_t i = 0; i < WEB_WORKFLOW_CONNECTIONS; i++) {
+            if (!common_hal_socketpool_socket_get_closed(&connections[i].socket)) {
+                common_hal_socketpool_socket_close(&connections[i].socket);
+            }
         }
 
         #if CIRCUITPY_MDNS
@@ -346,7 +366,7 @@ bool supervisor_start_web_workflow(void) {
             common_hal_socketpool_socket_settimeout(&listening, 0);
             // Bind to any ip. (Not checking for failures)
             common_hal_socketpool_socket_bind(&listening, "", 0, web_api_port);
-            common_hal_socketpool_socket_listen(&listening, 1);
+            common_hal_socketpool_socket_listen(&listening, WEB_WORKFLOW_CONNECTIONS);
         }
         // Wake polling thread (maybe)
         socketpool_socket_poll_resume();
@@ -625,11 +645,27 @@ static void _reply_server_error(socketpool_socket_obj_t *socket, _request *reque
     _send_final_str(socket, "\r\n");
 }
 
+static void _reply_not_modified(socketpool_socket_obj_t *socket, _request *request, const char *etag) {
+    _send_strs(socket,
+        "HTTP/1.1 304 Not Modified\r\n",
+        "ETag: ", etag, "\r\n", NULL);
+    _cors_header(socket, request);
+    _send_final_str(socket, "\r\n");
+}
+
+// True when the client sent an If-None-Match header listing etag. ETags are
+// quoted so a match can't start or end part way through another one.
+static bool _etag_matches(_request *request, const char *etag) {
+    return strstr(request->if_none_match, etag) != NULL ||
+           strcmp(request->if_none_match, "*") == 0;
+}
+
 #if CIRCUITPY_MDNS
 static void _reply_redirect(socketpool_socket_obj_t *socket, _request *request, const char *path) {
     int nodelay = 1;
     common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
     const char *hostname = common_hal_mdns_server_get_hostname(&mdns);
+    request->keep_alive = false;
     _send_strs(socket,
         "HTTP/1.1 307 Temporary Redirect\r\n",
         "Connection: close\r\n",
@@ -736,12 +772,47 @@ static void _reply_directory_json(socketpool_socket_obj_t *socket, _request *req
     _send_chunk(socket, "");
 }
 
-static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request, const char *filename, FIL *active_file) {
+// File data is moved in buffers of up to one cluster, so that FatFs can read
+// and write whole clusters directly and each socket call moves a lot of data.
+#define FILE_BUFFER_MAX_SIZE (4096)
+
+// Allocate a file buffer from the port heap. Returns NULL if not even one
+// sector's worth is available, in which case the caller should use a small
+// buffer of its own.
+static uint8_t *_allocate_file_buffer(FATFS *fs, size_t *size) {
+    #if FF_MAX_SS != FF_MIN_SS
+    size_t buffer_size = fs->csize * fs->ssize;
+    #else
+    size_t buffer_size = fs->csize * FF_MAX_SS;
+    #endif
+    buffer_size = MIN(buffer_size, FILE_BUFFER_MAX_SIZE);
+    while (buffer_size >= FF_MIN_SS) {
+        uint8_t *buffer = port_malloc(buffer_size, false);
+        if (buffer != NULL) {
+            *size = buffer_size;
+            return buffer;
+        }
+        buffer_size /= 2;
+    }
+    return NULL;
+}
+
+// The ETag of a user file is its size and FatFs modification time. Clients
+// must still revalidate each time because the time only has two second
+// resolution.
+static void _file_etag(const FILINFO *file_info, char *etag, size_t etag_size) {
+    snprintf(etag, etag_size, "\"%08" PRIx32 "-%04x%04x\"", (uint32_t)file_info->fsize, file_info->fdate, file_info->ftime);
+}
+
+static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request, const char *filename, FIL *active_file, const char *etag) {
     uint32_t total_length = f_size(active_file);
 
     _send_str(socket, "HTTP/1.1 200 OK\r\n");
     mp_print_t _socket_print = {socket, _print_raw};
     mp_printf(&_socket_print, "Content-Length: %d\r\n", total_length);
+    _send_strs(socket,
+        "ETag: ", etag, "\r\n",
+        "Cache-Control: no-cache\r\n", NULL);
     // TODO: Make this a table to save space.
     if (_endswith(filename, ".txt") || _endswith(filename, ".py") || _endswith(filename, ".toml")) {
         _send_strs(socket, "Content-Type:", "text/plain", ";charset=UTF-8\r\n", NULL);
@@ -757,16 +828,28 @@ static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request,
     _cors_header(socket, request);
     _send_str(socket, "\r\n");
 
+    uint8_t small_buffer[64];
+    size_t buffer_size;
+    uint8_t *data_buffer = _allocate_file_buffer(active_file->obj.fs, &buffer_size);
+    if (data_buffer == NULL) {
+        data_buffer = small_buffer;
+        buffer_size = sizeof(small_buffer);
+    }
+
+    // Each send copies the data into the network stack, which transmits it
+    // while the next chunk is read from the file.
     uint32_t total_read = 0;
     int nodelay_ok = -1;
-    while (total_read < total_length) {
-        uint8_t data_buffer[64];
+    bool error = false;
+    while (total_read < total_length && !error) {
         size_t quantity_read;
-        f_read(active_file, data_buffer, 64, &quantity_read);
+        if (f_read(active_file, data_buffer, buffer_size, &quantity_read) != FR_OK || quantity_read == 0) {
+            break;
+        }
         total_read += quantity_read;
         // When getting near the end of the file, disable Nagle's combining algorithm so that
         // data is sent immediately.
-        if (total_length - total_read < 64) {
+        if (total_length - total_read < buffer_size) {
             int nodelay = 1;
             // Returns 0 when it works.
             nodelay_ok = common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
@@ -778,13 +861,17 @@ static void _reply_with_file(socketpool_socket_obj_t *socket, _request *request,
                 if (sent == -MP_EAGAIN) {
                     sent = 0;
                 } else {
+                    error = true;
                     break;
                 }
             }
             send_offset += sent;
         }
     }
-    if (total_read < total_length) {
+    if (data_buffer != small_buffer) {
+        port_free(data_buffer);
+    }
+    if (total_read < total_length || error) {
         socketpool_socket_close(socket);
     }
 
@@ -1025,12 +1112,22 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
     f_truncate(&active_file);
     f_rewind(&active_file);
 
+    uint8_t small_buffer[64];
+    size_t buffer_size;
+    uint8_t *bytes = _allocate_file_buffer(fs, &buffer_size);
+    if (bytes == NULL) {
+        bytes = small_buffer;
+        buffer_size = sizeof(small_buffer);
+    }
+
+    // Fill the buffer before each write, so that whole clusters are written
+    // at once rather than whatever each recv happened to return.
     size_t total_read = 0;
+    size_t buffered = 0;
     bool error = false;
     while (total_read < request->content_length && !error) {
-        uint8_t bytes[64];
-        size_t read_len = MIN(sizeof(bytes), request->content_length - total_read);
-        int len = socketpool_socket_recv_into(socket, bytes, read_len);
+        size_t read_len = MIN(buffer_size - buffered, request->content_length - total_read);
+        int len = socketpool_socket_recv_into(socket, bytes + buffered, read_len);
         if (len < 0) {
             if (len == -MP_EAGAIN) {
                 continue;
@@ -1039,13 +1136,20 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
             break;
         }
         total_read += len;
-        UINT actual;
-        f_write(&active_file, bytes, len, &actual);
-        if (actual < (UINT)len) {
-            error = true;
-            break;
+        buffered += len;
+        if (buffered == buffer_size || total_read == request->content_length) {
+            UINT actual;
+            f_write(&active_file, bytes, buffered, &actual);
+            if (actual < (UINT)buffered) {
+                error = true;
+                break;
+            }
+            buffered = 0;
         }
     }
+    if (bytes != small_buffer) {
+        port_free(bytes);
+    }
 
     f_close(&active_file);
     filesystem_unlock(fs_mount);
@@ -1061,7 +1165,7 @@ static void _write_file_and_reply(socketpool_socket_obj_t *socket, _request *req
     }
 }
 
-#define STATIC_FILE(filename) extern uint32_t filename##_length; extern uint8_t filename[]; extern const char *filename##_content_type;
+#define STATIC_FILE(filename) extern uint32_t filename##_length; extern uint8_t filename[]; extern const char *filename##_content_type; extern const char *filename##_etag;
 
 STATIC_FILE(code_html);
 STATIC_FILE(directory_html);
@@ -1075,7 +1179,13 @@ STATIC_FILE(serial_html);
 STATIC_FILE(serial_js);
 STATIC_FILE(blinka_32x32_ico);
 
-static void _reply_static(socketpool_socket_obj_t *socket, _request *request, const uint8_t *response, size_t response_len, const char *content_type) {
+static void _reply_static(socketpool_socket_obj_t *socket, _request *request, const uint8_t *response, size_t response_len, const char *content_type, const char *etag) {
+    // The static files only change with the firmware, so a cached copy can be
+    // confirmed without sending it again.
+    if (_etag_matches(request, etag)) {
+        _reply_not_modified(socket, request, etag);
+        return;
+    }
     uint32_t total_length = response_len;
     char encoded_len[10];
     snprintf(encoded_len, sizeof(encoded_len), "%" PRIu32, total_length);
@@ -1085,11 +1195,13 @@ static void _reply_static(socketpool_socket_obj_t *socket, _request *request, co
         "Content-Encoding: gzip\r\n",
         "Content-Length: ", encoded_len, "\r\n",
         "Content-Type: ", content_type, "\r\n",
+        "ETag: ", etag, "\r\n",
+        "Cache-Control: no-cache\r\n",
         "\r\n", NULL);
     web_workflow_send_raw(socket, true, response, response_len);
 }
 
-#define _REPLY_STATIC(socket, request, filename) _reply_static(socket, request, filename, filename##_length, filename##_content_type)
+#define _REPLY_STATIC(socket, request, filename) _reply_static(socket, request, filename, filename##_length, filename##_content_type, filename##_etag)
 
 static void _reply_websocket_upgrade(socketpool_socket_obj_t *socket, _request *request) {
     // Compute accept key
@@ -1278,6 +1390,16 @@ static bool _reply(socketpool_socket_obj_t *socket, _request *request) {
             FATFS *fs = &fs_mount->fatfs;
             if (directory) {
                 if (strcasecmp(request->method, "GET") == 0) {
+                    // The directory page fetches the listing itself as JSON, so
+                    // it can be served without touching the filesystem.
+                    if (!request->json) {
+                        if (pathlen == 1) {
+                            _REPLY_STATIC(socket, request, directory_html);
+                        } else {
+                            _reply_missing(socket, request);
+                        }
+                        return false;
+                    }
                     FF_DIR dir;
                     FRESULT res = f_opendir(fs, &dir, path);
                     // Put the / back for replies.
@@ -1288,25 +1410,31 @@ static bool _reply(socketpool_socket_obj_t *socket, _request *request) {
                         _reply_missing(socket, request);
                         return false;
                     }
-                    if (request->json) {
-                        _reply_directory_json(socket, request, fs_mount, &dir, request->path, path);
-                    } else if (pathlen == 1) {
-                        _REPLY_STATIC(socket, request, directory_html);
-                    } else {
-                        _reply_missing(socket, request);
-                    }
+                    _reply_directory_json(socket, request, fs_mount, &dir, request->path, path);
 
                     f_closedir(&dir);
                 }
             } else { // Dealing with a file.
                 if (strcasecmp(request->method, "GET") == 0) {
+                    FILINFO file_info;
+                    if (f_stat(fs, path, &file_info) != FR_OK) {
+                        _reply_missing(socket, request);
+                        return false;
+                    }
+                    char etag[24];
+                    _file_etag(&file_info, etag, sizeof(etag));
+                    if (_etag_matches(request, etag)) {
+                        _reply_not_modified(socket, request, etag);
+                        return false;
+                    }
+
                     FIL active_file;
                     FRESULT result = f_open(fs, &active_file, path, FA_READ);
 
                     if (result != FR_OK) {
                         _reply_missing(socket, request);
                     } else {
-                        _reply_with_file(socket, request, path, &active_file);
+                        _reply_with_file(socket, request, path, &active_file, etag);
                     }
 
                     f_close(&active_file);
@@ -1388,6 +1516,7 @@ static void _reset_request(_request *request) {
     request->state = STATE_METHOD;
     request->origin[0] = '\0';
     request->host[0] = '\0';
+    request->if_none_match[0] = '\0';
     request->content_length = 0;
     request->offset = 0;
     request->timestamp_ms = 0;
@@ -1395,12 +1524,23 @@ static void _reset_request(_request *request) {
     request->done = false;
     request->in_progress = false;
     request->new_socket = false;
+    request->keep_alive = true;
     request->authenticated = false;
     request->expect = false;
     request->json = false;
     request->websocket = false;
 }
 
+// Autoreload stays suspended while any connection is in the middle of a request.
+static void _autoreload_resume_if_idle(void) {
+    for (size_t i = 0; i < WEB_WORKFLOW_CONNECTIONS; i++) {
+        if (connections[i].request.in_progress) {
+            return;
+        }
+    }
+    autoreload_resume(AUTORELOAD_SUSPEND_WEB);
+}
+
 static void _process_request(socketpool_socket_obj_t *socket, _request *request) {
     bool more = true;
     bool error = false;
@@ -1507,6 +1647,11 @@ static void _process_request(socketpool_socket_obj_t *socket, _request *request)
                     } else if (strcasecmp(request->header_key, "Origin") == 0) {
                         strncpy(request->origin, request->header_value, sizeof(request->origin) - 1);
                         request->origin[sizeof(request->origin) - 1] = '\0';
+                    } else if (strcasecmp(request->header_key, "If-None-Match") == 0) {
+                        strncpy(request->if_none_match, request->header_value, sizeof(request->if_none_match) - 1);
+                        request->if_none_match[sizeof(request->if_none_match) - 1] = '\0';
+                    } else if (strcasecmp(request->header_key, "Connection") == 0) {
+                        request->keep_alive = strcasecmp(request->header_value, "close") != 0;
                     } else if (strcasecmp(request->header_key, "X-Timestamp") == 0) {
                         request->timestamp_ms = strtoull(request->header_value, NULL, 10);
                     } else if (strcasecmp(request->header_key, "Upgrade") == 0) {
@@ -1540,14 +1685,20 @@ static void _process_request(socketpool_socket_obj_t *socket, _request *request)
         common_hal_socketpool_socket_setsockopt(socket, SOCKETPOOL_IPPROTO_TCP, SOCKETPOOL_TCP_NODELAY, &nodelay, sizeof(nodelay));
         socketpool_socket_send(socket, (const uint8_t *)error_response, strlen(error_response));
         request->done = true;
+        request->keep_alive = false;
     }
     if (!request->done) {
         return;
     }
     bool reload = _reply(socket, request);
+    // Only reuse the connection when no request body could be left unread in
+    // the socket. Otherwise it would be parsed as the start of the next request.
+    bool keep_alive = request->keep_alive && request->content_length == 0;
     _reset_request(request);
-    common_hal_socketpool_socket_close(socket);
-    autoreload_resume(AUTORELOAD_SUSPEND_WEB);
+    if (!keep_alive) {
+        common_hal_socketpool_socket_close(socket);
+    }
+    _autoreload_resume_if_idle();
     if (reload) {
         autoreload_trigger();
     }
@@ -1574,46 +1725,66 @@ static bool supervisor_filesystem_access_could_block(void) {
     return false;
 }
 
+// Find a slot for a new connection. When all are in use, an idle keep-alive
+// connection may be given up to make room, as its client can reconnect.
+static _connection *_free_connection(void) {
+    for (size_t i = 0; i < WEB_WORKFLOW_CONNECTIONS; i++) {
+        if (common_hal_socketpool_socket_get_closed(&connections[i].socket)) {
+            return &connections[i];
+        }
+    }
+    for (size_t i = 0; i < WEB_WORKFLOW_CONNECTIONS; i++) {
+        _request *request = &connections[i].request;
+        if (!request->in_progress && !request->new_socket) {
+            return &connections[i];
+        }
+    }
+    return NULL;
+}
+
 void supervisor_web_workflow_background(void *data) {
     // If "/sd" is mounted AND shared with a display, access could block.
     // We don't have a good way to defer a filesystem action way down inside _process_request
     // when this happens, so just postpone if there's a chance of blocking. (#8980)
     while (!supervisor_filesystem_access_could_block()) {
-        // If we have a request in progress, continue working on it. Do this first
-        // so that we can accept another socket after finishing this request.
-        if (common_hal_socketpool_socket_get_connected(&active)) {
-            _process_request(&active, &active_request);
-            if (active_request.in_progress) {
-                break;
-            }
-        } else {
-            // Close the active socket if necessary
-            if (!common_hal_socketpool_socket_get_closed(&active)) {
-                common_hal_socketpool_socket_close(&active);
+        // Continue working on every connection first so that requests in
+        // progress are not starved by new connections.
+        for (size_t i = 0; i < WEB_WORKFLOW_CONNECTIONS; i++) {
+            _connection *connection = &connections[i];
+            if (common_hal_socketpool_socket_get_connected(&connection->socket)) {
+                _process_request(&connection->socket, &connection->request);
+            } else if (!common_hal_socketpool_socket_get_closed(&connection->socket)) {
+                // Close the socket if the client has gone away.
+                common_hal_socketpool_socket_close(&connection->socket);
             }
         }
-        // Otherwise, see if we have another socket to accept.
-        if ((!common_hal_socketpool_socket_get_connected(&active) ||
-             (!active_request.in_progress && !active_request.new_socket)) &&
-            !common_hal_socketpool_socket_get_closed(&listening)) {
-            if (!common_hal_socketpool_socket_get_closed(&active)) {
-                common_hal_socketpool_socket_close(&active);
-            }
-            int newsoc = socketpool_socket_accept(&listening, NULL, &active);
-            if (newsoc == -EBADF) {
-                common_hal_socketpool_socket_close(&listening);
-                break;
-            }
-            if (newsoc > 0) {
-                common_hal_socketpool_socket_settimeout(&active, 0);
-                _reset_request(&active_request);
-                // Mark new sockets, otherwise we may accept another before the first
-                // could start its request.
-                active_request.new_socket = true;
-                continue;
-            }
+        // Then see if we have another socket to accept.
+        if (common_hal_socketpool_socket_get_closed(&listening)) {
+            break;
+        }
+        _connection *connection = _free_connection();
+        if (connection == NULL) {
             break;
         }
+        int newsoc = socketpool_socket_accept(&listening, NULL, &incoming);
+        if (newsoc == -EBADF) {
+            common_hal_socketpool_socket_close(&listening);
+            break;
+        }
+        if (newsoc > 0) {
+            // Only close an idle connection once there is a new one to replace it.
+            if (!common_hal_socketpool_socket_get_closed(&connection->socket)) {
+                common_hal_socketpool_socket_close(&connection->socket);
+            }
+            socketpool_socket_move(&incoming, &connection->socket);
+            common_hal_socketpool_socket_settimeout(&connection->socket, 0);
+            _reset_request(&connection->request);
+            // Mark new sockets, otherwise we may reuse the slot for another before
+            // the first could start its request.
+            connection->request.new_socket = true;
+            continue;
+        }
+        break;
     }
 
     // Let the websocket code run.
@@ -24,6 +24,12 @@ bool filesystem_init(bool create_allowed, bool force_create) {
 void filesystem_flush(void) {
 }
 
+void filesystem_request_flush(void) {
+}
+
+void filesystem_sync(void) {
+}
+
 void filesystem_set_internal_writable_by_usb(bool writable) {
     (void)writable;
     return;
@@ -0,0 +1,48 @@
+# test binary ops on small ints, including results that overflow into big ints
+
+# add/subtract crossing the small-int boundary
+x = 1
+for i in range(70):
+    x = x + x
+    y = x - 1
+    print(i, x, y, -x - x, y + 1 == x)
+
+# in-place variants, with a constant operand
+x = 0x3FFFFFFF
+for i in range(40):
+    x += 1
+    x <<= 1
+    x -= 2
+print(x)
+
+# shifts
+for n in (0, 1, 7, 29, 30, 31, 32, 62, 63, 64, 100):
+    print(n, 1 << n, -1 << n, 3 << n, (1 << n) >> n, 12345 >> n, -12345 >> n)
+try:
+    1 << -1
+except ValueError:
+    print("ValueError")
+try:
+    1 >> -1
+except ValueError:
+    print("ValueError")
+
+# bitwise ops
+for a in (0, 1, -1, 0x55, -0x56, 0x3FFFFFFF, -0x40000000):
+    for b in (0, 3, -4, 0x0F0F):
+        print(a & b, a | b, a ^ b)
+        a &= 0xFFFF
+        a |= 1
+        a ^= b
+
+# comparisons, including compare-and-branch
+for a in (-2, 0, 1, 5):
+    for b in (-2, 0, 1, 5):
+        print(a < b, a > b, a == b, a <= b, a >= b, a != b)
+        if a < b:
+            print("lt")
+        if not a >= b:
+            print("not ge")
+
+# operands that are not small ints still go through the generic path
+print(1 + 2.5, 3 - True, 1 < 1.5, 2 == 2.0, (1 << 64) + 1 > 1)
@@ -0,0 +1,54 @@
+from displayio import Bitmap
+import bitmapfilter
+
+
+def make_bitmap(width, height, seed):
+    b = Bitmap(width, height, 65536)
+    for i in range(width * height):
+        seed = (seed * 1103515245 + 12345) & 0x7FFFFFFF
+        b[i] = seed >> 8 & 0xFFFF
+    return b
+
+
+def make_mask(width, height):
+    b = Bitmap(width, height, 2)
+    for y in range(height):
+        for x in range(width):
+            b[x, y] = (x // 3 + y // 2) % 3 == 0
+    return b
+
+
+def checksum(b):
+    s = 0
+    for i in range(b.width * b.height):
+        s = (s * 31 + b[i]) & 0xFFFFFFFF
+    return s
+
+
+kernels = (
+    ("box", (1,) * 9),
+    ("gauss3", (1, 2, 1, 2, 4, 2, 1, 2, 1)),
+    ("gauss5", tuple(a * b for a in (1, 4, 6, 4, 1) for b in (1, 4, 6, 4, 1))),
+    ("sobel", (-1, 0, 1, -2, 0, 2, -1, 0, 1)),
+    ("scaled", (2, 4, 2, 4, 8, 4, 2, 4, 2)),
+    ("row", (0, 0, 0, 1, 2, 1, 0, 0, 0)),
+    ("sharpen", (-1, -2, -1, -2, 4, -2, -1, -2, -1)),
+    ("identity", (0, 0, 0, 0, 1, 0, 0, 0, 0)),
+    ("big", (3, 7, 3, 7, 16, 7, 3, 7, 3)),
+    ("one", (5,)),
+)
+
+mask = make_mask(23, 11)
+for name, weights in kernels:
+    results = []
+    for options in ({}, {"mask": mask}, {"add": 0.25, "mul": 0.02}, {"threshold": True, "offset": 1}):
+        b = make_bitmap(23, 11, len(weights))
+        bitmapfilter.morph(b, weights, **options)
+        results.append(checksum(b))
+    print(name, results)
+
+# images narrower or shorter than the kernel
+for width, height in ((1, 1), (2, 7), (7, 2)):
+    b = make_bitmap(width, height, 3)
+    bitmapfilter.morph(b, kernels[2][1])
+    print(width, height, checksum(b))
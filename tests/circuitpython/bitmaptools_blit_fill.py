@@ -0,0 +1,113 @@
+import displayio
+import bitmaptools
+
+
+def pattern(width, height, bits, seed):
+    bmp = displayio.Bitmap(width, height, 1 << bits)
+    mask = (1 << bits) - 1
+    for y in range(height):
+        for x in range(width):
+            bmp[x, y] = (x * 7 + y * 13 + seed) & mask
+    return bmp
+
+
+def copy(bmp, bits):
+    out = displayio.Bitmap(bmp.width, bmp.height, 1 << bits)
+    bitmaptools.blit(out, bmp, 0, 0)
+    return out
+
+
+def pixels(bmp):
+    return [bmp[x, y] for y in range(bmp.height) for x in range(bmp.width)]
+
+
+def reference_blit(dest, src, x, y, x1, y1, x2, y2, skip_source=None, skip_dest=None):
+    # read the whole source region first, so overlapping copies behave like a
+    # copy from a snapshot of the source
+    values = [[src[i, j] for i in range(x1, x2)] for j in range(y1, y2)]
+    for j, row in enumerate(values):
+        for i, value in enumerate(row):
+            dx, dy = x + i, y + j
+            if dx >= dest.width or dy >= dest.height:
+                continue
+            if skip_source is not None and value == skip_source:
+                continue
+            if skip_dest is not None and dest[dx, dy] == skip_dest:
+                continue
+            dest[dx, dy] = value
+
+
+def reference_fill(dest, x1, y1, x2, y2, value):
+    for y in range(y1, y2):
+        for x in range(x1, x2):
+            dest[x, y] = value
+
+
+for bits in (1, 2, 4, 8, 16):
+    failures = 0
+    mask = (1 << bits) - 1
+    for x, y, x1, y1, x2, y2 in (
+        (0, 0, 0, 0, 13, 9),
+        (3, 1, 0, 0, 13, 9),
+        (5, 2, 3, 1, 12, 8),
+        (1, 4, 2, 0, 11, 3),
+        (9, 0, 1, 1, 3, 2),
+        (20, 5, 0, 0, 13, 9),
+    ):
+        for skip_source, skip_dest in ((None, None), (3 & mask, None), (None, 5 & mask)):
+            src = pattern(13, 9, bits, 1)
+            dest = pattern(24, 11, bits, 2)
+            expected = copy(dest, bits)
+            bitmaptools.blit(
+                dest,
+                src,
+                x,
+                y,
+                x1=x1,
+                y1=y1,
+                x2=x2,
+                y2=y2,
+                skip_source_index=skip_source,
+                skip_dest_index=skip_dest,
+            )
+            reference_blit(expected, src, x, y, x1, y1, x2, y2, skip_source, skip_dest)
+            if pixels(dest) != pixels(expected):
+                failures += 1
+                print("blit", bits, x, y, x1, y1, x2, y2, skip_source, skip_dest)
+
+    # blits of a bitmap into itself
+    for x, y, x1, y1, x2, y2 in (
+        (3, 0, 0, 0, 15, 6),
+        (0, 0, 3, 0, 18, 6),
+        (2, 2, 0, 0, 15, 6),
+        (0, 0, 5, 3, 18, 8),
+        (7, 1, 1, 1, 12, 4),
+    ):
+        for skip_source in (None, 3 & mask):
+            bmp = pattern(18, 8, bits, 3)
+            expected = copy(bmp, bits)
+            bitmaptools.blit(bmp, bmp, x, y, x1=x1, y1=y1, x2=x2, y2=y2, skip_source_index=skip_source)
+            reference_blit(expected, copy(expected, bits), x, y, x1, y1, x2, y2, skip_source)
+            if pixels(bmp) != pixels(expected):
+                failures += 1
+                print("self blit", bits, x, y, x1, y1, x2, y2, skip_source)
+
+    for x1, y1, x2, y2 in (
+        (0, 0, 24, 11),
+        (1, 1, 2, 2),
+        (3, 2, 21, 9),
+        (0, 4, 24, 6),
+        (8, 0, 16, 11),
+        (5, 3, 7, 10),
+        (6, 6, 6, 8),
+    ):
+        dest = pattern(24, 11, bits, 4)
+        expected = copy(dest, bits)
+        value = 0x5A5A5A5A & mask
+        bitmaptools.fill_region(dest, x1, y1, x2, y2, value)
+        reference_fill(expected, x1, y1, x2, y2, value)
+        if pixels(dest) != pixels(expected):
+            failures += 1
+            print("fill", bits, x1, y1, x2, y2)
+
+    print(bits, "bits", failures, "failures")
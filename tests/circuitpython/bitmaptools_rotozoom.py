@@ -0,0 +1,66 @@
+import math
+import displayio
+import bitmaptools
+
+
+def dump(bmp):
+    for y in range(bmp.height):
+        print("".join("%x" % (bmp[x, y] % 16) for x in range(bmp.width)))
+
+
+def make_source(width, height, colors):
+    src = displayio.Bitmap(width, height, colors)
+    for y in range(height):
+        for x in range(width):
+            src[x, y] = (x + 3 * y) % colors
+    return src
+
+
+for colors in (2, 16, 256, 65536):
+    src = make_source(7, 5, colors)
+    print("colors", colors)
+    cases = ((0, 1), (math.pi / 2, 1), (0.5, 1), (-1.2, 1.5), (2.5, 0.75), (math.pi, 2))
+    for i, (angle, scale) in enumerate(cases):
+        dest = displayio.Bitmap(12, 10, colors)
+        dest.fill(colors - 1)
+        bitmaptools.rotozoom(dest, src, angle=angle, scale=scale)
+        print("case", i)
+        dump(dest)
+
+# source and destination clipping, skip_index
+src = make_source(8, 8, 256)
+dest = displayio.Bitmap(16, 12, 256)
+dest.fill(0xAB)
+bitmaptools.rotozoom(
+    dest,
+    src,
+    ox=5,
+    oy=4,
+    dest_clip0=(2, 1),
+    dest_clip1=(13, 10),
+    px=2,
+    py=3,
+    source_clip0=(1, 1),
+    source_clip1=(6, 7),
+    angle=0.3,
+    scale=1.7,
+    skip_index=4,
+)
+dump(dest)
+
+# a source that is drawn entirely off the destination
+dest.fill(0)
+bitmaptools.rotozoom(dest, src, ox=-40, oy=-40, angle=1)
+print(sum(dest[i] for i in range(dest.width * dest.height)))
+
+# a zero scale draws nothing
+bitmaptools.rotozoom(dest, src, scale=0)
+print(sum(dest[i] for i in range(dest.width * dest.height)))
+
+# 16 bit source into a 16 bit destination
+src = displayio.Bitmap(4, 4, 65536)
+for i in range(16):
+    src[i] = 0x0F0F * i
+dest = displayio.Bitmap(6, 6, 65536)
+bitmaptools.rotozoom(dest, src, angle=math.pi / 2)
+print([hex(dest[i]) for i in range(36)])
@@ -130,3 +130,55 @@ test(content, scale=3, x=12, y=16, x1=8, y1=12, x2=16, y2=16)
 
 print("color key")
 test(content, scale=0, skip_source_index=0x4529, fill=0)
+
+print("window into a small bitmap")
+
+
+def test_window(jpeg_input, scale, width, height, x=0, y=0, **crop):
+    w, h = decoder.open(content)
+    w >>= scale
+    h >>= scale
+    full = Bitmap(w, h, 65535)
+    decoder.decode(full, scale=scale)
+
+    crop.setdefault("x1", 0)
+    crop.setdefault("y1", 0)
+    refb = Bitmap(width, height, 65535)
+    refb.fill(0x1234)
+    bitmaptools.blit(refb, full, x, y, **crop)
+
+    b = Bitmap(width, height, 65535)
+    b.fill(0x1234)
+    decoder.open(jpeg_input)
+    decoder.decode(b, scale=scale, x=x, y=y, **crop)
+    print(f"{scale} {width}x{height} {memoryview(refb) == memoryview(b)=}")
+
+
+test_window(content, 0, 40, 30, x1=150, y1=100)
+test_window(content, 0, 40, 30, x1=150, y1=100, x2=170, y2=110)
+test_window(content, 0, 40, 30, x=5, y=7, x1=200, y1=210)
+test_window(content, 1, 24, 24, x1=60, y1=40)
+test_window(content, 2, 16, 8, x=3, x1=20, y1=50)
+test_window(content, 3, 8, 8, x1=20, y1=21)
+
+
+class ChunkedIO(io.IOBase):
+    # Returns at most a few bytes per read, like a slow socket
+    def __init__(self, content, chunk):
+        self._content = memoryview(content).cast("b")
+        self._pos = 0
+        self._chunk = chunk
+
+    def readinto(self, buf):
+        pos = self._pos
+        data = self._content[pos : pos + min(len(buf), self._chunk)]
+        len_data = len(data)
+        buf[:len_data] = data
+        self._pos = pos + len_data
+        return len_data
+
+
+print("chunked stream")
+for chunk in (7, 500, 5000):
+    test_window(ChunkedIO(content, chunk), 0, 240, 240)
+    test_window(ChunkedIO(content, chunk), 1, 50, 60, x1=30, y1=40)
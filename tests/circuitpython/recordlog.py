@@ -0,0 +1,132 @@
+# Test recordlog.RecordLog on a file and on a block device.
+try:
+    import io
+    import recordlog
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+# A block device backed by a bytearray, which counts the writes made.
+class RAMBlockDevice:
+    def __init__(self, block_size, blocks):
+        self.block_size = block_size
+        self.data = bytearray(b"\xff" * block_size * blocks)
+        self.blocks = blocks
+        self.writes = 0
+
+    def readblocks(self, n, buf):
+        start = n * self.block_size
+        buf[:] = self.data[start : start + len(buf)]
+
+    def writeblocks(self, n, buf):
+        self.writes += 1
+        start = n * self.block_size
+        self.data[start : start + len(buf)] = buf
+
+    def ioctl(self, op, arg):
+        if op == 4:  # MP_BLOCKDEV_IOCTL_BLOCK_COUNT
+            return self.blocks
+        if op == 5:  # MP_BLOCKDEV_IOCTL_BLOCK_SIZE
+            return self.block_size
+
+
+# File: records are only written on commit, and survive reopening.
+f = io.BytesIO()
+log = recordlog.RecordLog(f, buffer_size=64)
+print(log.max_record_length)
+log.append(b"one")
+log.append(bytearray(b"two"))
+print(len(f.getvalue()))
+log.commit()
+print(len(f.getvalue()))
+log.append(b"three")
+print(list(log))
+print(list(reversed(log)))
+
+# A full buffer is written without a commit.
+for i in range(20):
+    log.append(b"record %d" % i)
+print(len(f.getvalue()) > 0, len(list(log)))
+log.deinit()
+data = f.getvalue()
+
+log = recordlog.RecordLog(io.BytesIO(data), buffer_size=64)
+records = list(log)
+print(len(records), records[:3], records[-1])
+print(list(reversed(log))[:2])
+
+# A commit cut short loses only its own records.
+f = io.BytesIO(data[:-5])
+log = recordlog.RecordLog(f, buffer_size=64)
+print(list(reversed(log))[:2])
+log.append(b"after")
+log.commit()
+print(list(reversed(log))[:2])
+log = recordlog.RecordLog(io.BytesIO(f.getvalue()), buffer_size=64)
+print(list(reversed(log))[:2])
+
+# A corrupted record ends the log.
+corrupt = bytearray(data)
+corrupt[20] ^= 1
+log = recordlog.RecordLog(io.BytesIO(corrupt), buffer_size=64)
+print(list(log))
+
+try:
+    log.append(bytes(log.max_record_length + 1))
+except ValueError:
+    print("ValueError")
+
+# Block device: blocks are used in turn and the oldest are reused.
+bdev = RAMBlockDevice(64, 4)
+log = recordlog.RecordLog(bdev)
+print(log.max_record_length)
+print(list(log))
+for i in range(10):
+    log.append(b"r%d" % i)
+log.commit()
+print(bdev.writes)
+print(list(log))
+for i in range(10, 40):
+    log.append(b"r%d" % i)
+print(list(reversed(log)))
+log.deinit()
+
+log = recordlog.RecordLog(bdev)
+print(list(log))
+log.append(b"new")
+print(list(reversed(log))[:3])
+
+# A block write cut short.
+bdev.data[bdev.data.find(b"new") + 2] ^= 1
+log = recordlog.RecordLog(bdev)
+print(list(reversed(log))[:2])
+
+with recordlog.RecordLog(io.BytesIO()) as log:
+    log.append(b"x")
+try:
+    log.append(b"y")
+except ValueError:
+    print("ValueError")
+
+# Records appended with a larger buffer are read with a smaller one.
+f = io.BytesIO()
+log = recordlog.RecordLog(f, buffer_size=512)
+for i in range(3):
+    log.append(bytes([i]) * 200)
+log.append(b"short")
+log.deinit()
+data = f.getvalue()
+log = recordlog.RecordLog(io.BytesIO(data), buffer_size=64)
+print([(len(r), r[0]) for r in log])
+print([len(r) for r in reversed(log)])
+log.append(b"small")
+print(len(list(log)))
+
+# A long record cut short is dropped, and a corrupted one ends the log.
+log = recordlog.RecordLog(io.BytesIO(data[:-20]), buffer_size=64)
+print([len(r) for r in log])
+corrupt = bytearray(data)
+corrupt[300] ^= 1
+log = recordlog.RecordLog(io.BytesIO(corrupt), buffer_size=64)
+print([len(r) for r in log])
@@ -0,0 +1,103 @@
+# Test the block cache and readahead between VfsFat and its block device.
+try:
+    import io, os
+
+    os.VfsFat
+    io.BytesIO
+except (ImportError, AttributeError):
+    print("SKIP")
+    raise SystemExit
+
+
+# A block device backed by a file, which records the reads made.
+class FileDevice:
+    SEC_SIZE = 512
+
+    def __init__(self, f, blocks):
+        self.f = f
+        self.blocks = blocks
+        self.reads = []
+
+    def readblocks(self, n, buf):
+        self.reads.append((n, len(buf) // self.SEC_SIZE))
+        self.f.seek(n * self.SEC_SIZE)
+        self.f.readinto(buf)
+
+    def writeblocks(self, n, buf):
+        self.f.seek(n * self.SEC_SIZE)
+        self.f.write(buf)
+
+    def ioctl(self, op, arg):
+        if op == 4:  # MP_BLOCKDEV_IOCTL_BLOCK_COUNT
+            return self.blocks
+        if op == 5:  # MP_BLOCKDEV_IOCTL_BLOCK_SIZE
+            return self.SEC_SIZE
+
+
+try:
+    bdev = FileDevice(io.BytesIO(bytearray(100 * 512)), 100)
+    os.VfsFat.mkfs(bdev)
+except MemoryError:
+    print("SKIP")
+    raise SystemExit
+
+fs = os.VfsFat(bdev)
+os.mount(fs, "/ramdisk")
+
+data = bytes(i * 7 & 0xFF for i in range(16 * 512))
+with open("/ramdisk/data", "wb") as f:
+    f.write(data)
+for i in range(8):
+    with open("/ramdisk/f%d" % i, "w") as f:
+        f.write(str(i))
+
+# Remount so that nothing is cached.
+os.umount("/ramdisk")
+fs = os.VfsFat(bdev)
+os.mount(fs, "/ramdisk")
+
+# Small reads make FatFs read one block at a time, which should be read ahead.
+bdev.reads = []
+read = b""
+with open("/ramdisk/data", "rb") as f:
+    while True:
+        chunk = f.read(100)
+        if not chunk:
+            break
+        read += chunk
+print(read == data)
+print(max(count for _, count in bdev.reads) > 1)
+print(sum(count for _, count in bdev.reads) >= 16, len(bdev.reads) < 16)
+
+# Scanning the directory again is served from the cache.
+print(sorted(os.listdir("/ramdisk")))
+bdev.reads = []
+print(sorted(os.listdir("/ramdisk")))
+print(bdev.reads)
+for i in range(8):
+    with open("/ramdisk/f%d" % i) as f:
+        print(f.read(), end="")
+print()
+
+# Cached blocks follow writes.
+with open("/ramdisk/data", "r+b") as f:
+    f.seek(600)
+    f.write(b"hello")
+with open("/ramdisk/data", "rb") as f:
+    f.seek(598)
+    print(f.read(10))
+with open("/ramdisk/f3", "w") as f:
+    f.write("three")
+with open("/ramdisk/f3") as f:
+    print(f.read())
+
+# And survive a remount.
+os.umount("/ramdisk")
+fs = os.VfsFat(bdev)
+os.mount(fs, "/ramdisk")
+with open("/ramdisk/data", "rb") as f:
+    f.seek(598)
+    print(f.read(10))
+with open("/ramdisk/f3") as f:
+    print(f.read())
+os.umount("/ramdisk")
@@ -0,0 +1,126 @@
+# test functions being switched to native code after enough calls
+
+import micropython
+
+try:
+    micropython.jit_threshold
+except AttributeError:
+    print("SKIP")
+    raise SystemExit
+
+micropython.jit_threshold(2)
+print(micropython.jit_threshold())
+
+
+@micropython.native
+def native_ref():
+    pass
+
+
+NATIVE = type(native_ref)
+
+
+# the call that passes the threshold compiles the function, once
+def hot(x):
+    return x + 1
+
+
+BYTECODE = type(hot)
+count = micropython.jit_count()
+for i in range(4):
+    hot(i)
+    print(i, micropython.jit_count() - count, type(hot) is NATIVE, type(hot) is BYTECODE)
+
+
+def add(a, b):
+    return a + b
+
+
+def loop(n):
+    s = 0
+    for i in range(n):
+        s += i * 2
+    return s
+
+
+def wh(n):
+    i = 0
+    acc = []
+    while i < n:
+        acc.append(i)
+        i += 1
+    return acc
+
+
+g = 10
+
+
+def useg(x):
+    global g
+    g += x
+    return g
+
+
+def kw(a, *args, b=3, **kw):
+    return a, args, b, sorted(kw.items())
+
+
+def comp(n):
+    return [x * x for x in range(n) if x % 2], {x: x for x in range(3)}, {x for x in range(3)}
+
+
+def unbound(x):
+    if x:
+        y = 1
+    return y
+
+
+def recurse(n):
+    return n if n < 2 else recurse(n - 1) + recurse(n - 2)
+
+
+class A:
+    def __init__(self):
+        self.v = 1
+
+    def m(self, k):
+        self.v += k
+        return self.v
+
+
+# results must not change as the functions switch over
+for r in range(4):
+    print(add(r, 1), loop(10), wh(3), useg(1), kw(1, 2, c=4), comp(5), recurse(10))
+    try:
+        print(unbound(r % 2))
+    except NameError:
+        print("NameError")
+    a = A()
+    print(a.m(2), a.m(3))
+
+# the functions above switched over, except one whose local may be unbound
+print(type(add) is NATIVE, type(recurse) is NATIVE, type(A.m) is NATIVE)
+print(type(unbound) is BYTECODE)
+
+# exceptions propagate out of native code
+for r in range(3):
+    try:
+        add(r, None)
+    except TypeError:
+        print("TypeError")
+
+# argument errors are still raised
+try:
+    add(1)
+except TypeError:
+    print("TypeError")
+
+# invalid thresholds
+for n in (-1, 0xFFFF):
+    try:
+        micropython.jit_threshold(n)
+    except ValueError:
+        print("ValueError")
+
+micropython.jit_threshold(0)
+print(micropython.jit_threshold())
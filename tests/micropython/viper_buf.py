@@ -0,0 +1,93 @@
+# test bounds-checked buf8/buf16/buf32 arguments
+# only works on little endian machines
+
+try:
+    from array import array
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+@micropython.viper
+def get(b: buf16, i: int) -> int:
+    return b[i]
+
+
+@micropython.viper
+def put(b: buf16, i: int, v: int):
+    b[i] = v
+
+
+@micropython.viper
+def get8(b: buf8, i: int) -> int:
+    return b[i]
+
+
+@micropython.viper
+def put32(b: buf32, i: int, v: uint):
+    b[i] = v
+
+
+@micropython.viper
+def total(b: buf16) -> int:
+    s = 0
+    for i in range(int(len(b))):
+        s += b[i]
+    return s
+
+
+@micropython.viper
+def same(b: buf8, o):
+    # a buf converts back to the object it came from
+    return id(b) == id(o)
+
+
+@micropython.viper
+def as_ptr(b: buf16) -> int:
+    p = ptr16(b)
+    return p[1]
+
+
+def test(f, *args):
+    try:
+        print(f(*args))
+    except IndexError as e:
+        print("IndexError")
+
+
+a = array("h", [1, 2, 3, 4])
+test(get, a, 0)
+test(get, a, 3)
+test(get, a, 4)
+test(get, a, -1)
+test(put, a, 2, 30)
+test(put, a, 4, 40)
+test(put, a, -1, 40)
+print(a)
+print(total(a))
+test(as_ptr, a)
+
+# a memoryview limits the buf to its own slice
+m = memoryview(a)[1:3]
+test(get, m, 1)
+test(get, m, 2)
+
+# a bytearray of 5 bytes only holds 2 whole 16-bit items
+b = bytearray(b"\x01\x00\x02\x00\x03")
+test(get, b, 1)
+test(get, b, 2)
+test(get8, b, 4)
+test(get8, b, 5)
+
+w = bytearray(8)
+test(put32, w, 1, 0x12345678)
+test(put32, w, 2, 0)
+print(w)
+
+print(same(b, b))
+
+# a buf needs an object that supports the buffer protocol
+try:
+    get(1, 0)
+except TypeError:
+    print("TypeError")
@@ -0,0 +1,21 @@
+# test type errors for viper buf arguments and pointer reductions
+
+
+def test(code):
+    try:
+        exec(code)
+    except (SyntaxError, ViperTypeError, NotImplementedError) as e:
+        print(repr(e))
+
+
+# a buf can only be an argument
+test("@micropython.viper\ndef f() -> buf8: pass")
+test("@micropython.viper\ndef f(x):\n buf8(x)")
+
+# wrong number of arguments
+test("@micropython.viper\ndef f(p:ptr8):\n ptr_sum(p)")
+test("@micropython.viper\ndef f(p:ptr8):\n ptr_clamp(p, 1, 2)")
+
+# unsupported pointer and length types
+test("@micropython.viper\ndef f(p:ptr):\n ptr_sum(p, 1)")
+test("@micropython.viper\ndef f(p:ptr8, n):\n ptr_max(p, n)")
@@ -0,0 +1,107 @@
+# test the ptr_sum, ptr_min, ptr_max and ptr_clamp viper builtins
+# only works on little endian machines
+
+try:
+    from array import array
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+@micropython.viper
+def sum8(p: ptr8, n: int) -> uint:
+    return ptr_sum(p, n)
+
+
+@micropython.viper
+def sum16(p: ptr16, n: int) -> uint:
+    return ptr_sum(p, n)
+
+
+@micropython.viper
+def sum32(p: ptr32, n: int) -> uint:
+    return ptr_sum(p, n)
+
+
+@micropython.viper
+def min16(p: ptr16, n: int) -> uint:
+    return ptr_min(p, n)
+
+
+@micropython.viper
+def max8(p: ptr8, n: int) -> uint:
+    return ptr_max(p, n)
+
+
+@micropython.viper
+def max32(p: ptr32, n: int) -> uint:
+    return ptr_max(p, n)
+
+
+@micropython.viper
+def min32(p: ptr32, n: int) -> uint:
+    return ptr_min(p, n)
+
+
+@micropython.viper
+def clamp16(p: ptr16, n: int, lo: int, hi: int) -> uint:
+    return ptr_clamp(p, n, lo, hi)
+
+
+@micropython.viper
+def bsum16(b: buf16, n: int) -> uint:
+    return ptr_sum(b, n)
+
+
+@micropython.viper
+def bclamp8(b: buf8, n: int, lo: int, hi: int) -> uint:
+    return ptr_clamp(b, n, lo, hi)
+
+
+# lengths around the wide paths, with an unaligned start for the byte case
+for n in (0, 1, 3, 7, 8, 9, 16, 17, 33, 100):
+    b = bytearray((i * 37 + 11) & 0xFF for i in range(n + 1))
+    h = array("H", ((i * 4099 + 7) & 0xFFFF for i in range(n)))
+    w = array("I", ((i * 2654435761) & 0xFFFFFFFF for i in range(n)))
+    ok = sum8(memoryview(b)[1:], n) == sum(b[1:])
+    ok = ok and sum16(h, n) == sum(h)
+    # sums wrap at the machine word, so keep this one within 32 bits
+    ws = array("I", (x >> 8 for x in w))
+    ok = ok and sum32(ws, n) == sum(ws)
+    if n:
+        ok = ok and min16(h, n) == min(h) and max8(b, n) == max(b[:n])
+        ok = ok and max32(w, n) == max(w) and min32(w, n) == min(w)
+    print(n, ok)
+
+# elements are unsigned
+s = array("h", [-1, 2, -3])
+print(sum16(s, 3), min16(s, 3))
+
+# clamp returns the number of changed elements
+h = array("H", range(0, 2000, 100))
+print(clamp16(h, len(h), 300, 1500))
+print(list(h))
+print(clamp16(h, len(h), 300, 1500))
+
+# a negative length is empty
+print(sum16(h, -1))
+
+# bufs check the length
+a = array("h", [1, 2, 3])
+print(bsum16(a, 3))
+try:
+    bsum16(a, 4)
+except IndexError:
+    print("IndexError")
+b = bytearray(b"\x00\x80\xff")
+print(bclamp8(b, 3, 16, 200), list(b))
+try:
+    bclamp8(b, 4, 0, 1)
+except IndexError:
+    print("IndexError")
+
+# min and max of nothing
+try:
+    min16(h, 0)
+except ValueError:
+    print("ValueError")
@@ -0,0 +1,71 @@
+# test reductions and clamping over ptr16/ptr32 with register indices
+# only works on little endian machines
+
+import array
+
+
+@micropython.viper
+def sum16(p: ptr16, n: int) -> int:
+    s = 0
+    for i in range(n):
+        s += p[i]
+    return s
+
+
+@micropython.viper
+def minmax32(n: int, p: ptr32):
+    lo = p[0]
+    hi = lo
+    i = 1
+    while i < n:
+        x = p[i]
+        if x < lo:
+            lo = x
+        if x > hi:
+            hi = x
+        i += 1
+    return (lo, hi)
+
+
+@micropython.viper
+def clamp16(p: ptr16, n: int, lo: int, hi: int):
+    for i in range(n):
+        x = p[i]
+        if x < lo:
+            p[i] = lo
+        elif x > hi:
+            p[i] = hi
+
+
+@micropython.viper
+def shift32(p: ptr32, n: int):
+    # index computed into a temporary register
+    for i in range(n - 1):
+        p[i] = p[i + 1]
+
+
+@micropython.viper
+def reverse8(p: ptr8, n: int):
+    i = 0
+    j = n - 1
+    while i < j:
+        t = p[i]
+        p[i] = p[j]
+        p[j] = t
+        i += 1
+        j -= 1
+
+
+a = array.array("H", [5, 1000, 3, 65535, 42, 7])
+print(sum16(a, len(a)), sum16(a, 0))
+clamp16(a, len(a), 10, 1000)
+print(list(a))
+
+b = array.array("I", [30, 8, 100, 7, 12])
+print(minmax32(len(b), b))
+shift32(b, len(b))
+print(list(b))
+
+c = bytearray(b"abcdefg")
+reverse8(c, len(c))
+print(c)
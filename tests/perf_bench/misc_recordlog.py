@@ -0,0 +1,76 @@
+# Test performance of appending to and reading back a recordlog.RecordLog kept
+# on a file-backed block device.
+
+import io
+
+try:
+    import recordlog
+except ImportError:
+    print("SKIP")
+    raise SystemExit
+
+
+class FileDevice:
+    def __init__(self, f, block_size, blocks):
+        self.f = f
+        self.block_size = block_size
+        self.blocks = blocks
+        self.writes = 0
+
+    def readblocks(self, n, buf):
+        self.f.seek(n * self.block_size)
+        self.f.readinto(buf)
+
+    def writeblocks(self, n, buf):
+        self.writes += 1
+        self.f.seek(n * self.block_size)
+        self.f.write(buf)
+
+    def ioctl(self, op, arg):
+        if op == 4:  # MP_BLOCKDEV_IOCTL_BLOCK_COUNT
+            return self.blocks
+        if op == 5:  # MP_BLOCKDEV_IOCTL_BLOCK_SIZE
+            return self.block_size
+
+
+def test(nrecords, batch):
+    bdev = FileDevice(io.BytesIO(b"\xff" * 4096 * 16), 4096, 16)
+    log = recordlog.RecordLog(bdev)
+    record = bytearray(24)
+    for i in range(nrecords):
+        record[0] = i & 0xFF
+        log.append(record)
+        if i % batch == batch - 1:
+            log.commit()
+    count = 0
+    newest = None
+    for r in reversed(log):
+        if newest is None:
+            newest = r[0]
+        count += 1
+    return newest == (nrecords - 1) & 0xFF and count >= min(nrecords, 15 * 127)
+
+
+###########################################################################
+# Benchmark interface
+
+bm_params = {
+    (50, 25): (200, 10),
+    (100, 100): (1000, 10),
+    (1000, 1000): (5000, 20),
+    (5000, 1000): (20000, 50),
+}
+
+
+def bm_setup(params):
+    nrecords, batch = params
+    result = None
+
+    def run():
+        nonlocal result
+        result = test(nrecords, batch)
+
+    def result_fn():
+        return nrecords, result
+
+    return run, result_fn
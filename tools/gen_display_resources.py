@@ -101,6 +101,45 @@ for c in filtered_characters:
 
 c_file = args.output_c_file
 
+
+def write_palette(palette_name, prefix, colors):
+    """Write a static Palette and its color tables.
+
+    colors is a list of (rgb888, transparent, comment) tuples. The transparent
+    count is computed from them so that it always matches the colors.
+    """
+    c_file.write("_displayio_color_t {}_colors[{}] = {{\n".format(prefix, len(colors)))
+    for rgb888, transparent, comment in colors:
+        c_file.write("    {{{}\n".format(" // " + comment if comment else ""))
+        if transparent:
+            c_file.write("        .rgb888 = 0x{:06x},\n        .transparent = true\n".format(rgb888))
+        else:
+            c_file.write("        .rgb888 = 0x{:06x}\n".format(rgb888))
+        c_file.write("    },\n")
+    c_file.write(
+        """\
+}};
+
+uint32_t {1}_native_colors[{2}];
+
+displayio_palette_t {0} = {{
+    .base = {{.type = &displayio_palette_type }},
+    .colors = {1}_colors,
+    .native_colors = {1}_native_colors,
+    .color_count = {2},
+    .transparent_count = {3},
+    .needs_refresh = false
+}};
+
+""".format(
+            palette_name,
+            prefix,
+            len(colors),
+            sum(1 for color in colors if color[1]),
+        )
+    )
+
+
 c_file.write(
     """\
 
@@ -176,39 +215,25 @@ const displayio_bitmap_t blinka_bitmap = {{
     .bitmask = 0x0f,
     .read_only = true
 }};
+""".format(blinka_size)
+)
 
-_displayio_color_t blinka_colors[7] = {{
-    {{
-        .rgb888 = 0x000000,
-        .transparent = true
-    }},
-    {{ // Purple
-        .rgb888 = 0x8428bc
-    }},
-    {{ // Pink
-        .rgb888 = 0xff89bc
-    }},
-    {{ // Light blue
-        .rgb888 = 0x7beffe
-    }},
-    {{ // Dark purple
-        .rgb888 = 0x51395f
-    }},
-    {{ // White
-        .rgb888 = 0xffffff
-    }},
-    {{ // Dark Blue
-        .rgb888 = 0x0736a0
-    }},
-}};
-
-displayio_palette_t blinka_palette = {{
-    .base = {{.type = &displayio_palette_type }},
-    .colors = blinka_colors,
-    .color_count = 7,
-    .needs_refresh = false
-}};
+write_palette(
+    "blinka_palette",
+    "blinka",
+    [
+        (0x000000, True, None),
+        (0x8428BC, False, "Purple"),
+        (0xFF89BC, False, "Pink"),
+        (0x7BEFFE, False, "Light blue"),
+        (0x51395F, False, "Dark purple"),
+        (0xFFFFFF, False, "White"),
+        (0x0736A0, False, "Dark Blue"),
+    ],
+)
 
+c_file.write(
+    """\
 displayio_tilegrid_t supervisor_blinka_sprite = {{
     .base = {{.type = &displayio_tilegrid_type }},
     .bitmap = (displayio_bitmap_t*) &blinka_bitmap,
@@ -237,25 +262,11 @@ displayio_tilegrid_t supervisor_blinka_sprite = {{
 """.format(blinka_size)
 )
 
-c_file.write(
-    """\
-#if CIRCUITPY_TERMINALIO
-_displayio_color_t terminal_colors[2] = {
-    {
-        .rgb888 = 0x000000
-    },
-    {
-        .rgb888 = 0xffffff
-    },
-};
-
-displayio_palette_t supervisor_terminal_color = {
-    .base = {.type = &displayio_palette_type },
-    .colors = terminal_colors,
-    .color_count = 2,
-    .needs_refresh = false
-};
-"""
+c_file.write("#if CIRCUITPY_TERMINALIO\n")
+write_palette(
+    "supervisor_terminal_color",
+    "terminal",
+    [(0x000000, False, None), (0xFFFFFF, False, None)],
 )
 
 c_file.write(
@@ -4,6 +4,7 @@
 
 import argparse
 import gzip
+import hashlib
 import minify_html
 import jsmin
 import mimetypes
@@ -32,8 +33,10 @@ for f in args.files:
         uncompressed = jsmin.jsmin(uncompressed.decode("utf-8"), quote_chars="'\"`").encode(
             "utf-8"
         )
-    compressed = gzip.compress(uncompressed)
+    # mtime=0 keeps the output, and so the ETag, the same from build to build.
+    compressed = gzip.compress(uncompressed, mtime=0)
     clen = len(compressed)
+    etag = hashlib.sha1(compressed).hexdigest()[:16]
     compressed = ", ".join([hex(x) for x in compressed])
     mime = mimetypes.guess_type(f.name)[0]
 
@@ -41,4 +44,5 @@ for f in args.files:
     c_file.write(f"// Original length: {ulen} Compressed length: {clen}\n")
     c_file.write(f"const uint32_t {variable}_length = {clen};\n")
     c_file.write(f'const char* {variable}_content_type = "{mime}";\n')
+    c_file.write(f'const char* {variable}_etag = "\\"{etag}\\"";\n')
     c_file.write(f"const uint8_t {variable}[{clen}] = {{{compressed}}};\n\n")
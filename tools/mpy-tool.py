@@ -87,7 +87,8 @@ class FreezeError(Exception):
 
 
 class Config:
-    MPY_VERSION = 6
+    MPY_VERSION = 7
+    MPY_VERSION_MIN = 6
     MPY_SUB_VERSION = 3
     MICROPY_LONGINT_IMPL_NONE = 0
     MICROPY_LONGINT_IMPL_LONGLONG = 1
@@ -189,12 +190,12 @@ mp_binary_op_method_name = (
 
 class Opcode:
     # fmt: off
-    # Load, Store, Delete, Import, Make, Build, Unpack, Call, Jump, Exception, For, sTack, Return, Yield, Op
+    # Load, Store, Delete, Import, Make, Build, Unpack, Call, Jump, Exception, For, sTack, Return, Yield, Op, Peephole
     MP_BC_BASE_RESERVED               = (0x00) # ----------------
-    MP_BC_BASE_QSTR_O                 = (0x10) # LLLLLLSSSDDII---
+    MP_BC_BASE_QSTR_O                 = (0x10) # LLLLLLSSSDDIIPPP
     MP_BC_BASE_VINT_E                 = (0x20) # MMLLLLSSDDBBBBBB
-    MP_BC_BASE_VINT_O                 = (0x30) # UUMMCCCC--------
-    MP_BC_BASE_JUMP_E                 = (0x40) # J-JJJJJEEEEF----
+    MP_BC_BASE_VINT_O                 = (0x30) # UUMMCCCCPP------
+    MP_BC_BASE_JUMP_E                 = (0x40) # JPJJJJJEEEEF----
     MP_BC_BASE_BYTE_O                 = (0x50) # LLLLSSDTTTTTEEFF
     MP_BC_BASE_BYTE_E                 = (0x60) # --BREEEYYI------
     MP_BC_LOAD_CONST_SMALL_INT_MULTI  = (0x70) # LLLLLLLLLLLLLLLL
@@ -296,11 +297,19 @@ class Opcode:
     MP_BC_IMPORT_NAME                 = (MP_BC_BASE_QSTR_O + 0x0b) # qstr
     MP_BC_IMPORT_FROM                 = (MP_BC_BASE_QSTR_O + 0x0c) # qstr
     MP_BC_IMPORT_STAR                 = (MP_BC_BASE_BYTE_E + 0x09)
+
+    MP_BC_LOAD_FAST0_ATTR             = (MP_BC_BASE_QSTR_O + 0x0d) # qstr
+    MP_BC_LOAD_FAST0_METHOD           = (MP_BC_BASE_QSTR_O + 0x0e) # qstr
+    MP_BC_STORE_FAST0_ATTR            = (MP_BC_BASE_QSTR_O + 0x0f) # qstr
+    MP_BC_BINARY_OP_SMALL_INT         = (MP_BC_BASE_VINT_O + 0x08) # uint
+    MP_BC_LOAD_FAST_BINARY_OP_SMALL_INT = (MP_BC_BASE_VINT_O + 0x09) # uint
+    MP_BC_BINARY_OP_POP_JUMP_IF       = (MP_BC_BASE_JUMP_E + 0x01) # signed relative bytecode offset; then a byte
     # fmt: on
 
     # Create sets of related opcodes.
     ALL_OFFSET_SIGNED = (
         MP_BC_UNWIND_JUMP,
+        MP_BC_BINARY_OP_POP_JUMP_IF,
         MP_BC_JUMP,
         MP_BC_POP_JUMP_IF_TRUE,
         MP_BC_POP_JUMP_IF_FALSE,
@@ -1355,7 +1364,7 @@ def read_mpy(filename):
         # CIRCUITPY-CHANGE: "C" is used for CircuitPython
         if header[0] != ord("C"):
             raise MPYReadError(filename, "not a valid .mpy file")
-        if header[1] != config.MPY_VERSION:
+        if not config.MPY_VERSION_MIN <= header[1] <= config.MPY_VERSION:
             raise MPYReadError(filename, "incompatible .mpy version")
         feature_byte = header[2]
         mpy_native_arch = feature_byte >> 2
@@ -1619,7 +1628,8 @@ def adjust_bytecode_qstr_obj_indices(bytecode_in, qstr_table_base, obj_table_bas
         opcodes.append(opcode)
         ip += sz
         if fmt == MP_BC_FORMAT_OFFSET:
-            opcode.arg += ip
+            # The offset is relative to the end of the offset bytes, before any extra byte.
+            opcode.arg += ip - (1 if extra_arg is not None else 0)
 
     # Link jump opcodes to their destination.
     for opcode in opcodes: